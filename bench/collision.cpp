@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "collision.hpp"
+
+// Times hw::collision_world::find_pairs on 5000 moving rectangles, circles,
+// triangles and points, and checks that the sweep finds the same pairs as
+// testing every pair.
+namespace {
+    struct body
+    {
+        hw::vec2f pos;
+        hw::vec2f velocity;
+        std::uint32_t id;
+    };
+
+    float const g_width{1920.0f};
+    float const g_height{1080.0f};
+    float const g_step{1.0f / 60.0f};
+
+    hw::collider collider_of(std::size_t const t_index,
+                             hw::vec2f const& t_pos)
+    {
+        float const size = 4.0f + static_cast<float>(t_index % 13);
+
+        switch(t_index % 4) {
+        case 0:
+            return hw::rect_collider(t_pos, hw::vec2f{size, size * 0.5f});
+        case 1:
+            return hw::circle_collider(t_pos, size * 0.5f);
+        case 2:
+            return hw::triangle_collider(t_pos, t_pos + hw::vec2f{size, 0.0f},
+                                         t_pos + hw::vec2f{0.0f, size});
+        default:
+            return hw::point_collider(t_pos);
+        }
+    }
+
+    void step(hw::collision_world& t_world, std::vector<body>& t_bodies)
+    {
+        for(std::size_t i = 0; i < t_bodies.size(); ++i) {
+            body& b = t_bodies[i];
+            b.pos += b.velocity * g_step;
+
+            if(b.pos.x < 0.0f || b.pos.x > g_width) {
+                b.velocity.x = -b.velocity.x;
+            }
+            if(b.pos.y < 0.0f || b.pos.y > g_height) {
+                b.velocity.y = -b.velocity.y;
+            }
+
+            t_world.move(b.id, collider_of(i, b.pos));
+        }
+    }
+
+    std::vector<std::uint64_t> sorted(
+        std::vector<hw::collision_pair> const& t_pairs)
+    {
+        std::vector<std::uint64_t> result{};
+
+        for(auto const& p : t_pairs) {
+            result.push_back((static_cast<std::uint64_t>(p.first) << 32) |
+                             p.second);
+        }
+
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+} // namespace
+
+int main()
+{
+    std::size_t const count = 5000;
+    hw::collision_world world{};
+    std::vector<body> bodies{};
+
+    for(std::size_t i = 0; i < count; ++i) {
+        float const angle = static_cast<float>(i) * 0.618f;
+        float const speed = 20.0f + static_cast<float>(i % 100);
+        hw::vec2f const pos{
+            static_cast<float>((i * 7919) % 1920),
+            static_cast<float>((i * 104729) % 1080)};
+
+        bodies.push_back(body{pos,
+                              hw::vec2f{std::cos(angle) * speed,
+                                        std::sin(angle) * speed},
+                              world.add(collider_of(i, pos))});
+    }
+
+    // a few frames apart, removing and adding some on the way
+    bool same{true};
+
+    for(int frame = 0; frame < 5; ++frame) {
+        for(int i = 0; i < 10; ++i) {
+            step(world, bodies);
+        }
+
+        world.remove(bodies.back().id);
+        bodies.back().id = world.add(collider_of(count - 1, bodies[0].pos));
+
+        std::vector<std::uint64_t> const swept = sorted(world.find_pairs());
+        same = same && swept == sorted(world.find_pairs_brute_force());
+    }
+
+    std::size_t const frames = 600;
+    std::size_t pairs{0};
+    auto const start = std::chrono::steady_clock::now();
+
+    for(std::size_t frame = 0; frame < frames; ++frame) {
+        step(world, bodies);
+        pairs += world.find_pairs().size();
+    }
+
+    std::chrono::duration<double, std::milli> const elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    auto const brute_start = std::chrono::steady_clock::now();
+    world.find_pairs_brute_force();
+    std::chrono::duration<double, std::milli> const brute =
+        std::chrono::steady_clock::now() - brute_start;
+
+    std::cout << count << " colliders: "
+              << elapsed.count() / static_cast<double>(frames)
+              << " ms per frame moving and finding pairs(about "
+              << pairs / frames << " pairs), testing every pair "
+              << brute.count() << " ms\n";
+
+    if(!same) {
+        std::cout << "the sweep found different pairs than testing every "
+                     "pair\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "blend.hpp"
+
+// Times hw::blend_over and hw::premultiply against plain per channel loops
+// and checks that both give the same colors.
+namespace {
+    template<typename F>
+    double time_ns_per_color(std::size_t const t_colors, F const& t_fn)
+    {
+        std::size_t const repeats =
+            std::max<std::size_t>(1, 20000000 / t_colors);
+        auto const start = std::chrono::steady_clock::now();
+
+        for(std::size_t i = 0; i < repeats; ++i) {
+            t_fn();
+        }
+
+        std::chrono::duration<double, std::nano> const elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / static_cast<double>(repeats * t_colors);
+    }
+
+    std::uint8_t scale(unsigned const t_lhs, unsigned const t_rhs)
+    {
+        return static_cast<std::uint8_t>((t_lhs * t_rhs + 127) / 255);
+    }
+
+    void plain_blend_over(hw::color const* t_src, hw::color* t_dst,
+                          std::size_t const t_count)
+    {
+        for(std::size_t i = 0; i < t_count; ++i) {
+            hw::color const& s = t_src[i];
+            hw::color& d = t_dst[i];
+            unsigned const inverse = 255u - s.a;
+            auto const mix = [&](unsigned t_s, unsigned t_d, unsigned t_a) {
+                return static_cast<std::uint8_t>(
+                    (t_s * t_a + t_d * inverse + 127) / 255);
+            };
+
+            d = hw::color{mix(s.r, d.r, s.a), mix(s.g, d.g, s.a),
+                          mix(s.b, d.b, s.a), mix(s.a, d.a, 255u)};
+        }
+    }
+
+    void plain_premultiply(hw::color* t_colors, std::size_t const t_count)
+    {
+        for(std::size_t i = 0; i < t_count; ++i) {
+            hw::color& c = t_colors[i];
+            c = hw::color{scale(c.r, c.a), scale(c.g, c.a), scale(c.b, c.a),
+                          c.a};
+        }
+    }
+} // namespace
+
+int main()
+{
+    bool same = true;
+
+    for(std::size_t const count : {15u, 1000u, 100000u}) {
+        std::vector<hw::color> src(count);
+        std::vector<hw::color> dst(count);
+
+        for(std::size_t i = 0; i < count; ++i) {
+            src[i] = hw::color{static_cast<std::uint8_t>(i * 7),
+                               static_cast<std::uint8_t>(i * 13),
+                               static_cast<std::uint8_t>(i * 29),
+                               static_cast<std::uint8_t>(i * 37)};
+            dst[i] = hw::color{static_cast<std::uint8_t>(i * 3),
+                               static_cast<std::uint8_t>(i * 5),
+                               static_cast<std::uint8_t>(i * 11),
+                               static_cast<std::uint8_t>(i * 17)};
+        }
+
+        std::vector<hw::color> simd = dst;
+        std::vector<hw::color> plain = dst;
+
+        // blending again and again only changes what is timed, the checked
+        // colors come from the first call
+        hw::blend_over(src.data(), simd.data(), count);
+        plain_blend_over(src.data(), plain.data(), count);
+        same = same && simd == plain;
+
+        double const plain_blend_ns = time_ns_per_color(count, [&] {
+            plain_blend_over(src.data(), plain.data(), count);
+        });
+        double const simd_blend_ns = time_ns_per_color(count, [&] {
+            hw::blend_over(src.data(), simd.data(), count);
+        });
+
+        simd = src;
+        plain = src;
+        hw::premultiply(simd.data(), count);
+        plain_premultiply(plain.data(), count);
+        same = same && simd == plain;
+
+        double const plain_premultiply_ns = time_ns_per_color(
+            count, [&] { plain_premultiply(plain.data(), count); });
+        double const simd_premultiply_ns = time_ns_per_color(
+            count, [&] { hw::premultiply(simd.data(), count); });
+
+        std::cout << count << " colors: blend_over " << plain_blend_ns
+                  << " ns/color plain, " << simd_blend_ns << " ns/color("
+                  << plain_blend_ns / simd_blend_ns << "x), premultiply "
+                  << plain_premultiply_ns << " ns/color plain, "
+                  << simd_premultiply_ns << " ns/color("
+                  << plain_premultiply_ns / simd_premultiply_ns << "x)\n";
+    }
+
+    if(!same) {
+        std::cout << "vectorized results differ from the plain ones\n";
+        return 1;
+    }
+
+    return 0;
+}
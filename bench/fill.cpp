@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "fill.hpp"
+
+// Times hw::fill_style::span filling a 1920x1080 canvas with a linear and a
+// radial gradient, the vectorized rows against the scalar ones, and checks
+// that both give the same pixels.
+namespace {
+    int const g_width{1920};
+    int const g_height{1080};
+
+    void fill_rows(hw::fill_style const& t_fill, bool const t_simd,
+                   std::vector<std::uint32_t>& t_pixels)
+    {
+        std::size_t const width = static_cast<std::size_t>(g_width);
+
+        for(int y = 0; y < g_height; ++y) {
+            std::uint32_t* row = &t_pixels[static_cast<std::size_t>(y) * width];
+            float const center = static_cast<float>(y) + 0.5f;
+
+            if(t_simd) {
+                t_fill.span(0.5f, center, row, width);
+            }
+            else {
+                t_fill.span_scalar(0.5f, center, row, width);
+            }
+        }
+    }
+
+    double time_ms_per_fill(hw::fill_style const& t_fill, bool const t_simd,
+                            std::vector<std::uint32_t>& t_pixels)
+    {
+        int const repeats = 20;
+        auto const start = std::chrono::steady_clock::now();
+
+        for(int i = 0; i < repeats; ++i) {
+            fill_rows(t_fill, t_simd, t_pixels);
+        }
+
+        std::chrono::duration<double, std::milli> const elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / repeats;
+    }
+
+    bool bench(char const* t_name, hw::fill_style const& t_fill)
+    {
+        std::size_t const size = static_cast<std::size_t>(g_width) *
+                                 static_cast<std::size_t>(g_height);
+        std::vector<std::uint32_t> simd(size);
+        std::vector<std::uint32_t> plain(size);
+
+        fill_rows(t_fill, true, simd);
+        fill_rows(t_fill, false, plain);
+
+        double const plain_ms = time_ms_per_fill(t_fill, false, plain);
+        double const simd_ms = time_ms_per_fill(t_fill, true, simd);
+
+        std::cout << t_name << ' ' << g_width << 'x' << g_height << ": "
+                  << plain_ms << " ms plain, " << simd_ms << " ms("
+                  << plain_ms / simd_ms << "x)\n";
+
+        if(simd != plain) {
+            std::cout << t_name
+                      << ": vectorized pixels differ from the plain ones\n";
+            return false;
+        }
+
+        return true;
+    }
+} // namespace
+
+int main()
+{
+    // starts and ends inside the canvas, so both ends are clamped
+    hw::fill_style const linear = hw::fill_style::linear(
+        hw::vec2f{100.0f, 50.0f}, hw::color{255, 120, 0},
+        hw::vec2f{1700.0f, 900.0f}, hw::color{20, 40, 160, 128});
+    hw::fill_style const radial =
+        hw::fill_style::radial(hw::vec2f{960.0f, 540.0f}, 500.0f,
+                               hw::color{255, 255, 255}, hw::color{0, 0, 0, 0});
+
+    bool const same = bench("linear", linear) & bench("radial", radial);
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include "image_filter.hpp"
+
+// Times hw::downscale_half on a 2561x1440 image, the vectorized averages
+// against the scalar ones, and checks that both give the same pixels. The odd
+// width leaves a last column for the scalar tail of the vectorized rows.
+namespace {
+    int const g_width{2561};
+    int const g_height{1440};
+
+    ///
+    /// @brief Opaque noise with a transparent color keyed pixel every few,
+    ///        like a decoded sprite.
+    ///
+    SDL_Surface* make_image()
+    {
+        SDL_Surface* image = SDL_CreateRGBSurfaceWithFormat(
+            0, g_width, g_height, 32, SDL_PIXELFORMAT_ARGB8888);
+
+        if(!image) {
+            return nullptr;
+        }
+
+        std::uint32_t seed{12345};
+
+        for(int y = 0; y < g_height; ++y) {
+            auto* row = reinterpret_cast<std::uint32_t*>(
+                static_cast<unsigned char*>(image->pixels) + y * image->pitch);
+
+            for(int x = 0; x < g_width; ++x) {
+                seed = seed * 1664525u + 1013904223u;
+
+                row[x] = (x + y) % 7 == 0
+                             ? 0x00FF00FFu
+                             : (seed >> 8) | (seed & 0xFF000000u);
+            }
+        }
+
+        return image;
+    }
+
+    bool same_pixels(SDL_Surface const* t_lhs, SDL_Surface const* t_rhs)
+    {
+        if(t_lhs->w != t_rhs->w || t_lhs->h != t_rhs->h) {
+            return false;
+        }
+
+        std::size_t const row_size = static_cast<std::size_t>(t_lhs->w) * 4;
+
+        for(int y = 0; y < t_lhs->h; ++y) {
+            if(std::memcmp(
+                   static_cast<unsigned char const*>(t_lhs->pixels) +
+                       y * t_lhs->pitch,
+                   static_cast<unsigned char const*>(t_rhs->pixels) +
+                       y * t_rhs->pitch,
+                   row_size) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename F>
+    double time_ms(F const& t_fn)
+    {
+        int const repeats = 20;
+        auto const start = std::chrono::steady_clock::now();
+
+        for(int i = 0; i < repeats; ++i) {
+            SDL_FreeSurface(t_fn());
+        }
+
+        std::chrono::duration<double, std::milli> const elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / repeats;
+    }
+} // namespace
+
+int main()
+{
+    SDL_Surface* image = make_image();
+
+    if(!image) {
+        std::cout << "could not create the image: " << SDL_GetError() << '\n';
+        return 1;
+    }
+
+    SDL_Surface* simd = hw::downscale_half(image);
+    SDL_Surface* plain = hw::downscale_half_scalar(image);
+    bool const same = simd && plain && same_pixels(simd, plain);
+
+    double const plain_ms =
+        time_ms([image] { return hw::downscale_half_scalar(image); });
+    double const simd_ms =
+        time_ms([image] { return hw::downscale_half(image); });
+
+    std::cout << g_width << 'x' << g_height << " halved: " << plain_ms
+              << " ms plain, " << simd_ms << " ms(" << plain_ms / simd_ms
+              << "x)\n";
+
+    SDL_FreeSurface(plain);
+    SDL_FreeSurface(simd);
+    SDL_FreeSurface(image);
+
+    if(!same) {
+        std::cout << "vectorized pixels differ from the plain ones\n";
+        return 1;
+    }
+
+    return 0;
+}
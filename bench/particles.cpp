@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+#include "particles.hpp"
+
+// Times hw::particles::update on 100k particles, the vectorized integrate
+// against the scalar one, and checks that both leave the same particles.
+namespace {
+    hw::vec2f const g_gravity{0.0f, 300.0f};
+    float const g_step{1.0f / 60.0f};
+
+    hw::particles make_particles(std::size_t const t_count)
+    {
+        hw::particles result{};
+        result.reserve(t_count);
+
+        for(std::size_t i = 0; i < t_count; ++i) {
+            float const angle = static_cast<float>(i) * 0.618f;
+            float const speed = static_cast<float>(i % 200);
+
+            // lifetimes from 0.1 to 2 seconds, so some die every frame
+            result.emit(hw::vec2f{320.0f, 240.0f},
+                        hw::vec2f{std::cos(angle) * speed,
+                                  std::sin(angle) * speed},
+                        hw::color{255, 200, 50},
+                        0.1f + static_cast<float>(i % 20) * 0.1f);
+        }
+
+        return result;
+    }
+
+    bool same_particles(hw::particles const& t_lhs,
+                        hw::particles const& t_rhs)
+    {
+        std::size_t const count = t_lhs.size();
+
+        return count == t_rhs.size() &&
+               std::equal(t_lhs.x(), t_lhs.x() + count, t_rhs.x()) &&
+               std::equal(t_lhs.y(), t_lhs.y() + count, t_rhs.y()) &&
+               std::equal(t_lhs.life(), t_lhs.life() + count, t_rhs.life());
+    }
+
+    template<typename F>
+    double time_ns_per_particle(std::size_t const t_count, F const& t_fn)
+    {
+        std::size_t const repeats = 200;
+        auto const start = std::chrono::steady_clock::now();
+
+        for(std::size_t i = 0; i < repeats; ++i) {
+            t_fn();
+        }
+
+        std::chrono::duration<double, std::nano> const elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / static_cast<double>(repeats * t_count);
+    }
+} // namespace
+
+int main()
+{
+    std::size_t const count = 100000;
+
+    // a second of frames, with particles dying along the way
+    hw::particles simd = make_particles(count);
+    hw::particles plain = make_particles(count);
+
+    for(int frame = 0; frame < 60; ++frame) {
+        simd.update(g_step, g_gravity);
+        plain.integrate_scalar(g_step, g_gravity);
+        plain.kill_dead();
+    }
+
+    bool const same = same_particles(simd, plain);
+
+    // steps of 0 keep every particle alive, so the timed loops always
+    // move all of them
+    hw::particles timed = make_particles(count);
+
+    double const plain_ns = time_ns_per_particle(count, [&] {
+        timed.integrate_scalar(0.0f, g_gravity);
+    });
+    double const simd_ns = time_ns_per_particle(count, [&] {
+        timed.integrate(0.0f, g_gravity);
+    });
+    double const kill_ns =
+        time_ns_per_particle(count, [&] { timed.kill_dead(); });
+
+    std::cout << count << " particles: integrate " << plain_ns
+              << " ns/particle plain, " << simd_ns << " ns/particle("
+              << plain_ns / simd_ns << "x), kill_dead " << kill_ns
+              << " ns/particle, " << (simd_ns + kill_ns) * count / 1e6
+              << " ms per frame\n";
+
+    if(!same) {
+        std::cout << "vectorized results differ from the plain ones\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "affine.hpp"
+
+// Times hw::transform_points against the plain loop for a few batch sizes
+// and checks that both give the same points.
+namespace {
+    template<typename F>
+    double time_ns_per_point(std::size_t const t_points, F const& t_fn)
+    {
+        std::size_t const repeats =
+            std::max<std::size_t>(1, 20000000 / t_points);
+        auto const start = std::chrono::steady_clock::now();
+
+        for(std::size_t i = 0; i < repeats; ++i) {
+            t_fn();
+        }
+
+        std::chrono::duration<double, std::nano> const elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / static_cast<double>(repeats * t_points);
+    }
+} // namespace
+
+int main()
+{
+    hw::affine2 const matrix =
+        hw::affine2::translation(hw::vec2f{320.0f, 240.0f}) *
+        hw::affine2::rotation(30.0f) *
+        hw::affine2::scale(hw::vec2f{2.0f, 0.5f});
+
+    bool same = true;
+
+    for(std::size_t const count : {16u, 1000u, 100000u}) {
+        std::vector<hw::vec2f> in(count);
+        std::vector<hw::vec2f> simd(count);
+        std::vector<hw::vec2f> scalar(count);
+
+        for(std::size_t i = 0; i < count; ++i) {
+            in[i] = hw::vec2f{static_cast<float>(i % 640),
+                              static_cast<float>(i / 640)};
+        }
+
+        double const scalar_ns = time_ns_per_point(count, [&] {
+            hw::transform_points_scalar(matrix, in.data(), scalar.data(),
+                                        count);
+        });
+        double const simd_ns = time_ns_per_point(count, [&] {
+            hw::transform_points(matrix, in.data(), simd.data(), count);
+        });
+
+        for(std::size_t i = 0; i < count; ++i) {
+            if(std::fabs(simd[i].x - scalar[i].x) > 1e-3f ||
+               std::fabs(simd[i].y - scalar[i].y) > 1e-3f) {
+                same = false;
+            }
+        }
+
+        std::cout << count << " points: " << scalar_ns << " ns/point scalar, "
+                  << simd_ns << " ns/point batched("
+                  << scalar_ns / simd_ns << "x)\n";
+    }
+
+    if(!same) {
+        std::cout << "batched results differ from the scalar ones\n";
+        return 1;
+    }
+
+    return 0;
+}
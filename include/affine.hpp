@@ -0,0 +1,218 @@
+#pragma once
+#ifndef AFFINE_HPP
+#define AFFINE_HPP
+
+///
+/// @file affine.hpp
+/// This file contains a 2D affine transform(rotation, scale, translation)
+/// and functions that apply one to many points at once.
+///
+
+#include <cmath>
+#include <cstddef>
+
+#include "vec2.hpp"
+
+#if defined(__AVX__)
+#define HW_HAS_AVX
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HW_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace hw {
+    ///
+    /// @brief A 2x3 matrix mapping (x, y) to
+    ///        (a * x + c * y + tx, b * x + d * y + ty).
+    ///
+    /// Transforms combine with *, `first_then_second = second * first`.
+    ///
+    struct affine2
+    {
+        float a{1.0f};
+        float b{0.0f};
+        float c{0.0f};
+        float d{1.0f};
+        float tx{0.0f};
+        float ty{0.0f};
+
+        constexpr affine2() = default;
+        constexpr affine2(float const t_a, float const t_b, float const t_c,
+                          float const t_d, float const t_tx,
+                          float const t_ty) noexcept
+            : a(t_a)
+            , b(t_b)
+            , c(t_c)
+            , d(t_d)
+            , tx(t_tx)
+            , ty(t_ty)
+        {
+        }
+
+        static constexpr affine2 identity() noexcept
+        {
+            return affine2{};
+        }
+        static constexpr affine2 translation(vec2f const& t_offset) noexcept
+        {
+            return affine2{1.0f, 0.0f, 0.0f, 1.0f, t_offset.x, t_offset.y};
+        }
+        static constexpr affine2 scale(vec2f const& t_factors) noexcept
+        {
+            return affine2{t_factors.x, 0.0f, 0.0f, t_factors.y, 0.0f, 0.0f};
+        }
+        ///
+        /// @brief Clockwise on the screen, around the origin.
+        ///
+        static affine2 rotation(float const t_degrees) noexcept
+        {
+            float const radians = t_degrees * 3.14159265f / 180.0f;
+            float const cs = std::cos(radians);
+            float const sn = std::sin(radians);
+
+            return affine2{cs, sn, -sn, cs, 0.0f, 0.0f};
+        }
+
+        ///
+        /// @brief Applies @ref t_other first and this second.
+        ///
+        constexpr affine2 operator*(affine2 const& t_other) const noexcept
+        {
+            return affine2{a * t_other.a + c * t_other.b,
+                           b * t_other.a + d * t_other.b,
+                           a * t_other.c + c * t_other.d,
+                           b * t_other.c + d * t_other.d,
+                           a * t_other.tx + c * t_other.ty + tx,
+                           b * t_other.tx + d * t_other.ty + ty};
+        }
+
+        constexpr vec2f operator*(vec2f const& t_point) const noexcept
+        {
+            return vec2f{a * t_point.x + c * t_point.y + tx,
+                         b * t_point.x + d * t_point.y + ty};
+        }
+
+        constexpr float determinant() const noexcept
+        {
+            return a * d - b * c;
+        }
+
+        ///
+        /// @brief The transform that undoes this one, or the identity if
+        ///        there is none(everything was scaled by 0).
+        ///
+        affine2 inverse() const noexcept
+        {
+            float const det = this->determinant();
+
+            if(det == 0.0f) {
+                return affine2{};
+            }
+
+            float const inv = 1.0f / det;
+
+            return affine2{d * inv,
+                           -b * inv,
+                           -c * inv,
+                           a * inv,
+                           (c * ty - d * tx) * inv,
+                           (b * tx - a * ty) * inv};
+        }
+
+        constexpr bool operator==(affine2 const& t_other) const noexcept
+        {
+            return a == t_other.a && b == t_other.b && c == t_other.c &&
+                   d == t_other.d && tx == t_other.tx && ty == t_other.ty;
+        }
+        constexpr bool operator!=(affine2 const& t_other) const noexcept
+        {
+            return !this->operator==(t_other);
+        }
+    };
+
+    ///
+    /// @brief The scalar version of @ref transform_points, exposed so the
+    ///        vectorized one can be checked against it.
+    ///
+    inline void transform_points_scalar(affine2 const& t_matrix,
+                                        vec2f const* t_in, vec2f* t_out,
+                                        std::size_t const t_count) noexcept
+    {
+        for(std::size_t i = 0; i < t_count; ++i) {
+            t_out[i] = t_matrix * t_in[i];
+        }
+    }
+
+    ///
+    /// @brief Writes @ref t_matrix * @ref t_in[i] to @ref t_out[i] for
+    ///        @ref t_count points.
+    ///
+    /// Uses AVX(4 points at a time) or SSE2(2 points at a time) when the
+    /// compiler targets them. @ref t_in and @ref t_out may be the same
+    /// array but must not overlap otherwise.
+    ///
+    inline void transform_points(affine2 const& t_matrix, vec2f const* t_in,
+                                 vec2f* t_out,
+                                 std::size_t const t_count) noexcept
+    {
+        static_assert(sizeof(vec2f) == 2 * sizeof(float),
+                      "points are read as packed floats");
+
+        std::size_t i{0};
+
+#if defined(HW_HAS_AVX) || defined(HW_HAS_SSE2)
+        float const* in = &t_in->x;
+        float* out = &t_out->x;
+#endif
+
+#ifdef HW_HAS_AVX
+        // lanes hold x0 y0 x1 y1 x2 y2 x3 y3, each output lane is
+        // ab * xx + cd * yy + t with the pairs repeated across lanes
+        __m256 const ab8 = _mm256_setr_ps(t_matrix.a, t_matrix.b, t_matrix.a,
+                                          t_matrix.b, t_matrix.a, t_matrix.b,
+                                          t_matrix.a, t_matrix.b);
+        __m256 const cd8 = _mm256_setr_ps(t_matrix.c, t_matrix.d, t_matrix.c,
+                                          t_matrix.d, t_matrix.c, t_matrix.d,
+                                          t_matrix.c, t_matrix.d);
+        __m256 const t8 = _mm256_setr_ps(t_matrix.tx, t_matrix.ty, t_matrix.tx,
+                                         t_matrix.ty, t_matrix.tx, t_matrix.ty,
+                                         t_matrix.tx, t_matrix.ty);
+
+        for(; i + 4 <= t_count; i += 4) {
+            __m256 const p = _mm256_loadu_ps(in + i * 2);
+            __m256 const xx = _mm256_moveldup_ps(p);
+            __m256 const yy = _mm256_movehdup_ps(p);
+            __m256 const r = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(ab8, xx), _mm256_mul_ps(cd8, yy)),
+                t8);
+            _mm256_storeu_ps(out + i * 2, r);
+        }
+#endif
+
+#ifdef HW_HAS_SSE2
+        __m128 const ab = _mm_setr_ps(t_matrix.a, t_matrix.b, t_matrix.a,
+                                      t_matrix.b);
+        __m128 const cd = _mm_setr_ps(t_matrix.c, t_matrix.d, t_matrix.c,
+                                      t_matrix.d);
+        __m128 const t = _mm_setr_ps(t_matrix.tx, t_matrix.ty, t_matrix.tx,
+                                     t_matrix.ty);
+
+        for(; i + 2 <= t_count; i += 2) {
+            __m128 const p = _mm_loadu_ps(in + i * 2);
+            __m128 const xx = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 const yy = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+            __m128 const r = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(ab, xx), _mm_mul_ps(cd, yy)), t);
+            _mm_storeu_ps(out + i * 2, r);
+        }
+#endif
+
+        transform_points_scalar(t_matrix, t_in + i, t_out + i, t_count - i);
+    }
+} // namespace hw
+
+#endif // !AFFINE_HPP
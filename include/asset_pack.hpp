@@ -0,0 +1,132 @@
+#pragma once
+#ifndef ASSET_PACK_HPP
+#define ASSET_PACK_HPP
+
+///
+/// @file asset_pack.hpp
+/// This file contains the layout of asset packs, files holding images that
+/// were already decoded, and the object that reads them.
+///
+/// A pack is made by tools/hw_pack.cpp and looks like this, all numbers
+/// little endian:
+/// - @ref hw::pack_header
+/// - @ref hw::pack_header::count times @ref hw::pack_entry
+/// - the names of all entries, not 0 terminated
+/// - the pixels of every entry, each starting at a multiple of
+///   @ref hw::pack_alignment
+///
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "color.hpp"
+
+namespace hw {
+    constexpr char pack_magic[4] = {'H', 'W', 'P', 'K'};
+    constexpr std::uint32_t pack_version = 1;
+    constexpr std::size_t pack_alignment = 16;
+
+    struct pack_header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t count;
+        std::uint32_t names_size;
+    };
+
+    ///
+    /// @brief One image, already color keyed and converted to
+    ///        SDL_PIXELFORMAT_ARGB8888.
+    ///
+    struct pack_entry
+    {
+        ///
+        /// Relative to the start of the names.
+        ///
+        std::uint32_t name_offset;
+        std::uint32_t name_length;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t pitch;
+        std::uint32_t format;
+        ///
+        /// The color key the image was packed with, must match the one it
+        /// is loaded with.
+        ///
+        std::uint8_t key_r;
+        std::uint8_t key_g;
+        std::uint8_t key_b;
+        std::uint8_t reserved0;
+        std::uint32_t reserved1;
+        ///
+        /// Relative to the start of the file.
+        ///
+        std::uint64_t data_offset;
+    };
+
+    static_assert(sizeof(pack_header) == 16, "pack_header has padding");
+    static_assert(sizeof(pack_entry) == 40, "pack_entry has padding");
+
+    ///
+    /// @brief A pack mapped into memory, read only.
+    ///
+    /// Images are found by the exact path they were packed with, so pack
+    /// them with the same paths the program uses.
+    ///
+    class asset_pack
+    {
+      private:
+        unsigned char const* m_data{nullptr};
+        std::size_t m_size{0};
+        std::multimap<std::string, pack_entry const*> m_index{};
+
+#ifdef _WIN32
+        void* m_file{nullptr};
+        void* m_mapping{nullptr};
+#else
+        int m_fd{-1};
+#endif
+
+        bool map(std::string const& t_path);
+        bool read_index();
+
+        asset_pack() = default;
+
+      public:
+        asset_pack(asset_pack const&) = delete;
+        ~asset_pack() noexcept;
+
+        asset_pack& operator=(asset_pack const&) = delete;
+
+        ///
+        /// @brief Maps @ref t_path and checks its index.
+        ///
+        /// @retval nullptr if it's missing or not a valid pack.
+        ///
+        static std::shared_ptr<asset_pack> open(std::string const& t_path);
+
+        ///
+        /// @retval nullptr if there is no image packed as @ref t_name with
+        ///         @ref t_color_key.
+        ///
+        pack_entry const* find(std::string const& t_name,
+                               hw::color const& t_color_key) const;
+        ///
+        /// @brief The pixels of @ref t_entry, straight from the mapped file.
+        ///
+        inline void const* pixels(pack_entry const& t_entry) const noexcept
+        {
+            return m_data + t_entry.data_offset;
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return m_index.size();
+        }
+    };
+} // namespace hw
+
+#endif // !ASSET_PACK_HPP
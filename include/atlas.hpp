@@ -0,0 +1,154 @@
+#pragma once
+#ifndef ATLAS_HPP
+#define ATLAS_HPP
+
+///
+/// @file atlas.hpp
+/// This file contains the declaration of the texture atlas small images are
+/// packed into, so drawing many of them needs few texture switches.
+///
+
+#include <cstddef>
+#include <vector>
+
+#include "SDL2/SDL.h"
+
+namespace hw {
+    class texture;
+
+    ///
+    /// @brief Places rectangles inside a bigger one, bottom-left first,
+    ///        keeping track of the highest point used in every column
+    ///        range(the skyline).
+    ///
+    /// Space is never given back, see @ref texture_atlas::repack.
+    ///
+    class skyline_packer
+    {
+      private:
+        struct segment
+        {
+            int x;
+            int y;
+            int width;
+        };
+
+        int m_width{0};
+        int m_height{0};
+        std::vector<segment> m_skyline{};
+
+        ///
+        /// @retval -1 if a rect of the given size does not fit on top of the
+        ///         skyline starting at segment @ref t_index, otherwise the y
+        ///         coordinate it would be placed at.
+        ///
+        int fit(std::size_t const t_index, int const t_width,
+                int const t_height) const noexcept;
+
+      public:
+        skyline_packer(int const t_width, int const t_height);
+
+        ///
+        /// @brief Finds a place for a @ref t_width by @ref t_height rect.
+        ///
+        /// @param[out] t_result Where it was placed.
+        ///
+        /// @retval false if there is no room left.
+        ///
+        bool insert(int const t_width, int const t_height, SDL_Rect& t_result);
+        void reset();
+    };
+
+    ///
+    /// @brief Numbers about the atlas, see @ref get_atlas_stats.
+    ///
+    struct atlas_stats
+    {
+        std::size_t pages{0};
+        std::size_t images{0};
+        std::size_t repacks{0};
+        ///
+        /// Pixels of images still alive divided by the pixels of all pages.
+        ///
+        double occupancy{0.0};
+    };
+
+    ///
+    /// @brief A few big textures that small @ref texture objects are
+    ///        uploaded into instead of getting their own.
+    ///
+    /// Every page is @ref page_size squared. When an image does not fit in
+    /// any page and less than half of the pages is used by images that are
+    /// still alive, every image is copied into fresh pages, closer together,
+    /// before a new page is added.
+    ///
+    /// @attention Must only be used from the thread that owns the renderer.
+    ///
+    class texture_atlas
+    {
+      private:
+        struct page
+        {
+            SDL_Texture* handle;
+            hw::skyline_packer packer;
+            std::size_t live_area;
+        };
+
+        struct entry
+        {
+            hw::texture* owner;
+            std::size_t page;
+        };
+
+        SDL_Renderer* m_renderer{nullptr};
+        std::vector<page> m_pages{};
+        std::vector<entry> m_entries{};
+        std::size_t m_repacks{0};
+
+        bool add_page();
+        bool find_room(int const t_width, int const t_height,
+                       std::size_t& t_page, SDL_Rect& t_rect);
+        bool place(int const t_width, int const t_height, std::size_t& t_page,
+                   SDL_Rect& t_rect);
+        void repack();
+
+      public:
+        static constexpr int page_size = 1024;
+        ///
+        /// Images wider or taller than this get their own texture.
+        ///
+        static constexpr int max_image_size = 256;
+
+        texture_atlas() = default;
+        texture_atlas(texture_atlas const&) = delete;
+        ~texture_atlas() noexcept;
+
+        texture_atlas& operator=(texture_atlas const&) = delete;
+
+        ///
+        /// @brief Copies @ref t_pixels into a page and points @ref t_owner
+        ///        at it.
+        ///
+        /// @param[in] t_pixels Must be SDL_PIXELFORMAT_ARGB8888.
+        ///
+        /// @retval false if the image is too big or no page could be
+        ///         created, then @ref t_owner is left alone.
+        ///
+        bool insert(SDL_Renderer* t_renderer, hw::texture& t_owner,
+                    SDL_Surface* t_pixels);
+        ///
+        /// @brief Gives the space of @ref t_owner back at the next repack.
+        ///
+        void remove(hw::texture const& t_owner) noexcept;
+        ///
+        /// @brief Drops every page without destroying them, for when
+        ///        @ref t_renderer is about to free them itself.
+        ///
+        void forget(SDL_Renderer* t_renderer) noexcept;
+
+        hw::atlas_stats stats() const noexcept;
+        std::size_t bytes() const noexcept;
+    };
+} // namespace hw
+
+#endif // !ATLAS_HPP
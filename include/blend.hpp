@@ -0,0 +1,98 @@
+#pragma once
+#ifndef BLEND_HPP
+#define BLEND_HPP
+
+///
+/// @file blend.hpp
+/// This file contains how drawn things are combined with what is already
+/// on the screen, and functions that blend arrays of colors on the CPU.
+///
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SDL2/SDL.h"
+
+#include "color.hpp"
+
+namespace hw {
+    ///
+    /// @brief How the color of what is drawn is combined with the color
+    ///        already there.
+    ///
+    /// Applies to shapes and @ref dummy_api::Canvas pixels, the colors the
+    /// program gives. Images keep the straight alpha their
+    /// files have in every mode except @ref none.
+    ///
+    enum class blend_mode : std::uint8_t
+    {
+        ///
+        /// Colors replace what is there, alpha included.
+        ///
+        none,
+        ///
+        /// The usual translucency: `src * a + dst * (1 - a)`.
+        ///
+        alpha,
+        ///
+        /// Like @ref alpha for colors whose r, g and b were already
+        /// multiplied by a(see @ref color::premultiplied):
+        /// `src + dst * (1 - a)`. Lets a color both cover and brighten
+        /// what is under it, and is what overlays rendered elsewhere use.
+        ///
+        premultiplied,
+        ///
+        /// `dst + src * a`, for lights and glows.
+        ///
+        add
+    };
+
+    ///
+    /// @brief The mode SDL should use to draw colors the program gave with
+    ///        @ref t_mode.
+    ///
+    /// @note The software renderer only supports SDL's built in modes,
+    ///       it refuses @ref blend_mode::premultiplied.
+    ///
+    SDL_BlendMode shape_blend_mode(hw::blend_mode const t_mode) noexcept;
+    ///
+    /// @brief The mode SDL should use to draw decoded image files with
+    ///        @ref t_mode.
+    ///
+    SDL_BlendMode image_blend_mode(hw::blend_mode const t_mode) noexcept;
+
+    ///
+    /// @brief `t_out[i] = t_from[i] + (t_to[i] - t_from[i]) * t_amount`, on
+    ///        every channel.
+    ///
+    /// @param[in] t_amount Between 0(all @ref t_from) and 1(all
+    ///                     @ref t_to), precise to 1/256.
+    ///
+    void lerp_colors(hw::color const* t_from, hw::color const* t_to,
+                     float const t_amount, hw::color* t_out,
+                     std::size_t const t_count) noexcept;
+    ///
+    /// @brief Draws @ref t_src over @ref t_dst with @ref blend_mode::alpha,
+    ///        the result is written to @ref t_dst.
+    ///
+    void blend_over(hw::color const* t_src, hw::color* t_dst,
+                    std::size_t const t_count) noexcept;
+    ///
+    /// @brief `t_out[i] = t_lhs[i] * t_rhs[i]` on every channel, with 255
+    ///        being 1. Tints, shadows...
+    ///
+    void multiply_colors(hw::color const* t_lhs, hw::color const* t_rhs,
+                         hw::color* t_out, std::size_t const t_count) noexcept;
+    ///
+    /// @brief Turns straight colors into premultiplied ones in place.
+    ///
+    void premultiply(hw::color* t_colors, std::size_t const t_count) noexcept;
+    ///
+    /// @brief Same as @ref premultiply for ARGB8888 pixels, from
+    ///        @ref t_in to @ref t_out which may be the same.
+    ///
+    void premultiply_pixels(std::uint32_t const* t_in, std::uint32_t* t_out,
+                            std::size_t const t_count) noexcept;
+} // namespace hw
+
+#endif // !BLEND_HPP
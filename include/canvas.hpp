@@ -0,0 +1,97 @@
+#pragma once
+#ifndef CANVAS_HPP
+#define CANVAS_HPP
+
+///
+/// @file canvas.hpp
+/// This file contains the declaration of a texture whose pixels are written
+/// by the program every frame, and of the threads that help writing them.
+///
+
+#include <atomic>
+#include <cstdint>
+
+#include "SDL2/SDL.h"
+
+#include "color.hpp"
+#include "thread_pool.hpp"
+
+namespace hw {
+    void forget_canvases(SDL_Renderer* t_renderer);
+
+    ///
+    /// @brief A streaming SDL_Texture that receives pixels recorded in a
+    ///        @ref draw_list.
+    ///
+    /// Like @ref texture it can be created on any thread, while
+    /// @ref get must only be called on the thread that draws with the
+    /// renderer.
+    ///
+    class canvas_texture
+    {
+      private:
+        int m_width{0};
+        int m_height{0};
+
+        SDL_Texture* m_handle{nullptr};
+        SDL_Renderer* m_renderer{nullptr};
+        ///
+        /// Set while @ref m_handle holds nothing worth drawing, eg. right
+        /// after it was created for a new renderer.
+        ///
+        std::atomic<bool> m_needs_pixels{true};
+
+        friend void forget_canvases(SDL_Renderer* t_renderer);
+
+      public:
+        canvas_texture(int const t_width, int const t_height);
+        canvas_texture(canvas_texture const&) = delete;
+        ~canvas_texture() noexcept;
+
+        canvas_texture& operator=(canvas_texture const&) = delete;
+
+        ///
+        /// @brief Returns the SDL_Texture, first copying @ref t_pixels into
+        ///        it when they are given.
+        ///
+        /// @param[in] t_pixels ARGB8888, @ref width by @ref height pixels
+        ///                     with no padding between rows, or nullptr to
+        ///                     keep what was uploaded last time.
+        ///
+        /// @retval nullptr if nothing was uploaded yet.
+        ///
+        SDL_Texture* get(SDL_Renderer* t_renderer,
+                         std::uint32_t const* t_pixels);
+
+        ///
+        /// @brief Whether the next @ref get has to be given pixels for
+        ///        anything to show up.
+        ///
+        inline bool needs_pixels() const noexcept
+        {
+            return m_needs_pixels.load(std::memory_order_acquire);
+        }
+
+        inline int width() const noexcept
+        {
+            return m_width;
+        }
+        inline int height() const noexcept
+        {
+            return m_height;
+        }
+    };
+
+    ///
+    /// @brief Threads shared by every @ref dummy_api::Canvas::parallel_fill.
+    ///
+    hw::thread_pool& get_fill_workers();
+
+    ///
+    /// @brief Must be called right before @ref t_renderer is destroyed, see
+    ///        @ref forget_textures.
+    ///
+    void forget_canvases(SDL_Renderer* t_renderer);
+} // namespace hw
+
+#endif // !CANVAS_HPP
@@ -0,0 +1,193 @@
+#pragma once
+#ifndef COLLISION_HPP
+#define COLLISION_HPP
+
+///
+/// @file collision.hpp
+/// This file contains overlap tests between rectangles, circles and
+/// triangles, and a set of them that finds every overlapping pair at once.
+///
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "vec2.hpp"
+
+namespace hw {
+    ///
+    /// @brief The outline of something that can collide, in pixels.
+    ///
+    /// Shapes are open: ones that only touch do not overlap, so two
+    /// rectangles side by side(like tiles) never collide.
+    ///
+    struct collider
+    {
+        enum class kind : std::uint8_t
+        {
+            ///
+            /// From @ref points[0] (top left) to @ref points[1] (bottom
+            /// right).
+            ///
+            rect,
+            ///
+            /// Centered at @ref points[0].
+            ///
+            circle,
+            ///
+            /// The corners in @ref points, in any order.
+            ///
+            triangle
+        };
+
+        kind type{kind::rect};
+        hw::vec2f points[3]{};
+        float radius{0.0f};
+    };
+
+    ///
+    /// @brief From @ref t_pos to @ref t_pos + @ref t_dim, negative sizes
+    ///        are fine.
+    ///
+    collider rect_collider(hw::vec2f const& t_pos,
+                           hw::vec2f const& t_dim) noexcept;
+    collider circle_collider(hw::vec2f const& t_center,
+                             float const t_radius) noexcept;
+    collider triangle_collider(hw::vec2f const& t_a, hw::vec2f const& t_b,
+                               hw::vec2f const& t_c) noexcept;
+    ///
+    /// @brief A flat triangle, which overlaps what the segment crosses.
+    ///
+    collider line_collider(hw::vec2f const& t_a,
+                           hw::vec2f const& t_b) noexcept;
+    ///
+    /// @brief The pixel @ref t_pos is drawn to, from @ref t_pos to
+    ///        @ref t_pos + (1, 1).
+    ///
+    collider point_collider(hw::vec2f const& t_pos) noexcept;
+
+    ///
+    /// @brief Smallest axis aligned box around a collider.
+    ///
+    struct bounds
+    {
+        float min_x;
+        float min_y;
+        float max_x;
+        float max_y;
+    };
+
+    bounds bounds_of(collider const& t_collider) noexcept;
+
+    ///
+    /// @brief Whether @ref t_lhs and @ref t_rhs share any area, exactly.
+    ///
+    bool overlap(collider const& t_lhs, collider const& t_rhs) noexcept;
+
+    ///
+    /// @brief Two ids given by @ref collision_world::add, @ref first being
+    ///        the smaller one.
+    ///
+    struct collision_pair
+    {
+        std::uint32_t first;
+        std::uint32_t second;
+    };
+
+    ///
+    /// @brief Colliders that are checked against each other all at once.
+    ///
+    /// Finding pairs sorts the boxes around the colliders by their left
+    /// edge and only tests the ones whose boxes overlap(sweep and prune).
+    /// The order is kept for the next time, and since things only move a
+    /// little between frames it is mostly sorted already, so sorting it
+    /// again costs about one pass over the boxes. Boxes in reach on x are
+    /// tested on y 4 at a time. Ids of removed colliders are given out
+    /// again.
+    ///
+    class collision_world
+    {
+      private:
+        ///
+        /// A box in the sorted order, copied next to each other so the
+        /// sweep reads memory in order.
+        ///
+        struct entry
+        {
+            bounds box;
+            std::uint32_t id;
+        };
+
+        std::vector<collider> m_colliders{};
+        std::vector<bounds> m_bounds{};
+        std::vector<bool> m_alive{};
+        std::vector<std::uint32_t> m_free{};
+
+        std::vector<entry> m_sorted{};
+        ///
+        /// The boxes of @ref m_sorted one array per side, so the sweep
+        /// tests several of them at once.
+        ///
+        std::vector<float> m_min_x{};
+        std::vector<float> m_max_x{};
+        std::vector<float> m_min_y{};
+        std::vector<float> m_max_y{};
+        ///
+        /// Ids added since the last @ref find_pairs, not in
+        /// @ref m_sorted yet.
+        ///
+        std::vector<std::uint32_t> m_added{};
+        ///
+        /// Ids removed since the last @ref find_pairs, still in
+        /// @ref m_sorted.
+        ///
+        std::vector<std::uint32_t> m_removed{};
+        std::size_t m_count{0};
+
+        std::vector<collision_pair> m_pairs{};
+
+        ///
+        /// @brief Adds the colliders at @ref t_lhs and @ref t_rhs in
+        ///        @ref m_sorted to the pairs if they overlap.
+        ///
+        void test_pair(std::size_t const t_lhs, std::size_t const t_rhs);
+
+      public:
+        std::uint32_t add(collider const& t_collider);
+        ///
+        /// @brief Replaces the collider of @ref t_id, eg. after it moved.
+        ///
+        void move(std::uint32_t const t_id,
+                  collider const& t_collider) noexcept;
+        void remove(std::uint32_t const t_id);
+        void clear() noexcept;
+
+        ///
+        /// @brief Every pair of colliders that overlap, each pair once.
+        ///
+        /// The result stays valid until the next call.
+        ///
+        std::vector<collision_pair> const& find_pairs();
+        ///
+        /// @brief Same as @ref find_pairs but tests every pair of
+        ///        colliders, exposed so the sweep can be checked against
+        ///        it.
+        ///
+        std::vector<collision_pair> const& find_pairs_brute_force();
+
+        inline collider const& get(std::uint32_t const t_id) const noexcept
+        {
+            return m_colliders[t_id];
+        }
+        inline bool contains(std::uint32_t const t_id) const noexcept
+        {
+            return t_id < m_alive.size() && m_alive[t_id];
+        }
+        inline std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+    };
+} // namespace hw
+
+#endif // !COLLISION_HPP
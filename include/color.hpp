@@ -13,7 +13,11 @@ namespace hw {
     ///
     /// @brief Describes a @ref color object.
     ///
-    struct color
+    /// Packed into 4 bytes in the same order as SDL_Color, so arrays of
+    /// colors can be handed to SDL or processed 4 at a time(see
+    /// blend.hpp) without converting anything.
+    ///
+    struct alignas(4) color
     {
         std::uint8_t r{255};
         std::uint8_t g{255};
@@ -23,8 +27,15 @@ namespace hw {
         constexpr color() = default;
         color(const color&) = default;
         color(color&&) = default;
-        color(const std::uint8_t t_r, const std::uint8_t t_g,
-              const std::uint8_t t_b, const std::uint8_t t_a = 255);
+        constexpr color(const std::uint8_t t_r, const std::uint8_t t_g,
+                        const std::uint8_t t_b,
+                        const std::uint8_t t_a = 255) noexcept
+            : r(t_r)
+            , g(t_g)
+            , b(t_b)
+            , a(t_a)
+        {
+        }
         ~color() = default;
 
         color& operator=(const color&) = default;
@@ -39,7 +50,39 @@ namespace hw {
         {
             return !this->operator==(t_other);
         }
+
+        ///
+        /// @brief The color with r, g and b already multiplied by a, see
+        ///        @ref blend_mode::premultiplied.
+        ///
+        constexpr color premultiplied() const noexcept
+        {
+            return color{static_cast<std::uint8_t>((r * a + 127) / 255),
+                         static_cast<std::uint8_t>((g * a + 127) / 255),
+                         static_cast<std::uint8_t>((b * a + 127) / 255), a};
+        }
     };
+
+    static_assert(sizeof(color) == 4, "colors are packed into 32 bits");
+
+    ///
+    /// @brief @ref t_color as an ARGB8888 pixel, the format of every
+    ///        texture the library creates.
+    ///
+    constexpr std::uint32_t to_argb(hw::color const& t_color) noexcept
+    {
+        return (static_cast<std::uint32_t>(t_color.a) << 24) |
+               (static_cast<std::uint32_t>(t_color.r) << 16) |
+               (static_cast<std::uint32_t>(t_color.g) << 8) |
+               static_cast<std::uint32_t>(t_color.b);
+    }
+    constexpr hw::color from_argb(std::uint32_t const t_pixel) noexcept
+    {
+        return hw::color{static_cast<std::uint8_t>(t_pixel >> 16),
+                         static_cast<std::uint8_t>(t_pixel >> 8),
+                         static_cast<std::uint8_t>(t_pixel),
+                         static_cast<std::uint8_t>(t_pixel >> 24)};
+    }
 } // namespace hw
 
 #endif // !COLOR_HPP
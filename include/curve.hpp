@@ -0,0 +1,84 @@
+#pragma once
+#ifndef CURVE_HPP
+#define CURVE_HPP
+
+///
+/// @file curve.hpp
+/// This file contains how curves are turned into lines that can be drawn.
+///
+
+#include <vector>
+
+#include "affine.hpp"
+#include "vec2.hpp"
+
+namespace hw {
+    ///
+    /// @brief How far, in pixels, flattened curves may be from the real
+    ///        ones.
+    ///
+    constexpr float curve_tolerance{0.25f};
+
+    ///
+    /// @brief @ref curve_tolerance for curves that @ref t_transform will
+    ///        scale before they show up on the screen.
+    ///
+    float local_tolerance(hw::affine2 const& t_transform) noexcept;
+
+    ///
+    /// @brief A flattened curve, kept between frames by the shapes that
+    ///        draw curves.
+    ///
+    struct flattened_curve
+    {
+        std::vector<hw::vec2f> points{};
+        ///
+        /// Of @ref points closed back to the first one, only for filled
+        /// curves.
+        ///
+        std::vector<int> triangles{};
+        ///
+        /// What @ref points were flattened with, negative when they have
+        /// to be flattened again.
+        ///
+        float tolerance{-1.0f};
+    };
+
+    ///
+    /// @brief Appends points along the quadratic Bezier curve from
+    ///        @ref t_start to @ref t_end pulled towards @ref t_control,
+    ///        both ends included.
+    ///
+    /// The number of points grows with how much the curve bends, not with
+    /// its length: a straight curve is 2 points however long it is. Every
+    /// point of the curve is at most @ref t_tolerance away from the lines.
+    ///
+    void flatten_quadratic(hw::vec2f const& t_start, hw::vec2f const& t_control,
+                           hw::vec2f const& t_end, float const t_tolerance,
+                           std::vector<hw::vec2f>& t_points);
+    ///
+    /// @brief Same as @ref flatten_quadratic for a cubic curve with 2
+    ///        control points.
+    ///
+    void flatten_cubic(hw::vec2f const& t_start, hw::vec2f const& t_first,
+                       hw::vec2f const& t_second, hw::vec2f const& t_end,
+                       float const t_tolerance,
+                       std::vector<hw::vec2f>& t_points);
+    ///
+    /// @brief Appends points along the arc of the circle around
+    ///        @ref t_center, both ends included.
+    ///
+    /// @param[in] t_start_angle Degrees, clockwise from the right of the
+    ///                          center(the way y goes down on the screen).
+    /// @param[in] t_end_angle Degrees, the arc goes clockwise if bigger
+    ///                        than @ref t_start_angle and counter
+    ///                        clockwise otherwise. At most a full circle
+    ///                        is drawn.
+    ///
+    void flatten_arc(hw::vec2f const& t_center, float const t_radius,
+                     float const t_start_angle, float const t_end_angle,
+                     float const t_tolerance,
+                     std::vector<hw::vec2f>& t_points);
+} // namespace hw
+
+#endif // !CURVE_HPP
@@ -0,0 +1,440 @@
+#pragma once
+#ifndef DRAW_LIST_HPP
+#define DRAW_LIST_HPP
+
+///
+/// @file draw_list.hpp
+/// This file contains the declaration of a list of drawing commands that
+/// describe one frame.
+///
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SDL2/SDL.h"
+
+#include "affine.hpp"
+#include "blend.hpp"
+#include "canvas.hpp"
+#include "color.hpp"
+#include "font.hpp"
+#include "texture.hpp"
+#include "tile_map.hpp"
+#include "vec2.hpp"
+
+namespace hw {
+    ///
+    /// @brief One instance of a texture drawn by @ref draw_list::sprites.
+    ///
+    struct sprite
+    {
+        ///
+        /// Top left corner and size before rotating.
+        ///
+        hw::vec2 pos{};
+        hw::vec2 dim{};
+        ///
+        /// Multiplied with the texture, white leaves it as it is.
+        ///
+        hw::color tint{255, 255, 255, 255};
+        ///
+        /// Degrees, clockwise around the center.
+        ///
+        float angle{0.0f};
+    };
+
+    ///
+    /// @brief One primitive to draw, with everything copied by value.
+    ///
+    struct draw_command
+    {
+        enum class kind : std::uint8_t
+        {
+            clear,
+            point,
+            line,
+            triangle,
+            outline_triangle,
+            rectangle,
+            outline_rectangle,
+            circle,
+            outline_circle,
+            image,
+            sprites,
+            canvas,
+            polygon,
+            outline_polygon,
+            polyline,
+            text,
+            particles,
+            tile_chunk
+        };
+
+        kind type{kind::clear};
+        ///
+        /// Position of points, start of lines, first vertex of triangles,
+        /// top left of rectangles and images, center of circles.
+        ///
+        hw::vec2 first{};
+        ///
+        /// End of lines, second vertex of triangles, dimensions of
+        /// rectangles and images, x is the radius of circles and the size
+        /// of particles.
+        ///
+        hw::vec2 second{};
+        ///
+        /// Third vertex of triangles. For @ref kind::tile_chunk, x is where
+        /// the palette starts in the colors kept by the list and y how many
+        /// colors it has.
+        ///
+        hw::vec2 third{};
+        hw::color color{};
+        hw::blend_mode blend{hw::blend_mode::alpha};
+        std::shared_ptr<hw::texture> texture{};
+        ///
+        /// Part of the image to draw, in pixels of the image. Empty draws
+        /// all of it.
+        ///
+        SDL_Rect frame{0, 0, 0, 0};
+        std::shared_ptr<hw::canvas_texture> canvas{};
+        std::shared_ptr<hw::font> font{};
+        std::shared_ptr<hw::tile_chunk> chunk{};
+        ///
+        /// Range of the data the command needs that is kept by the list
+        /// itself, eg. the instances of @ref kind::sprites, the pixels of
+        /// @ref kind::canvas, the characters of @ref kind::text, the
+        /// colors of @ref kind::particles or the tiles of
+        /// @ref kind::tile_chunk.
+        ///
+        std::size_t offset{0};
+        std::size_t count{0};
+        ///
+        /// Set when a transform turned the rectangle of a rectangle, image
+        /// or canvas into some other shape. Its 4 corners, clockwise from
+        /// what was the top left one, are kept by the list starting at
+        /// @ref points.
+        ///
+        bool quad{false};
+        ///
+        /// Where the corners of quads, polygons and glyphs or the centers of
+        /// particles start in the positions kept by the list, and how many
+        /// there are. The triangles of filled polygons are in @ref offset
+        /// and @ref count.
+        ///
+        std::size_t points{0};
+        std::size_t point_count{0};
+        ///
+        /// Set for filled polygons with a color per corner(eg. gradients),
+        /// kept by the list starting at @ref colors in the same order as
+        /// the corners.
+        ///
+        bool shaded{false};
+        std::size_t colors{0};
+    };
+
+    ///
+    /// @brief Everything that has to be drawn in a frame.
+    ///
+    /// The main loop records into a list and then executes it on the thread
+    /// that owns the renderer. Since every command is a copy, a recorded
+    /// list stays valid while the shapes it came from keep changing, which
+    /// is what allows drawing a frame while the next one is being built.
+    ///
+    class draw_list
+    {
+      private:
+        std::vector<hw::draw_command> m_commands{};
+        std::vector<hw::sprite> m_sprites{};
+        std::vector<std::uint32_t> m_pixels{};
+        std::vector<hw::vec2f> m_points{};
+        std::vector<int> m_triangles{};
+        std::string m_text{};
+        std::vector<hw::color> m_colors{};
+        std::vector<int> m_tiles{};
+        std::uint32_t m_input_time{0};
+        ///
+        /// Given to every command recorded from now on.
+        ///
+        hw::blend_mode m_blend{hw::blend_mode::alpha};
+        ///
+        /// Applied to everything recorded from now on, and the ones it
+        /// replaced, see @ref push_transform.
+        ///
+        hw::affine2 m_transform{};
+        std::vector<hw::affine2> m_saved_transforms{};
+        bool m_transformed{false};
+
+        ///
+        /// Scratch space for @ref execute, kept to avoid allocating every
+        /// frame.
+        ///
+        mutable std::vector<SDL_Vertex> m_vertices{};
+        mutable std::vector<int> m_indices{};
+        mutable std::vector<SDL_FPoint> m_line_points{};
+
+        void push(hw::draw_command::kind const t_kind, hw::vec2 const& t_first,
+                  hw::vec2 const& t_second, hw::vec2 const& t_third,
+                  hw::color const& t_color);
+        ///
+        /// @brief @ref t_pos moved by the current transform, rounded to the
+        ///        nearest pixel.
+        ///
+        hw::vec2 place(hw::vec2 const& t_pos) const noexcept;
+        ///
+        /// @brief Records a rectangle, image or canvas command covering
+        ///        @ref t_pos and @ref t_dim once transformed.
+        ///
+        /// Stays a rectangle while the transform keeps edges horizontal and
+        /// vertical(and for images, not mirrored), otherwise the corners
+        /// are kept and the command becomes a @ref draw_command::quad.
+        ///
+        void push_rect(hw::draw_command::kind const t_kind,
+                       hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                       hw::color const& t_color);
+
+        ///
+        /// @brief Copies @ref t_count positions into the list moved by the
+        ///        current transform.
+        ///
+        /// @returns Where they start.
+        ///
+        std::size_t keep_points(hw::vec2f const* t_points,
+                                std::size_t const t_count);
+
+        ///
+        /// @brief Draws the filled polygons and rectangle quads in
+        ///        [@ref t_first, @ref t_last) with one SDL_RenderGeometry.
+        ///
+        void draw_geometry(SDL_Renderer* t_renderer, std::size_t const t_first,
+                           std::size_t const t_last) const;
+        ///
+        /// @brief Draws an outline polygon or a polyline with one
+        ///        SDL_RenderDrawLinesF.
+        ///
+        void draw_lines(SDL_Renderer* t_renderer,
+                        hw::draw_command const& t_cmd) const;
+        ///
+        /// @brief Draws the image commands in [@ref t_first, @ref t_last)
+        ///        that all use @ref t_handle with one SDL_RenderGeometry.
+        ///
+        void draw_images(SDL_Renderer* t_renderer, SDL_Texture* t_handle,
+                         std::size_t const t_first,
+                         std::size_t const t_last) const;
+        void draw_sprites(SDL_Renderer* t_renderer,
+                          hw::draw_command const& t_cmd) const;
+        void draw_canvas(SDL_Renderer* t_renderer,
+                         hw::draw_command const& t_cmd) const;
+        void draw_text(SDL_Renderer* t_renderer,
+                       hw::draw_command const& t_cmd) const;
+        void draw_particles(SDL_Renderer* t_renderer,
+                            hw::draw_command const& t_cmd) const;
+        void draw_chunk(SDL_Renderer* t_renderer,
+                        hw::draw_command const& t_cmd) const;
+
+      public:
+        ///
+        /// @brief Removes all commands but keeps the memory around.
+        ///
+        /// The blend mode goes back to @ref blend_mode::alpha and the
+        /// transform to the identity.
+        ///
+        void reset() noexcept;
+
+        ///
+        /// @brief How the commands recorded after this blend with what is
+        ///        drawn before them.
+        ///
+        inline void set_blend_mode(hw::blend_mode const t_mode) noexcept
+        {
+            m_blend = t_mode;
+        }
+        inline hw::blend_mode blend_mode() const noexcept
+        {
+            return m_blend;
+        }
+
+        ///
+        /// @brief Applies @ref t_transform to everything recorded until the
+        ///        matching @ref pop_transform, before the transforms pushed
+        ///        earlier.
+        ///
+        /// Positions are transformed as they are recorded so executing the
+        /// list costs the same. Rectangles, images and canvases that no
+        /// longer line up with the screen are drawn as 2 triangles, circles
+        /// only follow the average scale(they stay circles) and sprites
+        /// ignore skewing.
+        ///
+        void push_transform(hw::affine2 const& t_transform);
+        ///
+        /// @brief Goes back to the transform before the last
+        ///        @ref push_transform, does nothing if there is none.
+        ///
+        void pop_transform() noexcept;
+        ///
+        /// @brief Drops every pushed transform.
+        ///
+        void reset_transform() noexcept;
+        inline hw::affine2 const& transform() const noexcept
+        {
+            return m_transform;
+        }
+
+        void clear(hw::color const& t_color);
+        void point(hw::vec2 const& t_pos, hw::color const& t_color);
+        void line(hw::vec2 const& t_start, hw::vec2 const& t_end,
+                  hw::color const& t_color);
+        void triangle(hw::vec2 const& t_first, hw::vec2 const& t_second,
+                      hw::vec2 const& t_third, hw::color const& t_color);
+        void outline_triangle(hw::vec2 const& t_first, hw::vec2 const& t_second,
+                              hw::vec2 const& t_third,
+                              hw::color const& t_color);
+        void rectangle(hw::vec2 const& t_pos, int const t_width,
+                       int const t_height, hw::color const& t_color);
+        void outline_rectangle(hw::vec2 const& t_pos, int const t_width,
+                               int const t_height, hw::color const& t_color);
+        void circle(hw::vec2 const& t_pos, int const t_radius,
+                    hw::color const& t_color);
+        void outline_circle(hw::vec2 const& t_pos, int const t_radius,
+                            hw::color const& t_color);
+        ///
+        /// @brief Fills the polygon with corners @ref t_points.
+        ///
+        /// @param[in] t_triangles 3 indices into @ref t_points for every
+        ///                        triangle, see @ref triangulate.
+        ///
+        void polygon(hw::vec2f const* t_points, std::size_t const t_count,
+                     int const* t_triangles, std::size_t const t_index_count,
+                     hw::color const& t_color);
+        ///
+        /// @brief @ref polygon with @ref t_colors blended across the
+        ///        triangles, one for each of @ref t_points.
+        ///
+        void shaded_polygon(hw::vec2f const* t_points,
+                            hw::color const* t_colors,
+                            std::size_t const t_count,
+                            int const* t_triangles,
+                            std::size_t const t_index_count);
+        ///
+        /// @brief Draws the edges of the polygon with corners
+        ///        @ref t_points, the last one joined with the first.
+        ///
+        void outline_polygon(hw::vec2f const* t_points,
+                             std::size_t const t_count,
+                             hw::color const& t_color);
+        ///
+        /// @brief Draws lines joining @ref t_points one after the other,
+        ///        eg. a flattened curve(see curve.hpp).
+        ///
+        void polyline(hw::vec2f const* t_points, std::size_t const t_count,
+                      hw::color const& t_color);
+        void image(std::shared_ptr<hw::texture> const& t_texture,
+                   hw::vec2 const& t_pos, hw::vec2 const& t_dim);
+        ///
+        /// @brief Draws only the @ref t_frame part of the image, eg. one
+        ///        frame of a sprite sheet.
+        ///
+        void image(std::shared_ptr<hw::texture> const& t_texture,
+                   hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                   SDL_Rect const& t_frame);
+        ///
+        /// @brief Draws @ref t_texture once for every one of @ref t_sprites
+        ///        with a single SDL_RenderGeometry call.
+        ///
+        /// The instances are copied into memory the list keeps between
+        /// frames, so this does not allocate once the list is warmed up.
+        ///
+        void sprites(std::shared_ptr<hw::texture> const& t_texture,
+                     hw::sprite const* t_sprites, std::size_t const t_count);
+        ///
+        /// @brief Draws @ref t_canvas stretched over the rectangle at
+        ///        @ref t_pos.
+        ///
+        /// @param[in] t_pixels The new contents of the canvas, copied into
+        ///                     the list. nullptr keeps what it showed last,
+        ///                     which costs nothing.
+        ///
+        void canvas(std::shared_ptr<hw::canvas_texture> const& t_canvas,
+                    hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                    std::uint32_t const* t_pixels);
+        ///
+        /// @brief Draws @ref t_count glyphs of @ref t_font with one
+        ///        SDL_RenderGeometry call.
+        ///
+        /// @param[in] t_corners 4 corners per glyph and @ref t_glyphs the
+        ///                      character of each, as given by
+        ///                      @ref font::layout.
+        /// @param[in] t_color Multiplied with the glyphs.
+        ///
+        void text(std::shared_ptr<hw::font> const& t_font,
+                  hw::vec2f const* t_corners, char const* t_glyphs,
+                  std::size_t const t_count, hw::color const& t_color);
+        ///
+        /// @brief Draws a square of @ref t_size pixels centered on every
+        ///        (@ref t_x[i], @ref t_y[i]), all with one
+        ///        SDL_RenderGeometry call.
+        ///
+        /// @param[in] t_texture Stretched over every square and multiplied
+        ///                      with its color, nullptr fills them with
+        ///                      their color.
+        ///
+        void particles(std::shared_ptr<hw::texture> const& t_texture,
+                       float const* t_x, float const* t_y,
+                       hw::color const* t_colors, std::size_t const t_count,
+                       int const t_size);
+        ///
+        /// @brief Draws @ref t_chunk with its top left corner at
+        ///        @ref t_pos.
+        ///
+        /// @param[in] t_tiles The tiles of the chunk if they changed, copied
+        ///                    into the list and drawn into the chunk before
+        ///                    anything else is drawn(see
+        ///                    @ref tile_chunk::render). nullptr shows what
+        ///                    it showed last, which costs one copy of the
+        ///                    texture.
+        /// @param[in] t_tileset Only used with @ref t_tiles, like the
+        ///                      palette.
+        ///
+        void chunk(std::shared_ptr<hw::tile_chunk> const& t_chunk,
+                   hw::vec2 const& t_pos,
+                   std::shared_ptr<hw::texture> const& t_tileset,
+                   int const* t_tiles, hw::color const* t_palette,
+                   std::size_t const t_palette_size);
+
+        ///
+        /// @brief Draws every command in order.
+        ///
+        /// Consecutive images that live in the same texture(see
+        /// @ref texture_atlas) are drawn together.
+        ///
+        /// @attention Must be called from the thread that owns
+        ///            @ref t_renderer.
+        ///
+        void execute(SDL_Renderer* t_renderer) const;
+
+        inline std::size_t size() const noexcept
+        {
+            return m_commands.size();
+        }
+
+        ///
+        /// @brief Remembers the SDL timestamp of the oldest input this frame
+        ///        reacts to, so the time until it is presented can be
+        ///        measured.
+        ///
+        inline void set_input_time(std::uint32_t const t_ticks) noexcept
+        {
+            m_input_time = t_ticks;
+        }
+        ///
+        /// @retval 0 if the frame did not react to any input.
+        ///
+        inline std::uint32_t input_time() const noexcept
+        {
+            return m_input_time;
+        }
+    };
+} // namespace hw
+
+#endif // !DRAW_LIST_HPP
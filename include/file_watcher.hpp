@@ -0,0 +1,56 @@
+#pragma once
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+///
+/// @file file_watcher.hpp
+/// This file contains the declaration of an object that tells which files
+/// were changed on disk.
+///
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hw {
+    ///
+    /// @brief Watches files for changes without blocking.
+    ///
+    /// Directories are watched instead of the files themselves, so files
+    /// that editors replace instead of overwriting are noticed too.
+    ///
+    /// @note Only implemented on linux(inotify), elsewhere nothing is ever
+    ///       reported as changed.
+    ///
+    class file_watcher
+    {
+      private:
+        int m_fd{-1};
+        ///
+        /// Watch descriptor to the absolute path of the directory.
+        ///
+        std::map<int, std::string> m_directories{};
+
+      public:
+        file_watcher();
+        file_watcher(file_watcher const&) = delete;
+        ~file_watcher() noexcept;
+
+        file_watcher& operator=(file_watcher const&) = delete;
+
+        ///
+        /// @brief Starts reporting changes of @ref t_path.
+        ///
+        /// @returns The absolute path changes of @ref t_path will be
+        ///          reported as, empty if it can't be watched.
+        ///
+        std::string watch(std::string const& t_path);
+        ///
+        /// @brief Adds the absolute paths of the files that changed since
+        ///        the last call to @ref t_changed, each at most once.
+        ///
+        void poll(std::vector<std::string>& t_changed);
+    };
+} // namespace hw
+
+#endif // !FILE_WATCHER_HPP
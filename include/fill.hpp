@@ -0,0 +1,162 @@
+#pragma once
+#ifndef FILL_HPP
+#define FILL_HPP
+
+///
+/// @file fill.hpp
+/// This file contains colors that change across a shape(gradients) and the
+/// meshes shapes are split into so the renderer can blend them.
+///
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "color.hpp"
+#include "vec2.hpp"
+
+namespace hw {
+    ///
+    /// @brief What color every position inside a shape gets.
+    ///
+    /// Positions are the ones shapes are given in, before any transform,
+    /// so the colors move and turn with the shape.
+    ///
+    class fill_style
+    {
+      public:
+        enum class kind : std::uint8_t
+        {
+            ///
+            /// Nothing set, shapes use their own color.
+            ///
+            flat,
+            linear,
+            radial,
+            function
+        };
+
+      private:
+        kind m_type{kind::flat};
+        hw::vec2f m_start{0.0f, 0.0f};
+        hw::vec2f m_end{0.0f, 0.0f};
+        float m_radius{0.0f};
+        hw::color m_from{};
+        hw::color m_to{};
+        std::function<hw::color(hw::vec2f const&)> m_function{};
+
+        ///
+        /// @brief How far along from @ref m_from to @ref m_to
+        ///        @ref t_pos is, not clamped.
+        ///
+        float amount(hw::vec2f const& t_pos) const noexcept;
+
+      public:
+        fill_style() = default;
+
+        ///
+        /// @brief @ref t_from at @ref t_start blending into @ref t_to at
+        ///        @ref t_end.
+        ///
+        /// Colors stay the same along lines at right angles to start-end,
+        /// and past both ends.
+        ///
+        static fill_style linear(hw::vec2f const& t_start,
+                                 hw::color const& t_from,
+                                 hw::vec2f const& t_end,
+                                 hw::color const& t_to);
+        ///
+        /// @brief @ref t_inner at @ref t_center blending into
+        ///        @ref t_outer @ref t_radius away from it and past that.
+        ///
+        static fill_style radial(hw::vec2f const& t_center,
+                                 float const t_radius,
+                                 hw::color const& t_inner,
+                                 hw::color const& t_outer);
+        ///
+        /// @brief Colors from @ref t_function, which is only called every
+        ///        few pixels on shapes, the colors in between are blended.
+        ///
+        static fill_style function(
+            std::function<hw::color(hw::vec2f const&)> t_function);
+
+        hw::color at(hw::vec2f const& t_pos) const;
+        ///
+        /// @brief @ref at for each of @ref t_points.
+        ///
+        void colors(hw::vec2f const* t_points, std::size_t const t_count,
+                    hw::color* t_out) const;
+
+        ///
+        /// @brief @ref t_count ARGB8888 pixels(see @ref to_argb) of the
+        ///        row at @ref t_y, starting at @ref t_x and one apart.
+        ///
+        /// Gradients step along the row 4 pixels at a time. Pass pixel
+        /// centers(x + 0.5) for the colors of whole pixels.
+        ///
+        void span(float const t_x, float const t_y, std::uint32_t* t_out,
+                  std::size_t const t_count) const;
+        ///
+        /// @brief The one pixel at a time version of @ref span, exposed so
+        ///        the vectorized one can be checked against it.
+        ///
+        void span_scalar(float const t_x, float const t_y,
+                         std::uint32_t* t_out,
+                         std::size_t const t_count) const;
+
+        ///
+        /// @brief How far apart mesh points over the box from @ref t_min
+        ///        to @ref t_max must be for blending between them to look
+        ///        like the real colors.
+        ///
+        /// Huge when blending is exact, eg. for a linear gradient covering
+        /// the whole box, which then needs no points but its corners.
+        ///
+        float spacing(hw::vec2f const& t_min,
+                      hw::vec2f const& t_max) const noexcept;
+
+        inline kind type() const noexcept
+        {
+            return m_type;
+        }
+        inline bool flat() const noexcept
+        {
+            return m_type == kind::flat;
+        }
+    };
+
+    ///
+    /// @brief Appends a grid of points over the rectangle at @ref t_pos,
+    ///        at most @ref t_spacing apart, and the triangles covering it
+    ///        (3 indices into @ref t_points each).
+    ///
+    void mesh_rectangle(hw::vec2f const& t_pos, hw::vec2f const& t_dim,
+                        float const t_spacing,
+                        std::vector<hw::vec2f>& t_points,
+                        std::vector<int>& t_triangles);
+    ///
+    /// @brief Appends rings of points around @ref t_center at most
+    ///        @ref t_spacing apart and the triangles between them.
+    ///
+    /// @param[in] t_tolerance How far the outer edge may be from the
+    ///                        circle, see @ref curve_tolerance.
+    ///
+    void mesh_circle(hw::vec2f const& t_center, float const t_radius,
+                     float const t_spacing, float const t_tolerance,
+                     std::vector<hw::vec2f>& t_points,
+                     std::vector<int>& t_triangles);
+    ///
+    /// @brief Appends the triangles @ref t_corner_triangles of
+    ///        @ref t_corners, each split into smaller ones with sides at
+    ///        most about @ref t_spacing long.
+    ///
+    void mesh_triangles(hw::vec2f const* t_corners,
+                        int const* t_corner_triangles,
+                        std::size_t const t_index_count,
+                        float const t_spacing,
+                        std::vector<hw::vec2f>& t_points,
+                        std::vector<int>& t_triangles);
+} // namespace hw
+
+#endif // !FILL_HPP
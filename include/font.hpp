@@ -0,0 +1,132 @@
+#pragma once
+#ifndef FONT_HPP
+#define FONT_HPP
+
+///
+/// @file font.hpp
+/// This file contains bitmap fonts: every glyph is a cell of the same size
+/// in one texture, so a whole string is drawn with one call.
+///
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SDL2/SDL.h"
+
+#include "canvas.hpp"
+#include "color.hpp"
+#include "texture.hpp"
+#include "vec2.hpp"
+
+namespace hw {
+    ///
+    /// @brief Texture coordinates of one glyph.
+    ///
+    struct glyph_uv
+    {
+        float u0;
+        float v0;
+        float u1;
+        float v1;
+    };
+
+    ///
+    /// @brief A font whose glyphs are cells of the same size laid out in a
+    ///        grid, left to right and then top to bottom.
+    ///
+    /// Glyphs are white so the color text is drawn with is multiplied
+    /// into them.
+    ///
+    class font
+    {
+      private:
+        hw::vec2 m_glyph{};
+        char m_first{' '};
+        ///
+        /// How many glyphs the built in font has, 0 for images where it is
+        /// only known once the image is loaded.
+        ///
+        int m_count{0};
+        ///
+        /// The built in font, rasterized once when it is created and
+        /// uploaded again only when the renderer changes.
+        ///
+        std::shared_ptr<hw::canvas_texture> m_canvas{};
+        std::vector<std::uint32_t> m_pixels{};
+        ///
+        /// Fonts loaded from an image, see @ref hw::load_texture.
+        ///
+        std::shared_ptr<hw::texture> m_texture{};
+
+        font() = default;
+
+      public:
+        font(font const&) = delete;
+        ~font() noexcept = default;
+
+        font& operator=(font const&) = delete;
+
+        ///
+        /// @brief The 8x8 font for ASCII every program has, shared by all
+        ///        of them.
+        ///
+        static std::shared_ptr<hw::font> const& builtin();
+        ///
+        /// @brief A font from an image whose glyphs are
+        ///        @ref t_glyph_width by @ref t_glyph_height cells, the
+        ///        first one being @ref t_first.
+        ///
+        /// The image is loaded in the background like every other one,
+        /// text drawn before that does not show up.
+        ///
+        static std::shared_ptr<hw::font>
+        from_image(std::string const& t_path, int const t_glyph_width,
+                   int const t_glyph_height, char const t_first = ' ',
+                   hw::color const& t_color_key = hw::color{0, 0, 0, 0});
+
+        inline hw::vec2 const& glyph_size() const noexcept
+        {
+            return m_glyph;
+        }
+
+        ///
+        /// @brief Places a quad for every visible character of
+        ///        @ref t_text, starting at @ref t_pos.
+        ///
+        /// '\n' starts a new line. Characters the font does not have are
+        /// drawn as '?'.
+        ///
+        /// @param[in] t_scale How many pixels every pixel of a glyph
+        ///                    covers.
+        /// @param[out] t_corners Replaced with 4 corners per glyph,
+        ///                       clockwise from the top left one.
+        /// @param[out] t_glyphs Replaced with the character of each quad.
+        ///
+        void layout(std::string const& t_text, hw::vec2 const& t_pos,
+                    int const t_scale, std::vector<hw::vec2f>& t_corners,
+                    std::string& t_glyphs) const;
+        ///
+        /// @brief How big @ref t_text is once laid out.
+        ///
+        hw::vec2 measure(std::string const& t_text,
+                         int const t_scale) const noexcept;
+
+        ///
+        /// @brief Uploads the glyphs if needed and returns their texture.
+        ///
+        /// @attention Must be called from the thread that owns
+        ///            @ref t_renderer.
+        ///
+        /// @retval nullptr if there is nothing to draw yet.
+        ///
+        SDL_Texture* get(SDL_Renderer* t_renderer);
+        ///
+        /// @brief Where @ref t_glyph is in the texture @ref get returned.
+        ///
+        hw::glyph_uv uv(char const t_glyph) const noexcept;
+    };
+} // namespace hw
+
+#endif // !FONT_HPP
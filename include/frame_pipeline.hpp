@@ -0,0 +1,99 @@
+#pragma once
+#ifndef FRAME_PIPELINE_HPP
+#define FRAME_PIPELINE_HPP
+
+///
+/// @file frame_pipeline.hpp
+/// This file contains the declaration of the object that hands recorded
+/// frames to the renderer, optionally on a separate thread.
+///
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "draw_list.hpp"
+#include "window.hpp"
+
+namespace hw {
+    ///
+    /// @brief Decides where and when recorded @ref draw_list objects get
+    ///        drawn.
+    ///
+    /// With a latency of 0 every submitted list is drawn and presented
+    /// right away on the calling thread, which is how the library always
+    /// worked.
+    ///
+    /// With a latency of N > 0 a render thread is started that owns the
+    /// renderer, and N + 1 lists are cycled between the two threads. The
+    /// main thread can be up to N frames ahead of what is on the screen, so
+    /// simulating a frame overlaps with rasterizing and presenting the
+    /// previous one(s). 1 is double buffering, 2 is triple buffering.
+    ///
+    /// @attention With a latency > 0 the renderer is used from a thread
+    ///            other than the main one. This works with the Direct3D and
+    ///            OpenGL backends on Windows and Linux but not on macOS.
+    ///
+    class frame_pipeline
+    {
+      private:
+        hw::window& m_window;
+        std::vector<hw::draw_list> m_lists{};
+
+        std::size_t m_recording{0};
+        std::size_t m_next_to_render{0};
+        ///
+        /// Submitted but not picked up by the render thread yet.
+        ///
+        std::size_t m_pending{0};
+        ///
+        /// Submitted but not presented yet.
+        ///
+        std::size_t m_in_flight{0};
+        bool m_stop{false};
+
+        std::mutex m_mutex{};
+        std::condition_variable m_submitted{};
+        std::condition_variable m_presented{};
+        std::thread m_thread{};
+
+        void run();
+
+      public:
+        frame_pipeline(hw::window& t_window, int const t_latency);
+        frame_pipeline(frame_pipeline const&) = delete;
+        ~frame_pipeline();
+
+        frame_pipeline& operator=(frame_pipeline const&) = delete;
+
+        ///
+        /// @brief The list the current frame should be recorded into.
+        ///
+        inline hw::draw_list& record() noexcept
+        {
+            return m_lists[m_recording];
+        }
+
+        ///
+        /// @brief Hands the recorded list over to be drawn and presented.
+        ///
+        /// Blocks while the render thread is already @ref latency frames
+        /// behind. The next call to @ref record returns an empty list.
+        ///
+        void submit();
+
+        ///
+        /// @brief Blocks until everything submitted is on the screen.
+        ///
+        void finish();
+
+        inline std::size_t latency() const noexcept
+        {
+            return m_lists.size() - 1;
+        }
+    };
+} // namespace hw
+
+#endif // !FRAME_PIPELINE_HPP
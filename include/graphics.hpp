@@ -136,11 +136,60 @@ inline int height()
 ///
 /// @brief Checks if @ref t_key was pressed.
 ///
+/// Holding the key down makes this true again every time the key repeats,
+/// use @ref key_held for smooth movement.
+///
 inline bool key(int const t_key)
 {
     return get_global_window()->was_key_pressed(t_key);
 }
 
+///
+/// @brief Checks if @ref t_key is being held down.
+///
+/// True every frame for as long as the key is down, so multiple keys(eg.
+/// KEY_UP and KEY_LEFT) can be checked at the same time.
+///
+inline bool key_held(int const t_key)
+{
+    return get_global_window()->is_key_held(t_key);
+}
+
+///
+/// @brief Checks if @ref t_key was released.
+///
+inline bool key_released(int const t_key)
+{
+    return get_global_window()->was_key_released(t_key);
+}
+
+///
+/// @brief Where the mouse is inside the window.
+///
+inline int mouse_x()
+{
+    return get_global_window()->mouse_position().x;
+}
+
+inline int mouse_y()
+{
+    return get_global_window()->mouse_position().y;
+}
+
+///
+/// @brief Checks if @ref t_button(MOUSE_LEFT, MOUSE_RIGHT or MOUSE_MIDDLE)
+///        was clicked.
+///
+inline bool mouse_pressed(int const t_button = MOUSE_LEFT)
+{
+    return get_global_window()->was_button_pressed(t_button);
+}
+
+inline bool mouse_held(int const t_button = MOUSE_LEFT)
+{
+    return get_global_window()->is_button_held(t_button);
+}
+
 ///
 /// @brief Verifica data @ref t_tasta a fost apasata.
 ///
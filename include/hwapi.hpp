@@ -22,12 +22,26 @@
 #ifndef HWAPI_HPP
 #define HWAPI_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "affine.hpp"
+#include "canvas.hpp"
+#include "collision.hpp"
 #include "color.hpp"
+#include "curve.hpp"
+#include "draw_list.hpp"
+#include "fill.hpp"
+#include "font.hpp"
+#include "particles.hpp"
+#include "profiling.hpp"
+#include "texture.hpp"
+#include "tile_map.hpp"
 #include "vec2.hpp"
 #include "window.hpp"
 
@@ -37,6 +51,7 @@
 ///
 namespace dummy_api {
     class Shape;
+    class Group;
 
     ///
     /// @brief Accesses the vector of Shapes.
@@ -110,6 +125,141 @@ namespace dummy_api {
     /// @brief Gets the background color of the global window.
     ///
     hw::color get_background_color() noexcept;
+    ///
+    /// @brief Lets the simulation run ahead of what is on the screen.
+    ///
+    /// By default(0) every frame is drawn and presented before the next call
+    /// to the function given to @ref draw. With 1 or more frames of latency
+    /// a separate thread draws and presents the previous frame while the
+    /// next one is being simulated, which can double the frame rate of
+    /// programs that do a lot of work every frame. The price is that what
+    /// is on the screen is that many frames behind. See
+    /// @ref hw::frame_pipeline.
+    ///
+    /// @attention Has to be called before @ref draw.
+    ///
+    void set_frame_latency(int const t_frames) noexcept;
+    ///
+    /// @retval 0 unless @ref set_frame_latency was called.
+    ///
+    int get_frame_latency() noexcept;
+    ///
+    /// @brief Makes input reach the screen sooner.
+    ///
+    /// Normally events are handled right after a frame is presented and the
+    /// next frame is simulated right away, so by the time it is on the
+    /// screen the input it reacted to is a whole refresh old. In low
+    /// latency mode events are handled right before the function given to
+    /// @ref draw is called and, if @ref t_wait is not 0, the loop first
+    /// sleeps for that fraction of the refresh interval, so input that
+    /// arrives in the meantime still makes it into the next frame.
+    ///
+    /// How long input took to reach the screen is measured either way, see
+    /// @ref hw::get_input_latency.
+    ///
+    /// @param[in] t_enabled Turns the mode on or off.
+    /// @param[in] t_wait Between 0 and 0.9, a frame that takes longer to
+    ///                   simulate than what is left of the refresh interval
+    ///                   will miss it.
+    ///
+    /// @attention Meant for a frame latency of 0, see
+    ///            @ref set_frame_latency.
+    ///
+    void set_low_latency(bool const t_enabled,
+                         double const t_wait = 0.0) noexcept;
+    bool get_low_latency() noexcept;
+    ///
+    /// @brief Gets the list the current frame is being recorded into.
+    ///
+    /// @retval nullptr outside of @ref draw.
+    ///
+    hw::draw_list* get_draw_list() noexcept;
+
+    ///
+    /// @brief Starts decoding an image file in the background.
+    ///
+    /// Images are decoded by worker threads and appear the first frame after
+    /// they are ready, until then they are not drawn. Preloading them, and
+    /// calling @ref wait_all before @ref draw, makes sure they are there
+    /// from the first frame on. The file stays loaded until the program
+    /// ends.
+    ///
+    /// @param[in] t_path Same as the path given to @ref Image.
+    /// @param[in] t_color_key Same as the one given to
+    ///                        @ref Image::set_color_key.
+    ///
+    void preload(std::string const& t_path,
+                 hw::color const& t_color_key = hw::color{0, 0, 0});
+    ///
+    /// @brief Blocks until every image that started loading is decoded.
+    ///
+    void wait_all();
+    ///
+    /// @brief Reloads images whose files change while the program runs.
+    ///
+    /// Handy when editing pictures: save the file and the new version
+    /// shows up a moment later, without a hitch. Only works on linux.
+    ///
+    void set_hot_reload(bool const t_enabled);
+    ///
+    /// @brief Limits how much video memory images may take.
+    ///
+    /// Images that were not drawn for the longest time are unloaded when
+    /// there are more, and loaded again in the background when they are
+    /// drawn again. Useful for slideshows and galleries with many big
+    /// pictures. The numbers are printed when the window is closed.
+    ///
+    /// @param[in] t_megabytes 0 means no limit, which is the default.
+    ///
+    void set_texture_budget(std::size_t const t_megabytes);
+    ///
+    /// @brief How shapes drawn from now on are combined with what is under
+    ///        them, see @ref hw::blend_mode.
+    ///
+    /// Can be called from the drawing loop to change it for part of a
+    /// frame, the next frame starts with the mode last set. Shapes kept in
+    /// @ref get_shapes are drawn after the loop, with the mode it ended
+    /// with. @ref hw::blend_mode::alpha is the default.
+    ///
+    void set_blend_mode(hw::blend_mode const t_mode);
+    hw::blend_mode get_blend_mode() noexcept;
+    ///
+    /// @brief Moves, rotates and scales everything drawn until the
+    ///        matching @ref pop_transform, before the transforms already
+    ///        pushed.
+    ///
+    /// Only works inside the drawing loop, transforms left pushed when it
+    /// ends are dropped. For shapes that should always move together use a
+    /// @ref Group.
+    /// @code
+    /// return draw(WITH{
+    ///     angle += 90 * elapsed_time;
+    ///     push_transform(hw::affine2::translation(hw::vec2f{320, 240}) *
+    ///                    hw::affine2::rotation(angle));
+    ///     rectangle(-50, -50, 100, 100); // spins around the center
+    ///     pop_transform();
+    /// });
+    /// @endcode
+    ///
+    void push_transform(hw::affine2 const& t_transform);
+    ///
+    /// @brief Goes back to the transform before the last
+    ///        @ref push_transform.
+    ///
+    void pop_transform();
+    ///
+    /// @brief Loads images from a pack made with the hw_pack tool.
+    ///
+    /// Images in the pack show up without any decoding, which makes
+    /// starting programs with many images a lot faster. Pack the files with
+    /// the same paths the program uses, eg.
+    /// `hw_pack sprites.hwpack ../media/Triangle.png ../media/Line.png`.
+    ///
+    /// @attention Call before creating the images it should be used for.
+    ///
+    /// @retval false if the pack could not be opened.
+    ///
+    bool load_pack(std::string const& t_path);
 
     ///
     /// @brief Draws all the shapes currently requested.
@@ -134,6 +284,24 @@ namespace dummy_api {
     ///
     int draw(std::function<void(double)> t_call = [](double) -> void {});
     ///
+    /// @brief Renders a few frames offscreen and saves the last one as a PNG.
+    ///
+    /// Works exactly like @ref draw except no window is shown, no events
+    /// are handled and every frame gets a fixed elapsed time of 1/60
+    /// seconds. Rasterization goes through SDL's software renderer so the
+    /// result can be compared pixel by pixel against a reference image.
+    ///
+    /// @param[in] t_path Where to save the resulting image.
+    /// @param[in] t_call Same as for @ref draw.
+    /// @param[in] t_frames How many frames to render before saving.
+    ///
+    /// @retval true if the image was saved.
+    ///
+    bool draw_to_file(std::string const& t_path,
+                      std::function<void(double)> t_call =
+                          [](double) -> void {},
+                      int const t_frames = 1);
+    ///
     /// @brief Draws a point with given position and color.
     ///
     void point(const hw::vec2& t_pos, const hw::color& t_color = hw::color{});
@@ -265,6 +433,115 @@ namespace dummy_api {
     ///
     void outline_circle(const int t_x, const int t_y, const int t_radius,
                         const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Fills the polygon with corners @ref t_points, given in order
+    ///        around it.
+    ///
+    /// Any polygon works as long as its edges do not cross each other,
+    /// eg. the outline of a country on a map. Polygons drawn every frame
+    /// are split into triangles every frame, a @ref Polygon only does it
+    /// again when its corners change.
+    ///
+    void polygon(const std::vector<hw::vec2>& t_points,
+                 const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Draws the edges of the polygon with corners @ref t_points,
+    ///        the last one is joined with the first.
+    ///
+    void outline_polygon(const std::vector<hw::vec2>& t_points,
+                         const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Draws a quadratic Bezier curve from @ref t_start to
+    ///        @ref t_end, pulled towards @ref t_control.
+    ///
+    /// Curves are drawn with as many lines as they need to look smooth,
+    /// more where they bend and only one where they are straight.
+    ///
+    void bezier(const hw::vec2& t_start, const hw::vec2& t_control,
+                const hw::vec2& t_end, const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Draws a cubic Bezier curve from @ref t_start to @ref t_end,
+    ///        leaving towards @ref t_first and arriving from
+    ///        @ref t_second.
+    ///
+    void bezier(const hw::vec2& t_start, const hw::vec2& t_first,
+                const hw::vec2& t_second, const hw::vec2& t_end,
+                const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Fills what is between a quadratic Bezier curve and the
+    ///        straight line joining its ends.
+    ///
+    void filled_bezier(const hw::vec2& t_start, const hw::vec2& t_control,
+                       const hw::vec2& t_end,
+                       const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Same as above for a cubic curve.
+    ///
+    void filled_bezier(const hw::vec2& t_start, const hw::vec2& t_first,
+                       const hw::vec2& t_second, const hw::vec2& t_end,
+                       const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Draws part of the outline of a circle.
+    ///
+    /// @param[in] t_start_angle Degrees, clockwise from the right of the
+    ///                          center.
+    /// @param[in] t_end_angle Degrees, the arc goes clockwise when bigger
+    ///                        than @ref t_start_angle.
+    ///
+    void arc(const hw::vec2& t_center, const int t_radius,
+             const float t_start_angle, const float t_end_angle,
+             const hw::color& t_color = hw::color{});
+    ///
+    /// Same as:
+    /// @code{.cpp}
+    /// arc(hw::vec2{ t_x, t_y }, t_radius, t_start_angle, t_end_angle,
+    ///     t_color);
+    /// @endcode
+    ///
+    void arc(const int t_x, const int t_y, const int t_radius,
+             const float t_start_angle, const float t_end_angle,
+             const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Fills the slice of a circle between 2 angles, like in a pie
+    ///        chart. Parameters have the same meaning as in @ref arc.
+    ///
+    void filled_arc(const hw::vec2& t_center, const int t_radius,
+                    const float t_start_angle, const float t_end_angle,
+                    const hw::color& t_color = hw::color{});
+    void filled_arc(const int t_x, const int t_y, const int t_radius,
+                    const float t_start_angle, const float t_end_angle,
+                    const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Writes @ref t_text with its top left corner at @ref t_pos,
+    ///        8 pixels per character.
+    ///
+    /// '\n' starts a new line. The whole string is drawn with one call, see
+    /// @ref Text to also keep where its characters go between frames.
+    ///
+    void text(const hw::vec2& t_pos, const std::string& t_text,
+              const hw::color& t_color = hw::color{});
+    ///
+    /// Same as:
+    /// @code{.cpp}
+    /// text(hw::vec2{ t_x, t_y }, t_text, t_color);
+    /// @endcode
+    ///
+    void text(const int t_x, const int t_y, const std::string& t_text,
+              const hw::color& t_color = hw::color{});
+    ///
+    /// @brief Loads a font from an image with all of its glyphs in a grid,
+    ///        to use with @ref Text::set_font.
+    ///
+    /// @param[in] t_glyph_width Width of every cell of the grid.
+    /// @param[in] t_glyph_height Height of every cell of the grid.
+    /// @param[in] t_first The character in the top left cell, the others
+    ///                    follow in ASCII order left to right, top to
+    ///                    bottom.
+    ///
+    std::shared_ptr<hw::font>
+    load_font(const std::string& t_path, const int t_glyph_width,
+              const int t_glyph_height, const char t_first = ' ',
+              const hw::color& t_color_key = hw::color{0, 0, 0, 0});
 
     ///
     /// @brief Every object that has information about a primitive is
@@ -292,6 +569,7 @@ namespace dummy_api {
     {
       private:
         bool m_hidden{false};
+        Group* m_group{nullptr};
 
       protected:
         Shape();
@@ -306,7 +584,11 @@ namespace dummy_api {
         hw::vec2 get_previous_color() const noexcept;
 
       public:
-        virtual ~Shape() noexcept = default;
+        ///
+        /// @brief Removes the shape from @ref get_shapes, so it can go away
+        ///        before the program ends.
+        ///
+        virtual ~Shape() noexcept;
 
         virtual void draw() = 0;
         void draw_shape() noexcept;
@@ -317,6 +599,66 @@ namespace dummy_api {
         {
             return m_hidden;
         }
+
+        ///
+        /// @brief Draws the shape with the transform of @ref t_group,
+        ///        nullptr draws it as it is.
+        ///
+        inline void set_group(Group* t_group) noexcept
+        {
+            m_group = t_group;
+        }
+        inline Group* group() const noexcept
+        {
+            return m_group;
+        }
+    };
+
+    ///
+    /// @brief A transform shared by several shapes, eg. everything a camera
+    ///        looks at.
+    ///
+    /// Panning, rotating or zooming the group moves all of its shapes with
+    /// one change instead of changing every one of them.
+    /// @code
+    /// Group world{};
+    /// Rectangle wall{100, 100, 40, 200};
+    /// Image player{"player.png", 300, 200, 32, 32};
+    /// world.add(wall);
+    /// world.add(player);
+    ///
+    /// return draw(WITH{
+    ///     camera_x += 100 * elapsed_time;
+    ///     world.transform() =
+    ///         hw::affine2::translation(hw::vec2f{-camera_x, 0});
+    /// });
+    /// @endcode
+    ///
+    /// @attention Must outlive the shapes added to it.
+    ///
+    class Group
+    {
+      private:
+        hw::affine2 m_transform{};
+
+      public:
+        Group() = default;
+        explicit Group(hw::affine2 const& t_transform);
+
+        void add(Shape& t_shape) noexcept;
+        ///
+        /// @brief Draws @ref t_shape as it is again.
+        ///
+        void remove(Shape& t_shape) noexcept;
+
+        inline hw::affine2& transform() noexcept
+        {
+            return m_transform;
+        }
+        inline hw::affine2 const& transform() const noexcept
+        {
+            return m_transform;
+        }
     };
 
     ///
@@ -446,6 +788,7 @@ namespace dummy_api {
         hw::vec2 m_second{};
         hw::vec2 m_third{};
         hw::color m_color{};
+        hw::fill_style m_fill{};
 
       public:
         Triangle() = default;
@@ -497,6 +840,20 @@ namespace dummy_api {
             return m_color;
         }
 
+        ///
+        /// @brief Colors across the triangle, eg.
+        ///        @ref hw::fill_style::linear. Replaces @ref color unless
+        ///        flat, which it is by default.
+        ///
+        inline hw::fill_style& fill()
+        {
+            return m_fill;
+        }
+        inline const hw::fill_style& fill() const
+        {
+            return m_fill;
+        }
+
         Triangle& operator=(const Triangle& t_other)
         {
             m_first = t_other.first();
@@ -605,6 +962,7 @@ namespace dummy_api {
         hw::vec2 m_pos{};
         hw::vec2 m_dimensions{};
         hw::color m_color{};
+        hw::fill_style m_fill{};
 
       public:
         Rectangle() = default;
@@ -645,6 +1003,19 @@ namespace dummy_api {
             return m_color;
         }
 
+        ///
+        /// @brief Colors across the rectangle, used instead of
+        ///        @ref color when not flat.
+        ///
+        inline hw::fill_style& fill()
+        {
+            return m_fill;
+        }
+        inline const hw::fill_style& fill() const
+        {
+            return m_fill;
+        }
+
         Rectangle& operator=(const Rectangle& t_other)
         {
             m_pos = t_other.pos();
@@ -739,6 +1110,7 @@ namespace dummy_api {
         hw::vec2 m_pos{};
         int m_radius;
         hw::color m_color{};
+        hw::fill_style m_fill{};
 
       public:
         Circle() = default;
@@ -779,6 +1151,19 @@ namespace dummy_api {
             return m_color;
         }
 
+        ///
+        /// @brief Colors across the circle, used instead of @ref color
+        ///        when not flat.
+        ///
+        inline hw::fill_style& fill()
+        {
+            return m_fill;
+        }
+        inline const hw::fill_style& fill() const
+        {
+            return m_fill;
+        }
+
         Circle& operator=(const Circle& t_other)
         {
             m_pos = t_other.pos();
@@ -864,85 +1249,1067 @@ namespace dummy_api {
     };
 
     ///
-    /// @brief Describes an @ref Image object.
+    /// @brief Describes a @ref Polygon object.
     ///
-    class Image : public Shape
+    /// The triangles it is filled with are kept until the corners are
+    /// changed through @ref points, so a complicated polygon costs about
+    /// as much to draw as a rectangle after the first frame.
+    ///
+    class Polygon final : public Shape
     {
-      private:
-        ///
-        /// If the user specifies a rectangle or calls @ref follow this will
-        /// just point to the specified rectangle. Otherwise it will create
-        /// a rect on the heap with specified dimensions.
-        ///
-        OutlineRectangle* m_rect{nullptr};
-        std::string m_path{};
-        bool m_created_here{false};
-        hw::color m_color_key{};
-        bool m_created_image{false};
+        std::vector<hw::vec2> m_points{};
+        hw::color m_color{};
+        hw::fill_style m_fill{};
+        std::vector<hw::vec2f> m_corners{};
+        std::vector<int> m_triangles{};
+        bool m_modified{true};
 
-        SDL_Texture* m_image{nullptr};
+      public:
+        Polygon() = default;
+        explicit Polygon(std::vector<hw::vec2> t_points,
+                         const hw::color& t_color = hw::color{});
+        ~Polygon() noexcept override = default;
 
-        ///
-        /// @attention MUST NOT be called before @ref draw_shapes.
-        ///
-        void create_image() noexcept;
-        void delete_rect_if_created_here() noexcept;
+        void draw() final;
 
-      public:
-        Image() = default;
-        ///
-        /// @param[in] t_path Where the image is located.
-        ///
-        /// When no rect is specified there will be one created in the center
-        /// of the screen with coordinates 100, 100.
-        ///
-        Image(std::string const t_path);
-        ///
-        /// @param[in] t_path Where the image is located.
-        /// @param[in] t_x X coordonate of the rect representing the image.
-        /// @param[in] t_y Y coordonate of the rect representing the image.
-        /// @param[in] t_width Width of the rect representing the image.
-        /// @param[in] t_height Height of the rect representing the image.
-        ///
-        Image(std::string const t_path, int const t_x, int const t_y,
-              int const t_width, int const t_height);
-        ///
-        /// @brief Same as @ref Rectangle parameters except t_path.
         ///
-        Image(std::string const t_path, hw::vec2 const& t_pos,
-              hw::vec2 const& t_dim);
+        /// @brief The corners, in order around the polygon.
         ///
-        /// @param[in] t_rect With this specified the image structure will
-        ///                   keep a pointer to the rect so whenever the rect
-        ///                   updates the image will also follow the rectangle.
+        /// The polygon is split into triangles again the next time it is
+        /// drawn.
         ///
-        Image(std::string const t_path, OutlineRectangle& t_rect);
-        ~Image() noexcept override;
+        inline std::vector<hw::vec2>& points() noexcept
+        {
+            m_modified = true;
+            return m_points;
+        }
+        inline const std::vector<hw::vec2>& points() const noexcept
+        {
+            return m_points;
+        }
+
+        inline hw::color& color()
+        {
+            return m_color;
+        }
+        inline const hw::color& color() const
+        {
+            return m_color;
+        }
 
         ///
-        /// @brief Specify where the image is located.
-        ///
-        /// @attention Calling inside drawing loop has no effect.
-        ///
-        void set_path(std::string const t_path);
+        /// @brief Colors across the polygon, used instead of @ref color
+        ///        when not flat.
         ///
-        /// @brief Ignore specified color
+        inline hw::fill_style& fill()
+        {
+            return m_fill;
+        }
+        inline const hw::fill_style& fill() const
+        {
+            return m_fill;
+        }
+    };
+
+    ///
+    /// @brief Describes an @ref OutlinePolygon object.
+    ///
+    class OutlinePolygon final : public Shape
+    {
+        std::vector<hw::vec2> m_points{};
+        hw::color m_color{};
+        std::vector<hw::vec2f> m_corners{};
+        bool m_modified{true};
+
+      public:
+        OutlinePolygon() = default;
+        explicit OutlinePolygon(std::vector<hw::vec2> t_points,
+                                const hw::color& t_color = hw::color{});
+        ~OutlinePolygon() noexcept override = default;
+
+        void draw() final;
+
+        inline std::vector<hw::vec2>& points() noexcept
+        {
+            m_modified = true;
+            return m_points;
+        }
+        inline const std::vector<hw::vec2>& points() const noexcept
+        {
+            return m_points;
+        }
+
+        inline hw::color& color()
+        {
+            return m_color;
+        }
+        inline const hw::color& color() const
+        {
+            return m_color;
+        }
+    };
+
+    ///
+    /// @brief Describes a @ref Bezier object, a quadratic(3 points) or
+    ///        cubic(4 points) curve.
+    ///
+    /// The lines it is drawn with are kept until its points change, or
+    /// until a transform scales it enough to need more of them.
+    ///
+    class Bezier final : public Shape
+    {
+        std::vector<hw::vec2> m_points{};
+        hw::color m_color{};
+        bool m_filled{false};
+        hw::flattened_curve m_curve{};
+
+      public:
+        Bezier() = default;
+        Bezier(const hw::vec2& t_start, const hw::vec2& t_control,
+               const hw::vec2& t_end, const hw::color& t_color = hw::color{});
+        Bezier(const hw::vec2& t_start, const hw::vec2& t_first,
+               const hw::vec2& t_second, const hw::vec2& t_end,
+               const hw::color& t_color = hw::color{});
+        ~Bezier() noexcept override = default;
+
+        void draw() final;
+
         ///
-        /// If you want to load a sprite and it's background color should not
-        /// be rendered specify it with this function.
+        /// @brief The start, the control points and the end. Nothing is
+        ///        drawn unless there are 3 or 4 of them.
         ///
-        /// @attention Can NOT be changed dynamically, meaning if you call this
-        ///            inside the drawing loop it will have no effect.
+        inline std::vector<hw::vec2>& points() noexcept
+        {
+            m_curve.tolerance = -1.0f;
+            return m_points;
+        }
+        inline const std::vector<hw::vec2>& points() const noexcept
+        {
+            return m_points;
+        }
+
         ///
-        void set_color_key(hw::color const& t_color) noexcept;
+        /// @brief Whether what is between the curve and the line joining
+        ///        its ends is filled, see @ref filled_bezier.
+        ///
+        inline void set_filled(bool const t_filled) noexcept
+        {
+            m_filled = t_filled;
+            m_curve.tolerance = -1.0f;
+        }
+        inline bool filled() const noexcept
+        {
+            return m_filled;
+        }
+
+        inline hw::color& color()
+        {
+            return m_color;
+        }
+        inline const hw::color& color() const
+        {
+            return m_color;
+        }
+    };
+
+    ///
+    /// @brief Describes an @ref Arc object, see @ref arc.
+    ///
+    class Arc final : public Shape
+    {
+        hw::vec2 m_center{};
+        int m_radius{0};
+        float m_start_angle{0.0f};
+        float m_end_angle{0.0f};
+        hw::color m_color{};
+        bool m_filled{false};
+        hw::flattened_curve m_curve{};
+
+      public:
+        Arc() = default;
+        Arc(const hw::vec2& t_center, const int t_radius,
+            const float t_start_angle, const float t_end_angle,
+            const hw::color& t_color = hw::color{});
+        Arc(const int t_x, const int t_y, const int t_radius,
+            const float t_start_angle, const float t_end_angle,
+            const hw::color& t_color = hw::color{});
+        ~Arc() noexcept override = default;
+
+        void draw() final;
+
+        inline hw::vec2& center() noexcept
+        {
+            m_curve.tolerance = -1.0f;
+            return m_center;
+        }
+        inline const hw::vec2& center() const noexcept
+        {
+            return m_center;
+        }
+
+        inline int& radius() noexcept
+        {
+            m_curve.tolerance = -1.0f;
+            return m_radius;
+        }
+        inline int radius() const noexcept
+        {
+            return m_radius;
+        }
+
+        inline float& start_angle() noexcept
+        {
+            m_curve.tolerance = -1.0f;
+            return m_start_angle;
+        }
+        inline float start_angle() const noexcept
+        {
+            return m_start_angle;
+        }
+
+        inline float& end_angle() noexcept
+        {
+            m_curve.tolerance = -1.0f;
+            return m_end_angle;
+        }
+        inline float end_angle() const noexcept
+        {
+            return m_end_angle;
+        }
+
+        ///
+        /// @brief Whether the slice is filled, see @ref filled_arc.
+        ///
+        inline void set_filled(bool const t_filled) noexcept
+        {
+            m_filled = t_filled;
+            m_curve.tolerance = -1.0f;
+        }
+        inline bool filled() const noexcept
+        {
+            return m_filled;
+        }
+
+        inline hw::color& color()
+        {
+            return m_color;
+        }
+        inline const hw::color& color() const
+        {
+            return m_color;
+        }
+    };
+
+    ///
+    /// @brief Describes a @ref Text object, see @ref text.
+    ///
+    /// Where its characters go is only worked out again when the string,
+    /// the position, the scale or the font change.
+    ///
+    class Text final : public Shape
+    {
+        hw::vec2 m_pos{};
+        std::string m_text{};
+        hw::color m_color{};
+        int m_scale{1};
+        std::shared_ptr<hw::font> m_font{hw::font::builtin()};
+
+        std::vector<hw::vec2f> m_corners{};
+        std::string m_glyphs{};
+        bool m_modified{true};
+
+      public:
+        Text() = default;
+        Text(const hw::vec2& t_pos, std::string t_text,
+             const hw::color& t_color = hw::color{});
+        Text(const int t_x, const int t_y, std::string t_text,
+             const hw::color& t_color = hw::color{});
+        ~Text() noexcept override = default;
+
+        void draw() final;
+
+        inline hw::vec2& pos() noexcept
+        {
+            m_modified = true;
+            return m_pos;
+        }
+        inline const hw::vec2& pos() const noexcept
+        {
+            return m_pos;
+        }
+
+        inline std::string& string() noexcept
+        {
+            m_modified = true;
+            return m_text;
+        }
+        inline const std::string& string() const noexcept
+        {
+            return m_text;
+        }
+
+        ///
+        /// @brief How many pixels every pixel of a glyph covers, 2 makes
+        ///        the built in font 16 pixels tall.
+        ///
+        inline void set_scale(int const t_scale) noexcept
+        {
+            m_scale = t_scale < 1 ? 1 : t_scale;
+            m_modified = true;
+        }
+        inline int scale() const noexcept
+        {
+            return m_scale;
+        }
+
+        ///
+        /// @brief Draws with @ref t_font instead of the built in font, see
+        ///        @ref load_font.
+        ///
+        inline void set_font(std::shared_ptr<hw::font> t_font) noexcept
+        {
+            m_font = std::move(t_font);
+            m_modified = true;
+        }
+        inline const std::shared_ptr<hw::font>& font() const noexcept
+        {
+            return m_font;
+        }
+
+        ///
+        /// @brief Width and height of the text on the screen, eg. to center
+        ///        it.
+        ///
+        inline hw::vec2 size() const noexcept
+        {
+            return m_font->measure(m_text, m_scale);
+        }
+
+        inline hw::color& color()
+        {
+            return m_color;
+        }
+        inline const hw::color& color() const
+        {
+            return m_color;
+        }
+    };
+
+    ///
+    /// @brief Describes an @ref Image object.
+    ///
+    class Image : public Shape
+    {
+      private:
+        ///
+        /// If the user specifies a rectangle or calls @ref follow this will
+        /// just point to the specified rectangle. Otherwise it will create
+        /// a rect on the heap with specified dimensions.
+        ///
+        OutlineRectangle* m_rect{nullptr};
+        std::string m_path{};
+        bool m_created_here{false};
+        hw::color m_color_key{};
+        bool m_created_image{false};
+
+        std::shared_ptr<hw::texture> m_image{};
+
+        ///
+        /// Parts of the file shown one after the other, all of them come
+        /// from the same texture. Empty shows the whole file.
+        ///
+        std::vector<SDL_Rect> m_frames{};
+        std::size_t m_frame{0};
+        ///
+        /// Seconds each frame is shown for, 0 means frames only change with
+        /// @ref set_frame.
+        ///
+        double m_frame_duration{0.0};
+        double m_frame_time{0.0};
+        bool m_loop{true};
+
+        void advance(double const t_elapsed_time) noexcept;
+
+        ///
+        /// @attention MUST NOT be called before @ref draw_shapes.
+        ///
+        void create_image() noexcept;
+        void delete_rect_if_created_here() noexcept;
+
+      public:
+        Image() = default;
+        ///
+        /// @param[in] t_path Where the image is located.
+        ///
+        /// When no rect is specified there will be one created in the center
+        /// of the screen with coordinates 100, 100.
+        ///
+        Image(std::string const t_path);
+        ///
+        /// @param[in] t_path Where the image is located.
+        /// @param[in] t_x X coordonate of the rect representing the image.
+        /// @param[in] t_y Y coordonate of the rect representing the image.
+        /// @param[in] t_width Width of the rect representing the image.
+        /// @param[in] t_height Height of the rect representing the image.
+        ///
+        Image(std::string const t_path, int const t_x, int const t_y,
+              int const t_width, int const t_height);
+        ///
+        /// @brief Same as @ref Rectangle parameters except t_path.
+        ///
+        Image(std::string const t_path, hw::vec2 const& t_pos,
+              hw::vec2 const& t_dim);
+        ///
+        /// @param[in] t_rect With this specified the image structure will
+        ///                   keep a pointer to the rect so whenever the rect
+        ///                   updates the image will also follow the rectangle.
+        ///
+        Image(std::string const t_path, OutlineRectangle& t_rect);
+        ~Image() noexcept override;
+
+        ///
+        /// @brief Specify where the image is located.
+        ///
+        /// Can be called inside the drawing loop to switch pictures, files
+        /// that were shown before are not loaded again as long as some
+        /// image still shows them(see @ref preload to keep them around).
+        /// The new picture shows up once it's decoded.
+        ///
+        void set_path(std::string const t_path);
+        ///
+        /// @brief Ignore specified color
+        ///
+        /// If you want to load a sprite and it's background color should not
+        /// be rendered specify it with this function. Like @ref set_path
+        /// this can be changed inside the drawing loop.
+        ///
+        void set_color_key(hw::color const& t_color);
         ///
         /// Whenever the rectangle changes position/dimensions, the image will
         /// also change accordingly.
         ///
         void follow(OutlineRectangle& t_rect);
 
+        ///
+        /// @brief Shows the file as a sprite sheet of @ref t_count frames of
+        ///        @ref t_frame_width by @ref t_frame_height pixels.
+        ///
+        /// Frames are read left to right, top to bottom, with
+        /// @ref t_columns frames on each row. Replaces the frames that were
+        /// set before and goes back to the first one.
+        ///
+        void set_frame_grid(int const t_frame_width, int const t_frame_height,
+                            int const t_columns, int const t_count);
+        ///
+        /// @brief Adds a frame at the end, for sprite sheets that aren't
+        ///        laid out in a grid.
+        ///
+        /// @param[in] t_x Left of the frame, in pixels of the file.
+        /// @param[in] t_y Top of the frame, in pixels of the file.
+        ///
+        void add_frame(int const t_x, int const t_y, int const t_width,
+                       int const t_height);
+        ///
+        /// @brief Shows the whole file again.
+        ///
+        void clear_frames() noexcept;
+        ///
+        /// @brief Jumps to a frame, wrapping around past the last one.
+        ///
+        void set_frame(std::size_t const t_frame) noexcept;
+        ///
+        /// @brief Changes frame every @ref t_seconds, 0 stops the animation
+        ///        on the current frame.
+        ///
+        /// @param[in] t_loop Start over after the last frame instead of
+        ///                   staying on it.
+        ///
+        void animate(double const t_seconds, bool const t_loop = true) noexcept;
+
+        inline std::size_t frame() const noexcept
+        {
+            return m_frame;
+        }
+        inline std::size_t frame_count() const noexcept
+        {
+            return m_frames.size();
+        }
+        ///
+        /// @brief Whether an animation that doesn't loop reached its last
+        ///        frame.
+        ///
+        bool finished() const noexcept;
+
+        void draw() final;
+    };
+
+    ///
+    /// @brief Draws one picture many times, all in one go.
+    ///
+    /// Much faster than many @ref Image objects when the same sprite is
+    /// needed hundreds or thousands of times(tiles, bullets, particles...).
+    /// Sprites can be added once before @ref draw, or cleared and added
+    /// again every frame:
+    /// @code
+    /// SpriteBatch bullets{"bullet.png"};
+    ///
+    /// return draw(WITH{
+    ///     bullets.clear();
+    ///     for(auto const& b : my_bullets) {
+    ///         bullets.add(b.x, b.y, 8, 8);
+    ///     }
+    /// });
+    /// @endcode
+    ///
+    class SpriteBatch final : public Shape
+    {
+      private:
+        std::shared_ptr<hw::texture> m_texture{};
+        std::vector<hw::sprite> m_sprites{};
+
+      public:
+        ///
+        /// @param[in] t_path Where the image is located.
+        /// @param[in] t_color_key Same as @ref Image::set_color_key.
+        ///
+        explicit SpriteBatch(std::string const& t_path,
+                             hw::color const& t_color_key = hw::color{0, 0, 0});
+        ~SpriteBatch() noexcept override = default;
+
+        void add(int const t_x, int const t_y, int const t_width,
+                 int const t_height);
+        ///
+        /// @param[in] t_tint Multiplied with the picture, WHITE shows it as
+        ///                   it is.
+        /// @param[in] t_angle Degrees, clockwise around the center.
+        ///
+        void add(hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                 hw::color const& t_tint = hw::color{255, 255, 255},
+                 float const t_angle = 0.0f);
+        ///
+        /// @brief Removes all sprites but keeps the memory around.
+        ///
+        void clear() noexcept;
+        void reserve(std::size_t const t_count);
+
+        ///
+        /// @brief Direct access, for moving sprites without adding them
+        ///        again.
+        ///
+        inline std::vector<hw::sprite>& sprites() noexcept
+        {
+            return m_sprites;
+        }
+        inline std::vector<hw::sprite> const& sprites() const noexcept
+        {
+            return m_sprites;
+        }
+
+        void draw() final;
+    };
+
+    ///
+    /// @brief Many small squares that move on their own and disappear
+    ///        after a while, like sparks, smoke or rain.
+    ///
+    /// Far cheaper than a @ref Circle per particle: they are kept in
+    /// arrays(see @ref hw::particles), moved 4 at a time and all drawn
+    /// with one call. They move every frame they are drawn, so hidden
+    /// particles wait.
+    /// @code
+    /// ParticleSystem sparks{};
+    /// sparks.set_gravity(hw::vec2f{0, 300});
+    ///
+    /// return draw(WITH{
+    ///     sparks.burst(50, hw::vec2f{hw::vec2{mouse_x(), mouse_y()}},
+    ///                  200.0f, AMBER, 1.5f);
+    /// });
+    /// @endcode
+    ///
+    class ParticleSystem final : public Shape
+    {
+      private:
+        hw::particles m_particles{};
+        hw::vec2f m_gravity{0.0f, 0.0f};
+        int m_size{2};
+        bool m_fade{true};
+        std::shared_ptr<hw::texture> m_texture{};
+        std::uint32_t m_random{2463534242u};
+
+        ///
+        /// Colors with the fading applied, kept to avoid allocating every
+        /// frame.
+        ///
+        std::vector<hw::color> m_colors{};
+
+        ///
+        /// @brief A number in [0, 1), not meant to be unpredictable.
+        ///
+        float random() noexcept;
+
+      public:
+        ParticleSystem() = default;
+        ///
+        /// @param[in] t_capacity How many particles there will be at most,
+        ///                       so adding them does not allocate.
+        ///
+        explicit ParticleSystem(std::size_t const t_capacity);
+        ~ParticleSystem() noexcept override = default;
+
+        ///
+        /// @brief Adds one particle at @ref t_pos that lives for
+        ///        @ref t_lifetime seconds.
+        ///
+        /// @param[in] t_velocity Pixels per second.
+        ///
+        void emit(hw::vec2f const& t_pos, hw::vec2f const& t_velocity,
+                  hw::color const& t_color, float const t_lifetime);
+        ///
+        /// @brief Adds @ref t_count particles at @ref t_pos going in every
+        ///        direction, with speeds up to @ref t_speed.
+        ///
+        void burst(std::size_t const t_count, hw::vec2f const& t_pos,
+                   float const t_speed, hw::color const& t_color,
+                   float const t_lifetime);
+        ///
+        /// @brief Removes every particle but keeps the memory around.
+        ///
+        void clear() noexcept;
+
+        ///
+        /// @brief Pixels per second squared added to the velocity of every
+        ///        particle.
+        ///
+        inline void set_gravity(hw::vec2f const& t_gravity) noexcept
+        {
+            m_gravity = t_gravity;
+        }
+        inline hw::vec2f const& gravity() const noexcept
+        {
+            return m_gravity;
+        }
+
+        ///
+        /// @brief Width and height of every particle, in pixels.
+        ///
+        inline void set_particle_size(int const t_size) noexcept
+        {
+            m_size = t_size;
+        }
+        inline int particle_size() const noexcept
+        {
+            return m_size;
+        }
+
+        ///
+        /// @brief Whether particles become more transparent as they get
+        ///        older, on by default.
+        ///
+        inline void set_fade(bool const t_fade) noexcept
+        {
+            m_fade = t_fade;
+        }
+
+        ///
+        /// @brief Draws every particle as the picture at @ref t_path tinted
+        ///        with its color instead of a plain square.
+        ///
+        void set_image(std::string const& t_path,
+                       hw::color const& t_color_key = hw::color{0, 0, 0, 0});
+
+        ///
+        /// @brief How many particles are alive.
+        ///
+        inline std::size_t count() const noexcept
+        {
+            return m_particles.size();
+        }
+        inline hw::particles const& particles() const noexcept
+        {
+            return m_particles;
+        }
+
+        void draw() final;
+    };
+
+    ///
+    /// @brief A grid of tiles, like the board of snake or minesweeper or the
+    ///        level of a platformer.
+    ///
+    /// Every tile is a number: the cell of the tileset image to show, or
+    /// the color of the palette to fill it with when there is no tileset.
+    /// Negative tiles are left empty.
+    ///
+    /// Tiles are drawn into textures @ref chunk_size tiles wide and tall
+    /// which are drawn again only when one of their tiles changes. A frame
+    /// costs one copy for every chunk on the screen, however many tiles
+    /// there are.
+    /// @code
+    /// TileMap board{40, 30, 16, 16};
+    /// board.set_palette({BLACK, GREEN, RED});
+    /// board.set_tile(10, 5, 2);
+    /// @endcode
+    ///
+    class TileMap final : public Shape
+    {
+      private:
+        int m_columns{0};
+        int m_rows{0};
+        hw::vec2 m_tile{};
+        hw::vec2 m_pos{0, 0};
+        std::vector<int> m_tiles{};
+
+        std::vector<hw::color> m_palette{};
+        std::shared_ptr<hw::texture> m_tileset{};
+
+        int m_chunk_columns{0};
+        int m_chunk_rows{0};
+        std::vector<std::shared_ptr<hw::tile_chunk>> m_chunks{};
+        ///
+        /// Chunks whose tiles changed since they were last drawn.
+        ///
+        std::vector<char> m_dirty{};
+        ///
+        /// The tiles of one chunk row by row, kept to avoid allocating.
+        ///
+        std::vector<int> m_chunk_tiles{};
+
+        void mark_all_dirty() noexcept;
+
+      public:
+        ///
+        /// How many tiles wide and tall chunks are.
+        ///
+        static constexpr int chunk_size{16};
+
+        TileMap() = default;
+        ///
+        /// @param[in] t_columns How many tiles wide the map is.
+        /// @param[in] t_rows How many tiles tall the map is.
+        /// @param[in] t_tile_width Width of a tile in pixels, also of a
+        ///                         cell of the tileset.
+        ///
+        /// Every tile starts empty.
+        ///
+        TileMap(int const t_columns, int const t_rows, int const t_tile_width,
+                int const t_tile_height);
+        ~TileMap() noexcept override = default;
+
+        ///
+        /// @brief Changes one tile, does nothing outside the map.
+        ///
+        void set_tile(int const t_column, int const t_row, int const t_tile);
+        ///
+        /// @retval -1 outside the map.
+        ///
+        int tile(int const t_column, int const t_row) const noexcept;
+        ///
+        /// @brief Sets every tile to @ref t_tile.
+        ///
+        void fill(int const t_tile);
+
+        ///
+        /// @brief The column and row of the tile under @ref t_pos, which
+        ///        may be outside the map.
+        ///
+        hw::vec2 cell_at(hw::vec2 const& t_pos) const noexcept;
+
+        ///
+        /// @brief Colors of the tiles, tile i is filled with
+        ///        @ref t_palette[i]. Only used without a tileset.
+        ///
+        void set_palette(std::vector<hw::color> t_palette);
+        ///
+        /// @brief Shows tile i as the i-th cell of the image at
+        ///        @ref t_path, counting left to right and top to bottom.
+        ///
+        void set_tileset(std::string const& t_path,
+                         hw::color const& t_color_key = hw::color{0, 0, 0, 0});
+
+        ///
+        /// @brief Top left corner of the map.
+        ///
+        inline hw::vec2& pos() noexcept
+        {
+            return m_pos;
+        }
+        inline const hw::vec2& pos() const noexcept
+        {
+            return m_pos;
+        }
+
+        inline int columns() const noexcept
+        {
+            return m_columns;
+        }
+        inline int rows() const noexcept
+        {
+            return m_rows;
+        }
+        inline const hw::vec2& tile_size() const noexcept
+        {
+            return m_tile;
+        }
+        ///
+        /// @brief Every tile, row by row.
+        ///
+        inline const std::vector<int>& tiles() const noexcept
+        {
+            return m_tiles;
+        }
+
+        ///
+        /// @brief Draws the chunks that are on the screen.
+        ///
         void draw() final;
     };
+
+    ///
+    /// @brief A rectangle of pixels the program writes to directly.
+    ///
+    /// Much faster than calling @ref point for every pixel when drawing
+    /// fractals, plots or anything computed pixel by pixel: the pixels are
+    /// sent to the GPU at most once per frame, and only in frames where
+    /// they changed.
+    ///
+    /// @code
+    /// Canvas canvas{0, 0, width(), height()};
+    /// canvas.parallel_fill([](int x, int y) {
+    ///     return (x / 8 + y / 8) % 2 ? WHITE : BLACK;
+    /// });
+    /// @endcode
+    ///
+    class Canvas final : public Shape
+    {
+      private:
+        hw::vec2 m_pos{};
+        hw::vec2 m_dim{};
+        int m_width{0};
+        int m_height{0};
+
+        ///
+        /// ARGB8888, see @ref hw::to_argb.
+        ///
+        std::vector<std::uint32_t> m_pixels{};
+        bool m_modified{true};
+
+        std::shared_ptr<hw::canvas_texture> m_texture{};
+
+      public:
+        ///
+        /// @brief A canvas of @ref t_width by @ref t_height pixels, each
+        ///        one covering a pixel of the window. All of them start
+        ///        transparent.
+        ///
+        Canvas(int const t_x, int const t_y, int const t_width,
+               int const t_height);
+        ///
+        /// @brief A canvas of @ref t_pixels_x by @ref t_pixels_y pixels
+        ///        stretched over the rectangle at @ref t_pos.
+        ///
+        Canvas(hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+               int const t_pixels_x, int const t_pixels_y);
+        ~Canvas() noexcept override = default;
+
+        ///
+        /// @brief Direct access to the pixels, row after row.
+        ///
+        /// Pixel (x, y) is at `pixels()[y * pitch() + x]`, in the format
+        /// given by @ref hw::to_argb. The canvas counts as changed, so write
+        /// through what this returns in the same frame, or call
+        /// @ref mark_modified after writing.
+        ///
+        std::uint32_t* pixels() noexcept;
+        inline std::uint32_t const* pixels() const noexcept
+        {
+            return m_pixels.data();
+        }
+        ///
+        /// @brief Same as @ref pixels, starting at row @ref t_y.
+        ///
+        std::uint32_t* row(int const t_y) noexcept;
+        ///
+        /// @brief Pixels from the start of a row to the start of the next.
+        ///
+        inline int pitch() const noexcept
+        {
+            return m_width;
+        }
+        inline int width() const noexcept
+        {
+            return m_width;
+        }
+        inline int height() const noexcept
+        {
+            return m_height;
+        }
+        inline void mark_modified() noexcept
+        {
+            m_modified = true;
+        }
+
+        ///
+        /// @brief Does nothing for positions outside the canvas.
+        ///
+        void set_pixel(int const t_x, int const t_y,
+                       hw::color const& t_color) noexcept;
+        hw::color get_pixel(int const t_x, int const t_y) const noexcept;
+        void fill(hw::color const& t_color) noexcept;
+        ///
+        /// @brief Sets every pixel to the color of @ref t_fill at its
+        ///        center, a row at a time.
+        ///
+        void fill(hw::fill_style const& t_fill);
+
+        ///
+        /// @brief Sets every pixel to @ref t_fn (x, y), which returns a
+        ///        @ref hw::color.
+        ///
+        /// Rows are split between all cores and this returns once all of
+        /// them are done.
+        ///
+        /// @attention @ref t_fn is called from several threads at the same
+        ///            time.
+        ///
+        template<typename F>
+        void parallel_fill(F const& t_fn);
+
+        inline hw::vec2& pos() noexcept
+        {
+            return m_pos;
+        }
+        inline hw::vec2 const& pos() const noexcept
+        {
+            return m_pos;
+        }
+        inline hw::vec2& dim() noexcept
+        {
+            return m_dim;
+        }
+        inline hw::vec2 const& dim() const noexcept
+        {
+            return m_dim;
+        }
+
+        void draw() final;
+    };
+
+    template<typename F>
+    void Canvas::parallel_fill(F const& t_fn)
+    {
+        hw::thread_pool& workers = hw::get_fill_workers();
+
+        // a few bands per thread so rows that are slower to compute(eg. the
+        // inside of a fractal) don't leave threads waiting
+        int const bands = static_cast<int>(workers.size()) * 4;
+        int const rows = std::max((m_height + bands - 1) / bands, 1);
+        std::uint32_t* pixels = this->pixels();
+        int const width = m_width;
+        int const height = m_height;
+
+        for(int first = 0; first < height; first += rows) {
+            int const last = std::min(first + rows, height);
+
+            workers.push([&t_fn, pixels, width, first, last] {
+                for(int y = first; y < last; ++y) {
+                    std::uint32_t* row =
+                        pixels + static_cast<std::size_t>(y) *
+                                     static_cast<std::size_t>(width);
+
+                    for(int x = 0; x < width; ++x) {
+                        row[x] = hw::to_argb(t_fn(x, y));
+                    }
+                }
+            });
+        }
+
+        workers.wait_idle();
+    }
+
+    ///
+    /// @brief Finds which of many shapes overlap, eg. which bullets hit
+    ///        which enemies.
+    ///
+    /// Works with @ref Point, @ref Line, @ref Triangle, @ref Rectangle and
+    /// @ref Circle, outlines collide like the filled shapes. Shapes are
+    /// read again on every @ref update so they can be moved freely, and
+    /// shapes that only touch or are hidden do not collide. Positions are
+    /// the ones given to the shapes, before the transform of their
+    /// @ref Group.
+    /// @code
+    /// Collisions collisions{};
+    /// collisions.add(player);
+    /// for(auto& enemy : enemies) {
+    ///     collisions.add(enemy);
+    /// }
+    ///
+    /// return draw(WITH{
+    ///     for(auto const& hit : collisions.update()) {
+    ///         if(hit.first == &player || hit.second == &player) {
+    ///             player.color() = RED;
+    ///         }
+    ///     }
+    /// });
+    /// @endcode
+    ///
+    /// Thousands of moving shapes take well under a millisecond, see
+    /// @ref hw::collision_world.
+    ///
+    /// @attention Shapes must be removed before they are destroyed.
+    ///
+    class Collisions
+    {
+      public:
+        using pair = std::pair<Shape*, Shape*>;
+
+      private:
+        using collider_fn = hw::collider (*)(Shape const&);
+
+        struct tracked
+        {
+            Shape* shape;
+            collider_fn collider;
+        };
+
+        hw::collision_world m_world{};
+        ///
+        /// Indexed by the ids @ref m_world gives out.
+        ///
+        std::vector<tracked> m_tracked{};
+        std::map<Shape const*, std::uint32_t> m_ids{};
+        std::vector<pair> m_pairs{};
+
+        void add(Shape& t_shape, collider_fn const t_collider);
+
+      public:
+        void add(Point& t_point);
+        void add(Line& t_line);
+        void add(Triangle& t_triangle);
+        void add(OutlineTriangle& t_triangle);
+        void add(Rectangle& t_rect);
+        void add(OutlineRectangle& t_rect);
+        void add(Circle& t_circle);
+        void add(OutlineCircle& t_circle);
+        ///
+        /// @brief Stops checking @ref t_shape, does nothing if it was not
+        ///        added.
+        ///
+        void remove(Shape const& t_shape);
+        void clear() noexcept;
+
+        ///
+        /// @brief Reads where every shape is and returns each pair that
+        ///        overlaps once.
+        ///
+        /// The result stays valid until the next call.
+        ///
+        std::vector<pair> const& update();
+
+        inline std::size_t size() const noexcept
+        {
+            return m_world.size();
+        }
+    };
 } // namespace dummy_api
 
 #endif // !HWAPI_HPP
@@ -0,0 +1,34 @@
+#pragma once
+#ifndef IMAGE_FILTER_HPP
+#define IMAGE_FILTER_HPP
+
+///
+/// @file image_filter.hpp
+/// This file contains the CPU side image processing done while decoding.
+///
+
+#include "SDL2/SDL.h"
+
+namespace hw {
+    ///
+    /// @brief Averages every 2x2 block of @ref t_source into one pixel.
+    ///
+    /// Colors are weighted by their alpha, so the color of transparent
+    /// pixels(eg. a color key) does not show around what they surround.
+    /// Uses SSE2 when available, 4 pixels at a time. An odd last row or
+    /// column is dropped.
+    ///
+    /// @param[in] t_source Must be SDL_PIXELFORMAT_ARGB8888 and at least 2x2.
+    ///
+    /// @returns A new ARGB8888 surface half the size, nullptr if SDL could
+    ///          not allocate it.
+    ///
+    SDL_Surface* downscale_half(SDL_Surface const* t_source);
+    ///
+    /// @brief @ref downscale_half without SSE2, to check that both give
+    ///        the same pixels.
+    ///
+    SDL_Surface* downscale_half_scalar(SDL_Surface const* t_source);
+} // namespace hw
+
+#endif // !IMAGE_FILTER_HPP
@@ -260,4 +260,11 @@ enum keys
         SDL_SCANCODE_TO_KEYCODE(SDL_SCANCODE_AUDIOFASTFORWARD)
 };
 
+enum mouse_buttons
+{
+    MOUSE_LEFT = SDL_BUTTON_LEFT,
+    MOUSE_MIDDLE = SDL_BUTTON_MIDDLE,
+    MOUSE_RIGHT = SDL_BUTTON_RIGHT
+};
+
 #endif // !KEYS_HPP
@@ -0,0 +1,113 @@
+#pragma once
+#ifndef PARTICLES_HPP
+#define PARTICLES_HPP
+
+///
+/// @file particles.hpp
+/// This file contains storage for many small, short lived points that all
+/// move the same way, like sparks, smoke or rain.
+///
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "color.hpp"
+#include "vec2.hpp"
+
+namespace hw {
+    ///
+    /// @brief Particles kept as one array per attribute.
+    ///
+    /// Moving them only touches the positions, velocities and lifetimes,
+    /// each of which is contiguous, so 4 particles are updated per
+    /// instruction. Dead particles are replaced with the last one, which
+    /// costs nothing for the ones still alive but does not keep their
+    /// order.
+    ///
+    class particles
+    {
+      private:
+        std::vector<float> m_x{};
+        std::vector<float> m_y{};
+        std::vector<float> m_vx{};
+        std::vector<float> m_vy{};
+        ///
+        /// Seconds left, and how many the particle started with.
+        ///
+        std::vector<float> m_life{};
+        std::vector<float> m_lifetime{};
+        std::vector<hw::color> m_colors{};
+
+        void remove(std::size_t const t_index) noexcept;
+
+      public:
+        void reserve(std::size_t const t_count);
+        ///
+        /// @brief Adds a particle at @ref t_pos that lives for
+        ///        @ref t_lifetime seconds.
+        ///
+        /// @param[in] t_velocity Pixels per second.
+        ///
+        void emit(hw::vec2f const& t_pos, hw::vec2f const& t_velocity,
+                  hw::color const& t_color, float const t_lifetime);
+        void clear() noexcept;
+
+        ///
+        /// @brief Moves every particle @ref t_seconds forward, speeding it
+        ///        up by @ref t_gravity (pixels per second squared) first.
+        ///
+        /// Particles that run out of life are kept until @ref kill_dead.
+        ///
+        void integrate(float const t_seconds,
+                       hw::vec2f const& t_gravity) noexcept;
+        ///
+        /// @brief The scalar version of @ref integrate, exposed so the
+        ///        vectorized one can be checked against it.
+        ///
+        void integrate_scalar(float const t_seconds,
+                              hw::vec2f const& t_gravity) noexcept;
+        ///
+        /// @brief Removes the particles with no life left.
+        ///
+        void kill_dead() noexcept;
+        ///
+        /// @brief @ref integrate and then @ref kill_dead.
+        ///
+        void update(float const t_seconds, hw::vec2f const& t_gravity) noexcept;
+
+        ///
+        /// @brief The colors with their alpha scaled by how much of its
+        ///        life each particle has left, written to @ref t_out.
+        ///
+        void faded_colors(std::vector<hw::color>& t_out) const;
+
+        inline std::size_t size() const noexcept
+        {
+            return m_x.size();
+        }
+        inline bool empty() const noexcept
+        {
+            return m_x.empty();
+        }
+
+        inline float const* x() const noexcept
+        {
+            return m_x.data();
+        }
+        inline float const* y() const noexcept
+        {
+            return m_y.data();
+        }
+        inline float const* life() const noexcept
+        {
+            return m_life.data();
+        }
+        inline hw::color const* colors() const noexcept
+        {
+            return m_colors.data();
+        }
+    };
+} // namespace hw
+
+#endif // !PARTICLES_HPP
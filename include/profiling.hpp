@@ -0,0 +1,46 @@
+#pragma once
+#ifndef PROFILING_HPP
+#define PROFILING_HPP
+
+///
+/// @file profiling.hpp
+/// This file contains the numbers the library collects about itself while
+/// running, so programs can be tuned against something.
+///
+
+#include <cstddef>
+
+namespace hw {
+    ///
+    /// @brief Summary of a series of measurements, in milliseconds.
+    ///
+    /// @ref p95 only looks at the most recent samples.
+    ///
+    struct latency_stats
+    {
+        std::size_t samples{0};
+        double last{0.0};
+        double min{0.0};
+        double max{0.0};
+        double average{0.0};
+        double p95{0.0};
+    };
+
+    ///
+    /// @brief Adds one input-to-present measurement.
+    ///
+    /// @param[in] t_milliseconds Time from the oldest input event that went
+    ///                           into a frame until that frame was presented.
+    ///
+    /// @note Can be called from any thread.
+    ///
+    void record_input_latency(double const t_milliseconds);
+    ///
+    /// @brief Everything recorded by @ref record_input_latency since the
+    ///        last @ref reset_input_latency.
+    ///
+    hw::latency_stats get_input_latency();
+    void reset_input_latency();
+} // namespace hw
+
+#endif // !PROFILING_HPP
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+///
+/// @file ring_buffer.hpp
+/// This file contains a fixed capacity queue that never allocates.
+///
+
+#include <array>
+#include <cstddef>
+
+namespace hw {
+    ///
+    /// @brief Holds at most @ref N elements, pushing more overwrites the
+    ///        oldest ones.
+    ///
+    template<typename T, std::size_t N>
+    class ring_buffer
+    {
+      private:
+        std::array<T, N> m_data{};
+        std::size_t m_first{0};
+        std::size_t m_size{0};
+        std::size_t m_dropped{0};
+
+      public:
+        inline void clear() noexcept
+        {
+            m_first = 0;
+            m_size = 0;
+            m_dropped = 0;
+        }
+
+        inline void push(T const& t_value) noexcept
+        {
+            if(m_size == N) {
+                m_data[m_first] = t_value;
+                m_first = (m_first + 1) % N;
+                ++m_dropped;
+                return;
+            }
+
+            m_data[(m_first + m_size) % N] = t_value;
+            ++m_size;
+        }
+
+        ///
+        /// @brief The @ref t_index -th oldest element.
+        ///
+        inline T const& operator[](std::size_t const t_index) const noexcept
+        {
+            return m_data[(m_first + t_index) % N];
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        static constexpr std::size_t capacity() noexcept
+        {
+            return N;
+        }
+
+        ///
+        /// @brief How many elements were overwritten since the last
+        ///        @ref clear.
+        ///
+        inline std::size_t dropped() const noexcept
+        {
+            return m_dropped;
+        }
+    };
+} // namespace hw
+
+#endif // !RING_BUFFER_HPP
@@ -0,0 +1,363 @@
+#pragma once
+#ifndef TEXTURE_HPP
+#define TEXTURE_HPP
+
+///
+/// @file texture.hpp
+/// This file contains the declaration of a texture that is decoded in the
+/// background and uploaded on whatever thread draws it.
+///
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SDL2/SDL.h"
+
+#include "atlas.hpp"
+#include "color.hpp"
+
+namespace hw {
+    void forget_textures(SDL_Renderer* t_renderer);
+    void set_texture_hot_reload(bool const t_enabled);
+    void reload_changed_textures();
+    void swap_reloaded_textures();
+    void trim_textures();
+
+    ///
+    /// @brief The result of decoding an image file on a worker thread.
+    ///
+    struct decoded_image;
+
+    ///
+    /// @brief An image file that gets decoded by a background thread and
+    ///        uploaded to the GPU the first time it is drawn after that.
+    ///
+    /// Creating one does not touch SDL at all, so it's safe to do from any
+    /// thread. The SDL_Texture is created by @ref get, which must only be
+    /// called from the thread that draws with the renderer. Destroying the
+    /// SDL_Texture is deferred until @ref destroy_pending_textures runs on
+    /// that same thread.
+    ///
+    class texture
+    {
+      private:
+        std::string m_path{};
+        hw::color m_color_key{0, 0, 0};
+
+        std::shared_ptr<hw::decoded_image> m_decoded{};
+        ///
+        /// A newer version of the file being decoded, swapped in by
+        /// @ref swap_reloaded_textures once it's ready. Guarded by the
+        /// registry mutex.
+        ///
+        std::shared_ptr<hw::decoded_image> m_reload{};
+        ///
+        /// Absolute path reported by the file watcher, empty if not watched.
+        ///
+        std::string m_watched_path{};
+
+        SDL_Texture* m_handle{nullptr};
+        SDL_Renderer* m_renderer{nullptr};
+        ///
+        /// Where the image is inside @ref m_handle, which is an atlas page
+        /// when @ref m_in_atlas is true.
+        ///
+        SDL_Rect m_source{0, 0, 0, 0};
+        int m_backing_width{0};
+        int m_backing_height{0};
+        std::size_t m_bytes{0};
+        ///
+        /// The frame @ref get was last called in, see @ref trim_textures.
+        ///
+        std::uint64_t m_last_used{0};
+        bool m_in_atlas{false};
+        bool m_failed{false};
+
+        ///
+        /// Halved versions of the image, [0] is half the size, [1] a
+        /// quarter... They are never decoded on their own, the full size
+        /// texture hands them their pixels.
+        ///
+        std::vector<std::shared_ptr<hw::texture>> m_levels{};
+        int m_level{0};
+        ///
+        /// Makes the halved versions on a worker thread, started the first
+        /// time @ref level_for wants one and kept until they are no longer
+        /// valid.
+        ///
+        std::shared_ptr<hw::decoded_image> m_levels_job{};
+
+        friend void forget_textures(SDL_Renderer* t_renderer);
+        friend void set_texture_hot_reload(bool const t_enabled);
+        friend void reload_changed_textures();
+        friend void swap_reloaded_textures();
+        friend void trim_textures();
+        friend class texture_atlas;
+
+        ///
+        /// @brief Replaces the upload with @ref m_reload if it finished
+        ///        decoding.
+        ///
+        /// @attention The registry mutex must be held.
+        ///
+        void swap_reloaded();
+        ///
+        /// @brief Gives up the SDL_Texture or atlas space.
+        ///
+        /// @attention The registry mutex must be held.
+        ///
+        void release_upload();
+        ///
+        /// @brief Replaces the pixels of a halved version.
+        ///
+        void adopt(std::shared_ptr<hw::decoded_image> const& t_decoded);
+        void adopt_levels(hw::decoded_image const& t_decoded);
+        ///
+        /// @brief Drops the halved versions, eg. after the image changed.
+        ///
+        /// @attention The registry mutex must be held.
+        ///
+        void forget_levels();
+
+      public:
+        texture(std::string const& t_path, hw::color const& t_color_key);
+        texture(texture const&) = delete;
+        ~texture() noexcept;
+
+        texture& operator=(texture const&) = delete;
+
+        ///
+        /// @brief Starts decoding the file on a worker thread.
+        ///
+        /// Does nothing if it is already being decoded or was uploaded.
+        ///
+        /// @attention Must be called from the thread that calls @ref get,
+        ///            or before the texture is shared with it.
+        ///
+        void decode();
+
+        ///
+        /// @brief Returns the SDL_Texture, uploading the decoded file if it
+        ///        is ready.
+        ///
+        /// @retval nullptr if the file is still being decoded(then it should
+        ///         just be skipped this frame) or could not be loaded.
+        ///
+        SDL_Texture* get(SDL_Renderer* t_renderer);
+
+        ///
+        /// @brief The smallest version that is still at least
+        ///        @ref t_width by @ref t_height, or this one.
+        ///
+        /// Drawing big images much smaller than they are samples a
+        /// pre-filtered smaller version, which is cheaper and does not
+        /// shimmer. The first time one is wanted they are all made in the
+        /// background, until @ref take_levels hands them over this one is
+        /// returned.
+        ///
+        hw::texture& level_for(int const t_width, int const t_height);
+        ///
+        /// @brief Makes the smaller versions @ref level_for started making
+        ///        available, once they are ready.
+        ///
+        /// Called by @ref draw_list::execute before it uploads anything,
+        /// so a frame never switches versions halfway.
+        ///
+        void take_levels();
+
+        ///
+        /// @brief The part of what @ref get returned that holds the image.
+        ///
+        /// @attention Only valid after @ref get returned a texture.
+        ///
+        inline SDL_Rect const& source() const noexcept
+        {
+            return m_source;
+        }
+        ///
+        /// @brief Size of the whole texture returned by @ref get, for
+        ///        turning @ref source into texture coordinates.
+        ///
+        inline int backing_width() const noexcept
+        {
+            return m_backing_width;
+        }
+        inline int backing_height() const noexcept
+        {
+            return m_backing_height;
+        }
+
+        ///
+        /// @brief Whether the image is uploaded, either on its own or in
+        ///        the atlas.
+        ///
+        inline bool resident() const noexcept
+        {
+            return m_handle != nullptr;
+        }
+
+        inline std::string const& path() const noexcept
+        {
+            return m_path;
+        }
+        inline hw::color const& color_key() const noexcept
+        {
+            return m_color_key;
+        }
+    };
+
+    ///
+    /// @brief Numbers about every @ref texture, see
+    ///        @ref get_texture_stats.
+    ///
+    struct texture_stats
+    {
+        ///
+        /// How many times an image file was decoded, including again to
+        /// make its smaller versions.
+        ///
+        std::size_t decodes{0};
+        ///
+        /// How many times an image was taken from a pack instead, see
+        /// @ref mount_asset_pack.
+        ///
+        std::size_t pack_loads{0};
+        ///
+        /// Calls to @ref load_texture that found the texture in the cache
+        /// and calls that had to create it.
+        ///
+        std::size_t hits{0};
+        std::size_t misses{0};
+        ///
+        /// Approximate size of all uploaded textures, 4 bytes per pixel.
+        ///
+        std::size_t bytes_resident{0};
+        std::size_t textures_alive{0};
+        ///
+        /// Textures that are on the GPU right now, and how many times one
+        /// was taken off it to stay within the budget(see
+        /// @ref set_texture_budget).
+        ///
+        std::size_t textures_resident{0};
+        std::size_t evictions{0};
+        std::size_t budget{0};
+
+        inline double hit_rate() const noexcept
+        {
+            std::size_t const total = hits + misses;
+            return total == 0 ? 0.0
+                              : static_cast<double>(hits) /
+                                    static_cast<double>(total);
+        }
+    };
+
+    ///
+    /// @brief Returns the texture for @ref t_path keyed with
+    ///        @ref t_color_key, shared with everyone else that asked for the
+    ///        same pair.
+    ///
+    /// The cache only keeps weak references: a texture is decoded once while
+    /// anyone holds it and freed when the last holder lets go. Decoding of a
+    /// new texture starts right away in the background.
+    ///
+    /// @note Can be called from any thread.
+    ///
+    std::shared_ptr<hw::texture> load_texture(std::string const& t_path,
+                                              hw::color const& t_color_key);
+    hw::texture_stats get_texture_stats();
+    ///
+    /// @brief Blocks until every image file that started decoding is
+    ///        decoded.
+    ///
+    /// The textures are still uploaded the next time they are drawn.
+    ///
+    void wait_for_textures();
+    hw::atlas_stats get_atlas_stats();
+
+    ///
+    /// @brief Makes the images in the pack at @ref t_path load without
+    ///        decoding anything.
+    ///
+    /// The pack is mapped into memory and textures are uploaded straight
+    /// from it. Images that are not in it are still loaded from their
+    /// files. Only affects textures that start loading afterwards.
+    ///
+    /// @retval false if the pack could not be opened.
+    ///
+    bool mount_asset_pack(std::string const& t_path);
+
+    ///
+    /// @brief Starts or stops watching the files of all textures for
+    ///        changes.
+    ///
+    void set_texture_hot_reload(bool const t_enabled);
+    ///
+    /// @brief Starts decoding the files that changed since the last call
+    ///        again, in the background.
+    ///
+    /// Each texture keeps showing the old version until the new one is
+    /// decoded, then @ref swap_reloaded_textures makes the next frame drawn
+    /// use it from its first command to its last, so a frame never mixes
+    /// both. Call this at the start of a frame.
+    ///
+    void reload_changed_textures();
+    ///
+    /// @brief Makes the textures whose new version finished decoding use
+    ///        it, all at once.
+    ///
+    /// Called by @ref draw_list::execute before it uploads or draws
+    /// anything, which is the only time the atlas may be repacked for
+    /// them.
+    ///
+    void swap_reloaded_textures();
+
+    ///
+    /// @brief Limits how much memory uploaded textures may take.
+    ///
+    /// When more than @ref t_bytes are uploaded, the textures that were not
+    /// drawn for the longest time are destroyed until it fits again. They
+    /// are decoded again in the background the next time they are drawn
+    /// and skipped until then. Only images that have a texture of their own
+    /// are evicted, the ones in the atlas are small and stay.
+    ///
+    /// @param[in] t_bytes 0 means no limit, which is the default.
+    ///
+    void set_texture_budget(std::size_t const t_bytes);
+    ///
+    /// @brief Evicts textures not drawn this frame until everything fits in
+    ///        the budget, then starts a new frame.
+    ///
+    /// Called by @ref draw_list::execute after uploading what the frame
+    /// draws, so nothing it needs is evicted.
+    ///
+    void trim_textures();
+
+    ///
+    /// @brief Destroys textures whose owners went away since the last call.
+    ///
+    /// Called by @ref draw_list::execute.
+    ///
+    void destroy_pending_textures();
+    ///
+    /// @brief Destroys @ref t_handle the next time
+    ///        @ref destroy_pending_textures runs, for SDL_Textures that are
+    ///        not owned by a @ref texture.
+    ///
+    /// @note Can be called from any thread.
+    ///
+    void destroy_texture_later(SDL_Renderer* t_renderer,
+                               SDL_Texture* t_handle);
+    ///
+    /// @brief Must be called right before @ref t_renderer is destroyed.
+    ///
+    /// SDL_DestroyRenderer frees all of its textures so this only makes sure
+    /// nobody touches them afterwards. They will be created again if they
+    /// are drawn with a new renderer.
+    ///
+    void forget_textures(SDL_Renderer* t_renderer);
+} // namespace hw
+
+#endif // !TEXTURE_HPP
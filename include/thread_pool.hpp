@@ -0,0 +1,67 @@
+#pragma once
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+///
+/// @file thread_pool.hpp
+/// This file contains a small pool of worker threads for work that should
+/// not block the main loop.
+///
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hw {
+    ///
+    /// @brief Runs pushed tasks on a fixed number of threads, in the order
+    ///        they were pushed.
+    ///
+    /// Destroying the pool finishes every task that was already pushed.
+    ///
+    class thread_pool
+    {
+      private:
+        std::vector<std::thread> m_threads{};
+        std::deque<std::function<void()>> m_tasks{};
+        ///
+        /// Tasks pushed but not finished yet, queued or running.
+        ///
+        std::size_t m_unfinished{0};
+        bool m_stop{false};
+
+        std::mutex m_mutex{};
+        std::condition_variable m_work{};
+        std::condition_variable m_idle{};
+
+        void run();
+
+      public:
+        ///
+        /// @param[in] t_threads 0 means one less than the number of cores,
+        ///                      but at least 1.
+        ///
+        explicit thread_pool(std::size_t const t_threads = 0);
+        thread_pool(thread_pool const&) = delete;
+        ~thread_pool();
+
+        thread_pool& operator=(thread_pool const&) = delete;
+
+        void push(std::function<void()> t_task);
+        ///
+        /// @brief Blocks until every pushed task has finished.
+        ///
+        void wait_idle();
+
+        inline std::size_t size() const noexcept
+        {
+            return m_threads.size();
+        }
+    };
+} // namespace hw
+
+#endif // !THREAD_POOL_HPP
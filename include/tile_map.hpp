@@ -0,0 +1,126 @@
+#pragma once
+#ifndef TILE_MAP_HPP
+#define TILE_MAP_HPP
+
+///
+/// @file tile_map.hpp
+/// This file contains the textures a grid of tiles is drawn into, a square
+/// of tiles at a time, so that drawing the grid costs one copy per square
+/// instead of one per tile.
+///
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "SDL2/SDL.h"
+
+#include "color.hpp"
+#include "texture.hpp"
+#include "vec2.hpp"
+
+namespace hw {
+    void forget_tile_chunks(SDL_Renderer* t_renderer);
+    void reset_tile_chunks();
+
+    ///
+    /// @brief A render target texture holding part of a tile map.
+    ///
+    /// Like @ref canvas_texture it can be created on any thread, while
+    /// @ref render and @ref get must only be called on the thread that
+    /// draws with the renderer.
+    ///
+    class tile_chunk
+    {
+      private:
+        ///
+        /// Size of the chunk in tiles, smaller than the others at the right
+        /// and bottom edges of a map.
+        ///
+        int m_columns{0};
+        int m_rows{0};
+        hw::vec2 m_tile{};
+
+        SDL_Texture* m_handle{nullptr};
+        SDL_Renderer* m_renderer{nullptr};
+        ///
+        /// Set while @ref m_handle does not show the tiles, eg. before they
+        /// were first drawn or after the renderer lost them.
+        ///
+        std::atomic<bool> m_needs_tiles{true};
+
+        friend void forget_tile_chunks(SDL_Renderer* t_renderer);
+        friend void reset_tile_chunks();
+
+      public:
+        tile_chunk(int const t_columns, int const t_rows,
+                   hw::vec2 const& t_tile);
+        tile_chunk(tile_chunk const&) = delete;
+        ~tile_chunk() noexcept;
+
+        tile_chunk& operator=(tile_chunk const&) = delete;
+
+        ///
+        /// @brief Draws @ref t_tiles into the texture, creating it first if
+        ///        needed.
+        ///
+        /// @param[in] t_tiles @ref columns times @ref rows tile indices,
+        ///                    row by row. Negative ones are left empty.
+        /// @param[in] t_tileset Where tile i is the i-th cell of a grid of
+        ///                      tiles, left to right and top to bottom.
+        ///                      nullptr fills tiles with
+        ///                      @ref t_palette[i] instead.
+        /// @param[in] t_vertices Scratch space, kept by the caller.
+        ///
+        void render(SDL_Renderer* t_renderer, int const* t_tiles,
+                    hw::texture* t_tileset, hw::color const* t_palette,
+                    std::size_t const t_palette_size,
+                    std::vector<SDL_Vertex>& t_vertices,
+                    std::vector<int>& t_indices);
+
+        ///
+        /// @retval nullptr if the tiles were not drawn yet.
+        ///
+        SDL_Texture* get(SDL_Renderer* t_renderer) const noexcept;
+
+        ///
+        /// @brief Whether @ref render has to be called again for anything
+        ///        to show up.
+        ///
+        inline bool needs_tiles() const noexcept
+        {
+            return m_needs_tiles.load(std::memory_order_acquire);
+        }
+
+        inline int columns() const noexcept
+        {
+            return m_columns;
+        }
+        inline int rows() const noexcept
+        {
+            return m_rows;
+        }
+        inline int width() const noexcept
+        {
+            return m_columns * m_tile.x;
+        }
+        inline int height() const noexcept
+        {
+            return m_rows * m_tile.y;
+        }
+    };
+
+    ///
+    /// @brief Must be called right before @ref t_renderer is destroyed, see
+    ///        @ref forget_textures.
+    ///
+    void forget_tile_chunks(SDL_Renderer* t_renderer);
+    ///
+    /// @brief Makes every chunk ask for its tiles again, for when the
+    ///        renderer lost what was drawn into render targets
+    ///        (SDL_RENDER_TARGETS_RESET).
+    ///
+    void reset_tile_chunks();
+} // namespace hw
+
+#endif // !TILE_MAP_HPP
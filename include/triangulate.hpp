@@ -0,0 +1,35 @@
+#pragma once
+#ifndef TRIANGULATE_HPP
+#define TRIANGULATE_HPP
+
+///
+/// @file triangulate.hpp
+/// This file contains how polygons are split into triangles so they can be
+/// filled.
+///
+
+#include <cstddef>
+#include <vector>
+
+#include "vec2.hpp"
+
+namespace hw {
+    ///
+    /// @brief Splits the polygon with corners @ref t_points into triangles
+    ///        by ear clipping.
+    ///
+    /// The corners may be given clockwise or counter clockwise. Takes
+    /// O(n^2) time, so shapes keep the result until their corners change.
+    ///
+    /// @param[out] t_indices Replaced with 3 indices into @ref t_points for
+    ///                       every triangle.
+    ///
+    /// @retval false if the polygon has less than 3 corners, no area or
+    ///         crosses itself. Whatever could be split is still in
+    ///         @ref t_indices.
+    ///
+    bool triangulate(hw::vec2f const* t_points, std::size_t const t_count,
+                     std::vector<int>& t_indices);
+} // namespace hw
+
+#endif // !TRIANGULATE_HPP
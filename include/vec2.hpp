@@ -7,34 +7,55 @@
 /// This files contains the declaration for the vec2 type.
 ///
 
+#include <cmath>
+
 namespace hw {
     ///
-    /// @brief Holds two ints describing position in 2D space.
+    /// @brief Holds two numbers describing position in 2D space.
+    ///
+    /// Everything is defined here so building vectors in drawing loops
+    /// compiles down to plain arithmetic. Use @ref vec2 for pixels and
+    /// @ref vec2f for math that needs fractions(rotations, velocities...).
     ///
-    struct vec2
+    template<typename T>
+    struct basic_vec2
     {
-        int x{-1};
-        int y{-1};
+        T x{static_cast<T>(-1)};
+        T y{static_cast<T>(-1)};
 
-        constexpr vec2() = default;
-        vec2(int t_x, int t_y);
-        ~vec2() = default;
+        constexpr basic_vec2() = default;
+        constexpr basic_vec2(T const t_x, T const t_y) noexcept
+            : x(t_x)
+            , y(t_y)
+        {
+        }
 
-        inline bool operator==(const vec2& t_other) const
+        ///
+        /// @brief Converts between int and float vectors, float to int
+        ///        truncates like static_cast does.
+        ///
+        template<typename U>
+        constexpr explicit basic_vec2(basic_vec2<U> const& t_other) noexcept
+            : x(static_cast<T>(t_other.x))
+            , y(static_cast<T>(t_other.y))
+        {
+        }
+
+        constexpr bool operator==(basic_vec2 const& t_other) const noexcept
         {
             return x == t_other.x && y == t_other.y;
         }
-        inline bool operator!=(const vec2& t_other) const
+        constexpr bool operator!=(basic_vec2 const& t_other) const noexcept
         {
             return !this->operator==(t_other);
         }
 
-        inline vec2 operator+(const vec2& t_other) const
+        constexpr basic_vec2 operator+(basic_vec2 const& t_other) const noexcept
         {
-            return vec2{x + t_other.x, y + t_other.y};
+            return basic_vec2{x + t_other.x, y + t_other.y};
         }
 
-        vec2& operator+=(const vec2& t_other)
+        basic_vec2& operator+=(basic_vec2 const& t_other) noexcept
         {
             x += t_other.x;
             y += t_other.y;
@@ -42,19 +63,99 @@ namespace hw {
             return *this;
         }
 
-        inline vec2 operator-(const vec2& t_other) const
+        constexpr basic_vec2 operator-(basic_vec2 const& t_other) const noexcept
         {
-            return vec2{x - t_other.x, y - t_other.y};
+            return basic_vec2{x - t_other.x, y - t_other.y};
         }
 
-        vec2& operator-=(const vec2& t_other)
+        basic_vec2& operator-=(basic_vec2 const& t_other) noexcept
         {
             x -= t_other.x;
             y -= t_other.y;
 
             return *this;
         }
+
+        constexpr basic_vec2 operator-() const noexcept
+        {
+            return basic_vec2{-x, -y};
+        }
+
+        constexpr basic_vec2 operator*(T const t_scalar) const noexcept
+        {
+            return basic_vec2{x * t_scalar, y * t_scalar};
+        }
+
+        basic_vec2& operator*=(T const t_scalar) noexcept
+        {
+            x *= t_scalar;
+            y *= t_scalar;
+
+            return *this;
+        }
+
+        constexpr basic_vec2 operator/(T const t_scalar) const noexcept
+        {
+            return basic_vec2{x / t_scalar, y / t_scalar};
+        }
+
+        basic_vec2& operator/=(T const t_scalar) noexcept
+        {
+            x /= t_scalar;
+            y /= t_scalar;
+
+            return *this;
+        }
     };
+
+    using vec2 = basic_vec2<int>;
+    using vec2f = basic_vec2<float>;
+
+    template<typename T>
+    constexpr basic_vec2<T> operator*(T const t_scalar,
+                                      basic_vec2<T> const& t_vec) noexcept
+    {
+        return t_vec * t_scalar;
+    }
+
+    template<typename T>
+    constexpr T dot(basic_vec2<T> const& t_lhs,
+                    basic_vec2<T> const& t_rhs) noexcept
+    {
+        return t_lhs.x * t_rhs.x + t_lhs.y * t_rhs.y;
+    }
+
+    ///
+    /// @brief The z of the 3D cross product, positive when @ref t_rhs is
+    ///        clockwise from @ref t_lhs on the screen(y goes down).
+    ///
+    template<typename T>
+    constexpr T cross(basic_vec2<T> const& t_lhs,
+                      basic_vec2<T> const& t_rhs) noexcept
+    {
+        return t_lhs.x * t_rhs.y - t_lhs.y * t_rhs.x;
+    }
+
+    template<typename T>
+    constexpr T length_squared(basic_vec2<T> const& t_vec) noexcept
+    {
+        return dot(t_vec, t_vec);
+    }
+
+    inline float length(vec2f const& t_vec) noexcept
+    {
+        return std::sqrt(length_squared(t_vec));
+    }
+
+    ///
+    /// @brief @ref t_vec scaled to a length of 1, or left as it is if it
+    ///        is 0.
+    ///
+    inline vec2f normalize(vec2f const& t_vec) noexcept
+    {
+        float const len = length(t_vec);
+        return len > 0.0f ? t_vec / len : t_vec;
+    }
 } // namespace hw
 
 #endif // !VEC2_HPP
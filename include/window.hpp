@@ -7,15 +7,30 @@
 /// This files contains the declaration of a window type.
 ///
 
-#include <vector>
+#include <bitset>
+#include <cstdint>
 
 #include "SDL2/SDL.h"
 #include "color.hpp"
+#include "ring_buffer.hpp"
+#include "vec2.hpp"
 
 ///
 /// @brief Almost all functionality is provided in @ref hw namespace.
 ///
 namespace hw {
+    ///
+    /// @brief Tag type used to construct a @ref window that is never shown.
+    ///
+    struct headless_t
+    {
+    };
+    ///
+    /// @brief Pass this to the @ref window constructor to get an offscreen
+    ///        window.
+    ///
+    constexpr headless_t headless{};
+
     ///
     /// @brief Window object that can (obviously) create a window,
     ///        set the clear color,
@@ -26,11 +41,52 @@ namespace hw {
       private:
         SDL_Window* m_window{nullptr};
         SDL_Renderer* m_renderer{nullptr};
+        ///
+        /// Only used by headless windows, this is what the software renderer
+        /// draws to.
+        ///
+        SDL_Surface* m_surface{nullptr};
 
         int m_width{-1};
         int m_height{-1};
 
-        std::vector<SDL_Event> m_event_queue{};
+        ///
+        /// Events of the last frame that are not folded into the state
+        /// below(key presses and mouse motion are not kept here).
+        ///
+        hw::ring_buffer<SDL_Event, 128> m_events{};
+        bool m_closed{false};
+
+        hw::vec2 m_mouse{0, 0};
+        hw::vec2 m_mouse_delta{0, 0};
+        std::uint32_t m_buttons_pressed{0};
+        std::uint32_t m_buttons_held{0};
+        ///
+        /// SDL timestamp of the oldest keyboard or mouse event of the last
+        /// frame, 0 if there was none.
+        ///
+        std::uint32_t m_input_time{0};
+
+        ///
+        /// Printable keys are their ASCII value, every other key is
+        /// SDL_SCANCODE_TO_KEYCODE(scancode) so it gets an index after them.
+        ///
+        static constexpr std::size_t key_count = 128 + SDL_NUM_SCANCODES;
+
+        ///
+        /// Keys that went down(or auto repeated) during the last frame.
+        ///
+        std::bitset<key_count> m_pressed{};
+        ///
+        /// Keys that went up during the last frame.
+        ///
+        std::bitset<key_count> m_released{};
+        ///
+        /// Keys that are down right now.
+        ///
+        std::bitset<key_count> m_held{};
+
+        void fold_event(SDL_Event const& t_event) noexcept;
 
         hw::color m_color{0, 0, 0, 155};
 
@@ -42,6 +98,14 @@ namespace hw {
         /// @param[in] t_name is the title of the window.
         ///
         window(const int t_width, const int t_height, const char* t_name);
+        ///
+        /// @brief Constructs a window that is never shown on the screen.
+        ///
+        /// Everything gets rasterized by SDL's software renderer into a
+        /// surface in memory so the output is the same on every machine.
+        /// This is what the golden image tests use.
+        ///
+        window(const int t_width, const int t_height, hw::headless_t);
         ~window();
 
         inline int get_width() const
@@ -68,11 +132,43 @@ namespace hw {
         {
             return m_window;
         }
+        ///
+        /// @retval true if the window was created with @ref headless.
+        ///
+        inline bool is_headless() const noexcept
+        {
+            return m_surface != nullptr;
+        }
+
+        ///
+        /// @brief Creates the renderer for this window.
+        ///
+        /// Done by the constructor, only needed again after
+        /// @ref destroy_renderer (eg. to move the renderer to another
+        /// thread).
+        ///
+        void create_renderer();
+        ///
+        /// @brief Destroys the renderer and every texture created with it.
+        ///
+        void destroy_renderer();
 
+        ///
+        /// @brief Shows what has been rendered so far.
+        ///
+        void present();
         ///
         /// @brief Renders everything on the screen.
         ///
         void update();
+        ///
+        /// @brief Takes all pending events from SDL and folds them into the
+        ///        keyboard, mouse and @ref closed state of this frame.
+        ///
+        /// Events are fetched in batches with SDL_PeepEvents and mouse
+        /// motion is merged into @ref mouse_position and @ref mouse_delta,
+        /// so nothing is allocated no matter how many events arrive.
+        ///
         void handle_events();
         void set_bgcolor(const std::uint8_t t_r, const std::uint8_t t_g,
                          const std::uint8_t t_b, const std::uint8_t t_a = 255);
@@ -83,9 +179,94 @@ namespace hw {
             return m_color;
         }
         void clear();
+        ///
+        /// @brief Copies what has been rendered so far into a new surface.
+        ///
+        /// The surface is always in SDL_PIXELFORMAT_ARGB8888 and has to be
+        /// freed by the caller with SDL_FreeSurface.
+        ///
+        /// @retval nullptr if the pixels could not be read back.
+        ///
+        SDL_Surface* capture();
+
+        ///
+        /// @brief Converts a key(KEY_* or SDLK_*) to an index in the key
+        ///        bitsets.
+        ///
+        /// @retval -1 for keys that are not in keys.hpp.
+        ///
+        static int key_index(int const t_key) noexcept;
+
+        ///
+        /// @retval true if @ref t_key went down during the last frame. Holding
+        ///         a key down also makes this true every time the key auto
+        ///         repeats.
+        ///
+        bool was_key_pressed(int t_key) const noexcept;
+        ///
+        /// @retval true if @ref t_key went up during the last frame.
+        ///
+        bool was_key_released(int t_key) const noexcept;
+        ///
+        /// @retval true as long as @ref t_key is down.
+        ///
+        bool is_key_held(int t_key) const noexcept;
+
+        ///
+        /// @brief Where the mouse was after the last event of the frame.
+        ///
+        inline hw::vec2 mouse_position() const noexcept
+        {
+            return m_mouse;
+        }
+        ///
+        /// @brief How much the mouse moved during the last frame.
+        ///
+        inline hw::vec2 mouse_delta() const noexcept
+        {
+            return m_mouse_delta;
+        }
+        ///
+        /// @param[in] t_button SDL_BUTTON_LEFT, SDL_BUTTON_RIGHT etc.
+        ///
+        inline bool was_button_pressed(int const t_button) const noexcept
+        {
+            return (m_buttons_pressed & SDL_BUTTON(t_button)) != 0;
+        }
+        inline bool is_button_held(int const t_button) const noexcept
+        {
+            return (m_buttons_held & SDL_BUTTON(t_button)) != 0;
+        }
+        ///
+        /// @brief The events of the last frame that were not folded into
+        ///        the keyboard or mouse state.
+        ///
+        inline hw::ring_buffer<SDL_Event, 128> const& events() const noexcept
+        {
+            return m_events;
+        }
 
-        bool was_key_pressed(int t_key);
-        bool closed();
+        ///
+        /// @brief When the oldest keyboard or mouse event handled by the
+        ///        last @ref handle_events happened, in SDL_GetTicks time.
+        ///
+        /// @retval 0 if there was no input.
+        ///
+        inline std::uint32_t input_time() const noexcept
+        {
+            return m_input_time;
+        }
+
+        ///
+        /// @brief Milliseconds between two vertical refreshes of the
+        ///        display the window is on(16.6 if unknown or headless).
+        ///
+        double refresh_interval() const noexcept;
+
+        ///
+        /// @retval true once the user closed the window.
+        ///
+        bool closed() const noexcept;
     };
 } // namespace hw
 
@@ -0,0 +1,190 @@
+#include "asset_pack.hpp"
+
+///
+/// @file asset_pack.cpp
+///
+
+#include <cstring>
+
+#include "SDL2/SDL.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool hw::asset_pack::map(std::string const& t_path)
+{
+    m_file = CreateFileA(t_path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                         nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                         nullptr);
+
+    if(m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+
+    if(!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+        return false;
+    }
+
+    m_mapping =
+        CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if(!m_mapping) {
+        return false;
+    }
+
+    m_data = static_cast<unsigned char const*>(
+        MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    m_size = static_cast<std::size_t>(size.QuadPart);
+
+    return m_data != nullptr;
+}
+
+hw::asset_pack::~asset_pack() noexcept
+{
+    if(m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if(m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if(m_file) {
+        CloseHandle(m_file);
+    }
+}
+
+#else
+
+bool hw::asset_pack::map(std::string const& t_path)
+{
+    m_fd = ::open(t_path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if(m_fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+
+    if(fstat(m_fd, &info) != 0 || info.st_size == 0) {
+        return false;
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size);
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+
+    if(data == MAP_FAILED) {
+        m_size = 0;
+        return false;
+    }
+
+    m_data = static_cast<unsigned char const*>(data);
+
+    return true;
+}
+
+hw::asset_pack::~asset_pack() noexcept
+{
+    if(m_data) {
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+    if(m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+#endif
+
+bool hw::asset_pack::read_index()
+{
+    if(m_size < sizeof(pack_header)) {
+        return false;
+    }
+
+    pack_header header;
+    std::memcpy(&header, m_data, sizeof(header));
+
+    if(std::memcmp(header.magic, pack_magic, sizeof(pack_magic)) != 0 ||
+       header.version != pack_version) {
+        return false;
+    }
+
+    std::size_t const entries_end =
+        sizeof(pack_header) +
+        static_cast<std::size_t>(header.count) * sizeof(pack_entry);
+    std::size_t const names_end = entries_end + header.names_size;
+
+    if(names_end > m_size) {
+        return false;
+    }
+
+    // the entries start 16 bytes into a page aligned mapping so they can be
+    // used in place
+    auto const* entries =
+        reinterpret_cast<pack_entry const*>(m_data + sizeof(pack_header));
+    char const* names = reinterpret_cast<char const*>(m_data + entries_end);
+
+    for(std::uint32_t i = 0; i < header.count; ++i) {
+        pack_entry const& e = entries[i];
+        std::uint64_t const bytes =
+            static_cast<std::uint64_t>(e.pitch) * e.height;
+
+        if(static_cast<std::uint64_t>(e.name_offset) + e.name_length >
+               header.names_size ||
+           e.format != SDL_PIXELFORMAT_ARGB8888 || e.pitch < e.width * 4 ||
+           e.data_offset % pack_alignment != 0 || e.data_offset > m_size ||
+           bytes > m_size - e.data_offset) {
+            return false;
+        }
+
+        m_index.emplace(std::string{names + e.name_offset, e.name_length},
+                        &e);
+    }
+
+    return true;
+}
+
+std::shared_ptr<hw::asset_pack> hw::asset_pack::open(std::string const& t_path)
+{
+    std::shared_ptr<asset_pack> pack{new asset_pack{}};
+
+    if(!pack->map(t_path)) {
+        SDL_Log("Could not open asset pack %s\n", t_path.c_str());
+        return nullptr;
+    }
+
+    if(!pack->read_index()) {
+        SDL_Log("%s is not a valid asset pack\n", t_path.c_str());
+        return nullptr;
+    }
+
+    return pack;
+}
+
+hw::pack_entry const* hw::asset_pack::find(std::string const& t_name,
+                                           hw::color const& t_color_key) const
+{
+    auto const range = m_index.equal_range(t_name);
+
+    for(auto it = range.first; it != range.second; ++it) {
+        pack_entry const& e = *it->second;
+
+        if(e.key_r == t_color_key.r && e.key_g == t_color_key.g &&
+           e.key_b == t_color_key.b) {
+            return &e;
+        }
+    }
+
+    return nullptr;
+}
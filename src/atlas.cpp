@@ -0,0 +1,366 @@
+#include "atlas.hpp"
+
+///
+/// @file atlas.cpp
+///
+
+#include <algorithm>
+#include <climits>
+
+#include "texture.hpp"
+
+constexpr int hw::texture_atlas::page_size;
+constexpr int hw::texture_atlas::max_image_size;
+
+namespace {
+    ///
+    /// Empty pixels left right and below every image so sampling never picks
+    /// up a neighbour.
+    ///
+    constexpr int padding = 1;
+
+    std::size_t area(SDL_Rect const& t_rect) noexcept
+    {
+        return static_cast<std::size_t>(t_rect.w) *
+               static_cast<std::size_t>(t_rect.h);
+    }
+} // namespace
+
+hw::skyline_packer::skyline_packer(int const t_width, int const t_height)
+    : m_width(t_width)
+    , m_height(t_height)
+{
+    this->reset();
+}
+
+void hw::skyline_packer::reset()
+{
+    m_skyline.clear();
+    m_skyline.push_back(segment{0, 0, m_width});
+}
+
+int hw::skyline_packer::fit(std::size_t const t_index, int const t_width,
+                            int const t_height) const noexcept
+{
+    if(m_skyline[t_index].x + t_width > m_width) {
+        return -1;
+    }
+
+    int y = 0;
+    int width_left = t_width;
+
+    for(std::size_t i = t_index; width_left > 0; ++i) {
+        y = std::max(y, m_skyline[i].y);
+
+        if(y + t_height > m_height) {
+            return -1;
+        }
+
+        width_left -= m_skyline[i].width;
+    }
+
+    return y;
+}
+
+bool hw::skyline_packer::insert(int const t_width, int const t_height,
+                                SDL_Rect& t_result)
+{
+    std::size_t best{m_skyline.size()};
+    int best_bottom{INT_MAX};
+    int best_width{INT_MAX};
+
+    for(std::size_t i = 0; i < m_skyline.size(); ++i) {
+        int const y = this->fit(i, t_width, t_height);
+
+        if(y < 0) {
+            continue;
+        }
+
+        // lowest top edge first, then the narrowest segment to waste less
+        if(y + t_height < best_bottom ||
+           (y + t_height == best_bottom && m_skyline[i].width < best_width)) {
+            best = i;
+            best_bottom = y + t_height;
+            best_width = m_skyline[i].width;
+        }
+    }
+
+    if(best == m_skyline.size()) {
+        return false;
+    }
+
+    t_result.x = m_skyline[best].x;
+    t_result.y = best_bottom - t_height;
+    t_result.w = t_width;
+    t_result.h = t_height;
+
+    m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(best),
+                     segment{t_result.x, best_bottom, t_width});
+
+    // the new segment covers the start of the ones after it
+    for(std::size_t i = best + 1; i < m_skyline.size();) {
+        segment const& prev = m_skyline[i - 1];
+        segment& current = m_skyline[i];
+        int const overlap = prev.x + prev.width - current.x;
+
+        if(overlap <= 0) {
+            break;
+        }
+
+        if(current.width <= overlap) {
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+
+        current.x += overlap;
+        current.width -= overlap;
+        break;
+    }
+
+    for(std::size_t i = 0; i + 1 < m_skyline.size();) {
+        if(m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() +
+                            static_cast<std::ptrdiff_t>(i + 1));
+        }
+        else {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+hw::texture_atlas::~texture_atlas() noexcept
+{
+    for(auto const& p : m_pages) {
+        SDL_DestroyTexture(p.handle);
+    }
+}
+
+bool hw::texture_atlas::add_page()
+{
+    SDL_Texture* handle =
+        SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888,
+                          SDL_TEXTUREACCESS_TARGET, page_size, page_size);
+
+    if(!handle) {
+        SDL_Log("Could not create atlas page: %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(handle, SDL_BLENDMODE_BLEND);
+
+    // pages start out with garbage, padding has to be transparent
+    SDL_Texture* previous = SDL_GetRenderTarget(m_renderer);
+    SDL_SetRenderTarget(m_renderer, handle);
+    SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(m_renderer);
+    SDL_SetRenderTarget(m_renderer, previous);
+
+    m_pages.push_back(
+        page{handle, hw::skyline_packer{page_size, page_size}, 0});
+
+    return true;
+}
+
+bool hw::texture_atlas::find_room(int const t_width, int const t_height,
+                                  std::size_t& t_page, SDL_Rect& t_rect)
+{
+    for(std::size_t i = 0; i < m_pages.size(); ++i) {
+        if(m_pages[i].packer.insert(t_width + padding, t_height + padding,
+                                    t_rect)) {
+            t_page = i;
+            t_rect.w = t_width;
+            t_rect.h = t_height;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool hw::texture_atlas::place(int const t_width, int const t_height,
+                              std::size_t& t_page, SDL_Rect& t_rect)
+{
+    if(this->find_room(t_width, t_height, t_page, t_rect)) {
+        return true;
+    }
+
+    if(!this->add_page()) {
+        return false;
+    }
+
+    t_page = m_pages.size() - 1;
+
+    if(!m_pages.back().packer.insert(t_width + padding, t_height + padding,
+                                     t_rect)) {
+        return false;
+    }
+
+    t_rect.w = t_width;
+    t_rect.h = t_height;
+
+    return true;
+}
+
+void hw::texture_atlas::repack()
+{
+    std::vector<page> old = std::move(m_pages);
+    m_pages.clear();
+
+    // tallest first packs a skyline tightest
+    std::stable_sort(m_entries.begin(), m_entries.end(),
+                     [](entry const& t_a, entry const& t_b) {
+                         return t_a.owner->m_source.h > t_b.owner->m_source.h;
+                     });
+
+    SDL_Texture* previous = SDL_GetRenderTarget(m_renderer);
+
+    for(auto& e : m_entries) {
+        SDL_Rect const source = e.owner->m_source;
+        SDL_Rect dest;
+        std::size_t index{0};
+
+        if(!this->place(source.w, source.h, index, dest)) {
+            // out of memory, the image is decoded again next time it is
+            // drawn
+            e.owner->m_handle = nullptr;
+            e.owner->m_renderer = nullptr;
+            e.owner->m_in_atlas = false;
+            continue;
+        }
+
+        SDL_Texture* from = old[e.page].handle;
+
+        SDL_SetRenderTarget(m_renderer, m_pages[index].handle);
+        SDL_SetTextureBlendMode(from, SDL_BLENDMODE_NONE);
+        SDL_RenderCopy(m_renderer, from, &source, &dest);
+        SDL_SetTextureBlendMode(from, SDL_BLENDMODE_BLEND);
+
+        e.page = index;
+        e.owner->m_handle = m_pages[index].handle;
+        e.owner->m_source = dest;
+        m_pages[index].live_area += area(dest);
+    }
+
+    SDL_SetRenderTarget(m_renderer, previous);
+
+    for(auto const& p : old) {
+        SDL_DestroyTexture(p.handle);
+    }
+
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                   [](entry const& t_e) {
+                                       return !t_e.owner->m_in_atlas;
+                                   }),
+                    m_entries.end());
+
+    ++m_repacks;
+}
+
+bool hw::texture_atlas::insert(SDL_Renderer* t_renderer, hw::texture& t_owner,
+                               SDL_Surface* t_pixels)
+{
+    if(t_pixels->w > max_image_size || t_pixels->h > max_image_size) {
+        return false;
+    }
+
+    if(m_renderer != t_renderer) {
+        this->forget(m_renderer);
+        m_renderer = t_renderer;
+    }
+
+    std::size_t live{0};
+
+    for(auto const& p : m_pages) {
+        live += p.live_area;
+    }
+
+    std::size_t const page_area =
+        static_cast<std::size_t>(page_size) * page_size;
+    std::size_t index{0};
+    SDL_Rect rect;
+
+    // a repack copies everything so it's only worth it once the existing
+    // pages are full and mostly hold images that are gone
+    if(!this->find_room(t_pixels->w, t_pixels->h, index, rect)) {
+        if(live * 2 < m_pages.size() * page_area) {
+            this->repack();
+        }
+
+        if(!this->place(t_pixels->w, t_pixels->h, index, rect)) {
+            return false;
+        }
+    }
+
+    SDL_UpdateTexture(m_pages[index].handle, &rect, t_pixels->pixels,
+                      t_pixels->pitch);
+
+    m_pages[index].live_area += area(rect);
+    m_entries.push_back(entry{&t_owner, index});
+
+    t_owner.m_handle = m_pages[index].handle;
+    t_owner.m_renderer = t_renderer;
+    t_owner.m_source = rect;
+    t_owner.m_backing_width = page_size;
+    t_owner.m_backing_height = page_size;
+    t_owner.m_in_atlas = true;
+
+    return true;
+}
+
+void hw::texture_atlas::remove(hw::texture const& t_owner) noexcept
+{
+    auto it = std::find_if(
+        m_entries.begin(), m_entries.end(),
+        [&t_owner](entry const& t_e) { return t_e.owner == &t_owner; });
+
+    if(it == m_entries.end()) {
+        return;
+    }
+
+    m_pages[it->page].live_area -= area(t_owner.m_source);
+    m_entries.erase(it);
+}
+
+void hw::texture_atlas::forget(SDL_Renderer* t_renderer) noexcept
+{
+    if(t_renderer != m_renderer) {
+        return;
+    }
+
+    m_pages.clear();
+    m_entries.clear();
+    m_renderer = nullptr;
+}
+
+hw::atlas_stats hw::texture_atlas::stats() const noexcept
+{
+    hw::atlas_stats result{};
+    result.pages = m_pages.size();
+    result.images = m_entries.size();
+    result.repacks = m_repacks;
+
+    if(m_pages.empty()) {
+        return result;
+    }
+
+    std::size_t live{0};
+
+    for(auto const& p : m_pages) {
+        live += p.live_area;
+    }
+
+    result.occupancy =
+        static_cast<double>(live) /
+        (static_cast<double>(m_pages.size()) * page_size * page_size);
+
+    return result;
+}
+
+std::size_t hw::texture_atlas::bytes() const noexcept
+{
+    return m_pages.size() * static_cast<std::size_t>(page_size) * page_size *
+           4;
+}
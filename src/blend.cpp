@@ -0,0 +1,286 @@
+#include "blend.hpp"
+
+///
+/// @file blend.cpp
+///
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HW_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+// The SSE2 versions treat colors and ARGB8888 pixels the same way: 4 bytes
+// with alpha in the last one, which holds on every x86 cpu. Every formula
+// is written once for 16 bit lanes and once for plain ints so both give
+// exactly the same results.
+
+namespace {
+    ///
+    /// @brief @ref t_value / 255 rounded to nearest, for 0 <= t_value <=
+    ///        255 * 255.
+    ///
+    inline unsigned div255(unsigned const t_value) noexcept
+    {
+        unsigned const t = t_value + 128;
+        return (t + (t >> 8)) >> 8;
+    }
+
+    inline std::uint8_t channel(unsigned const t_value) noexcept
+    {
+        return static_cast<std::uint8_t>(t_value);
+    }
+
+    ///
+    /// @brief @ref t_amount as a weight out of 256.
+    ///
+    inline unsigned lerp_weight(float const t_amount) noexcept
+    {
+        float const clamped = std::max(0.0f, std::min(t_amount, 1.0f));
+        return static_cast<unsigned>(clamped * 256.0f + 0.5f);
+    }
+
+#ifdef HW_HAS_SSE2
+    inline __m128i div255(__m128i const t_value) noexcept
+    {
+        __m128i const t = _mm_add_epi16(t_value, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    }
+
+    ///
+    /// @brief The alpha of each of the 2 pixels in @ref t_pixels copied to
+    ///        all 4 of its lanes.
+    ///
+    inline __m128i spread_alpha(__m128i const t_pixels) noexcept
+    {
+        return _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(t_pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    ///
+    /// @brief @ref spread_alpha with 255 in the alpha lanes, what
+    ///        premultiplying and blending scale the source by.
+    ///
+    inline __m128i alpha_factor(__m128i const t_pixels) noexcept
+    {
+        __m128i const rgb = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+        __m128i const opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+        return _mm_or_si128(_mm_and_si128(spread_alpha(t_pixels), rgb),
+                            opaque);
+    }
+
+    inline __m128i load4(void const* t_source) noexcept
+    {
+        return _mm_loadu_si128(static_cast<__m128i const*>(t_source));
+    }
+
+    inline void store4(void* t_dest, __m128i const t_value) noexcept
+    {
+        _mm_storeu_si128(static_cast<__m128i*>(t_dest), t_value);
+    }
+
+    ///
+    /// @brief Runs @ref t_op on the low and high 2 pixels of @ref t_lhs
+    ///        and @ref t_rhs widened to 16 bits, and packs them back.
+    ///
+    template<typename Op>
+    inline __m128i per_half(__m128i const t_lhs, __m128i const t_rhs,
+                            Op const& t_op) noexcept
+    {
+        __m128i const zero = _mm_setzero_si128();
+        __m128i const low = t_op(_mm_unpacklo_epi8(t_lhs, zero),
+                                 _mm_unpacklo_epi8(t_rhs, zero));
+        __m128i const high = t_op(_mm_unpackhi_epi8(t_lhs, zero),
+                                  _mm_unpackhi_epi8(t_rhs, zero));
+
+        return _mm_packus_epi16(low, high);
+    }
+
+    struct premultiply_op
+    {
+        inline __m128i operator()(__m128i const t_pixels,
+                                  __m128i const /*unused*/) const noexcept
+        {
+            return div255(_mm_mullo_epi16(t_pixels, alpha_factor(t_pixels)));
+        }
+    };
+
+    struct blend_over_op
+    {
+        inline __m128i operator()(__m128i const t_src,
+                                  __m128i const t_dst) const noexcept
+        {
+            __m128i const inverse =
+                _mm_sub_epi16(_mm_set1_epi16(255), spread_alpha(t_src));
+
+            return div255(
+                _mm_add_epi16(_mm_mullo_epi16(t_src, alpha_factor(t_src)),
+                              _mm_mullo_epi16(t_dst, inverse)));
+        }
+    };
+
+    struct multiply_op
+    {
+        inline __m128i operator()(__m128i const t_lhs,
+                                  __m128i const t_rhs) const noexcept
+        {
+            return div255(_mm_mullo_epi16(t_lhs, t_rhs));
+        }
+    };
+
+    struct lerp_op
+    {
+        __m128i weight;
+        __m128i inverse;
+
+        inline __m128i operator()(__m128i const t_from,
+                                  __m128i const t_to) const noexcept
+        {
+            __m128i const sum =
+                _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(t_from, inverse),
+                                            _mm_mullo_epi16(t_to, weight)),
+                              _mm_set1_epi16(128));
+
+            return _mm_srli_epi16(sum, 8);
+        }
+    };
+#endif
+} // namespace
+
+SDL_BlendMode hw::shape_blend_mode(hw::blend_mode const t_mode) noexcept
+{
+    switch(t_mode) {
+    case hw::blend_mode::none:
+        return SDL_BLENDMODE_NONE;
+    case hw::blend_mode::alpha:
+        return SDL_BLENDMODE_BLEND;
+    case hw::blend_mode::premultiplied:
+        return SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+            SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE,
+            SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    case hw::blend_mode::add:
+        return SDL_BLENDMODE_ADD;
+    }
+
+    return SDL_BLENDMODE_BLEND;
+}
+
+SDL_BlendMode hw::image_blend_mode(hw::blend_mode const t_mode) noexcept
+{
+    // straight alpha is right for files in every mode that blends
+    if(t_mode == hw::blend_mode::premultiplied) {
+        return SDL_BLENDMODE_BLEND;
+    }
+
+    return hw::shape_blend_mode(t_mode);
+}
+
+void hw::lerp_colors(hw::color const* t_from, hw::color const* t_to,
+                     float const t_amount, hw::color* t_out,
+                     std::size_t const t_count) noexcept
+{
+    unsigned const weight = lerp_weight(t_amount);
+    std::size_t i{0};
+
+#ifdef HW_HAS_SSE2
+    lerp_op const op{_mm_set1_epi16(static_cast<short>(weight)),
+                     _mm_set1_epi16(static_cast<short>(256 - weight))};
+
+    for(; i + 4 <= t_count; i += 4) {
+        store4(t_out + i, per_half(load4(t_from + i), load4(t_to + i), op));
+    }
+#endif
+
+    auto const mix = [weight](unsigned const t_lhs, unsigned const t_rhs) {
+        return channel((t_lhs * (256 - weight) + t_rhs * weight + 128) >> 8);
+    };
+
+    for(; i < t_count; ++i) {
+        t_out[i] = hw::color{mix(t_from[i].r, t_to[i].r),
+                             mix(t_from[i].g, t_to[i].g),
+                             mix(t_from[i].b, t_to[i].b),
+                             mix(t_from[i].a, t_to[i].a)};
+    }
+}
+
+void hw::blend_over(hw::color const* t_src, hw::color* t_dst,
+                    std::size_t const t_count) noexcept
+{
+    std::size_t i{0};
+
+#ifdef HW_HAS_SSE2
+    for(; i + 4 <= t_count; i += 4) {
+        store4(t_dst + i,
+               per_half(load4(t_src + i), load4(t_dst + i), blend_over_op{}));
+    }
+#endif
+
+    for(; i < t_count; ++i) {
+        hw::color const& s = t_src[i];
+        hw::color& d = t_dst[i];
+        unsigned const inverse = 255u - s.a;
+
+        d = hw::color{channel(div255(s.r * s.a + d.r * inverse)),
+                      channel(div255(s.g * s.a + d.g * inverse)),
+                      channel(div255(s.b * s.a + d.b * inverse)),
+                      channel(div255(s.a * 255u + d.a * inverse))};
+    }
+}
+
+void hw::multiply_colors(hw::color const* t_lhs, hw::color const* t_rhs,
+                         hw::color* t_out, std::size_t const t_count) noexcept
+{
+    std::size_t i{0};
+
+#ifdef HW_HAS_SSE2
+    for(; i + 4 <= t_count; i += 4) {
+        store4(t_out + i,
+               per_half(load4(t_lhs + i), load4(t_rhs + i), multiply_op{}));
+    }
+#endif
+
+    for(; i < t_count; ++i) {
+        t_out[i] = hw::color{channel(div255(t_lhs[i].r * t_rhs[i].r)),
+                             channel(div255(t_lhs[i].g * t_rhs[i].g)),
+                             channel(div255(t_lhs[i].b * t_rhs[i].b)),
+                             channel(div255(t_lhs[i].a * t_rhs[i].a))};
+    }
+}
+
+void hw::premultiply(hw::color* t_colors, std::size_t const t_count) noexcept
+{
+    std::size_t i{0};
+
+#ifdef HW_HAS_SSE2
+    for(; i + 4 <= t_count; i += 4) {
+        __m128i const colors = load4(t_colors + i);
+        store4(t_colors + i, per_half(colors, colors, premultiply_op{}));
+    }
+#endif
+
+    for(; i < t_count; ++i) {
+        t_colors[i] = t_colors[i].premultiplied();
+    }
+}
+
+void hw::premultiply_pixels(std::uint32_t const* t_in, std::uint32_t* t_out,
+                            std::size_t const t_count) noexcept
+{
+    std::size_t i{0};
+
+#ifdef HW_HAS_SSE2
+    for(; i + 4 <= t_count; i += 4) {
+        __m128i const pixels = load4(t_in + i);
+        store4(t_out + i, per_half(pixels, pixels, premultiply_op{}));
+    }
+#endif
+
+    for(; i < t_count; ++i) {
+        t_out[i] = hw::to_argb(hw::from_argb(t_in[i]).premultiplied());
+    }
+}
@@ -0,0 +1,127 @@
+#include "canvas.hpp"
+
+///
+/// @file canvas.cpp
+///
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "texture.hpp"
+
+namespace {
+    ///
+    /// @brief Every canvas texture alive, so they can let go of a renderer
+    ///        that is about to be destroyed.
+    ///
+    struct canvas_registry
+    {
+        std::mutex mutex{};
+        std::vector<hw::canvas_texture*> live{};
+    };
+
+    canvas_registry& get_canvas_registry()
+    {
+        static canvas_registry registry;
+        return registry;
+    }
+} // namespace
+
+hw::canvas_texture::canvas_texture(int const t_width, int const t_height)
+    : m_width(t_width)
+    , m_height(t_height)
+{
+    auto& registry = get_canvas_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.live.push_back(this);
+}
+
+hw::canvas_texture::~canvas_texture() noexcept
+{
+    auto& registry = get_canvas_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    registry.live.erase(
+        std::remove(registry.live.begin(), registry.live.end(), this),
+        registry.live.end());
+
+    if(m_handle) {
+        hw::destroy_texture_later(m_renderer, m_handle);
+    }
+}
+
+SDL_Texture* hw::canvas_texture::get(SDL_Renderer* t_renderer,
+                                     std::uint32_t const* t_pixels)
+{
+    if(!m_handle) {
+        m_handle = SDL_CreateTexture(t_renderer, SDL_PIXELFORMAT_ARGB8888,
+                                     SDL_TEXTUREACCESS_STREAMING, m_width,
+                                     m_height);
+
+        if(!m_handle) {
+            SDL_Log("Could not create a canvas: %s\n", SDL_GetError());
+            return nullptr;
+        }
+
+        SDL_SetTextureBlendMode(m_handle, SDL_BLENDMODE_BLEND);
+        m_renderer = t_renderer;
+        m_needs_pixels.store(true, std::memory_order_release);
+    }
+
+    if(!t_pixels) {
+        return this->needs_pixels() ? nullptr : m_handle;
+    }
+
+    void* target = nullptr;
+    int pitch = 0;
+
+    if(SDL_LockTexture(m_handle, nullptr, &target, &pitch) != 0) {
+        return nullptr;
+    }
+
+    std::size_t const row = static_cast<std::size_t>(m_width) * 4;
+    auto* dst = static_cast<std::uint8_t*>(target);
+
+    if(static_cast<std::size_t>(pitch) == row) {
+        std::memcpy(dst, t_pixels, row * static_cast<std::size_t>(m_height));
+    }
+    else {
+        for(int y = 0; y < m_height; ++y) {
+            std::memcpy(dst + static_cast<std::size_t>(y) *
+                                  static_cast<std::size_t>(pitch),
+                        t_pixels + static_cast<std::size_t>(y) *
+                                       static_cast<std::size_t>(m_width),
+                        row);
+        }
+    }
+
+    SDL_UnlockTexture(m_handle);
+    m_needs_pixels.store(false, std::memory_order_release);
+
+    return m_handle;
+}
+
+hw::thread_pool& hw::get_fill_workers()
+{
+    // the thread calling parallel_fill only waits, so every core helps
+    static hw::thread_pool workers{std::max(
+        static_cast<std::size_t>(std::thread::hardware_concurrency()),
+        static_cast<std::size_t>(1))};
+    return workers;
+}
+
+void hw::forget_canvases(SDL_Renderer* t_renderer)
+{
+    auto& registry = get_canvas_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    for(auto* c : registry.live) {
+        if(c->m_renderer == t_renderer) {
+            c->m_handle = nullptr;
+            c->m_renderer = nullptr;
+            c->m_needs_pixels.store(true, std::memory_order_release);
+        }
+    }
+}
@@ -0,0 +1,485 @@
+#include "collision.hpp"
+
+///
+/// @file collision.cpp
+///
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HW_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+    ///
+    /// @brief Below this many boxes added at once, out of every box, an
+    ///        insertion sort beats sorting from scratch.
+    ///
+    constexpr std::size_t max_insertions_per_box{4};
+
+    int corners(hw::collider const& t_collider, hw::vec2f t_out[4]) noexcept
+    {
+        if(t_collider.type == hw::collider::kind::triangle) {
+            std::copy(t_collider.points, t_collider.points + 3, t_out);
+            return 3;
+        }
+
+        hw::vec2f const& min = t_collider.points[0];
+        hw::vec2f const& max = t_collider.points[1];
+
+        t_out[0] = min;
+        t_out[1] = hw::vec2f{max.x, min.y};
+        t_out[2] = max;
+        t_out[3] = hw::vec2f{min.x, max.y};
+
+        return 4;
+    }
+
+    ///
+    /// @brief Whether the shadows of two convex polygons on @ref t_axis
+    ///        are apart or only touch.
+    ///
+    bool separated_on(hw::vec2f const& t_axis, hw::vec2f const* t_lhs,
+                      int const t_lhs_count, hw::vec2f const* t_rhs,
+                      int const t_rhs_count) noexcept
+    {
+        float lhs_min = hw::dot(t_axis, t_lhs[0]);
+        float lhs_max = lhs_min;
+        float rhs_min = hw::dot(t_axis, t_rhs[0]);
+        float rhs_max = rhs_min;
+
+        for(int i = 1; i < t_lhs_count; ++i) {
+            float const p = hw::dot(t_axis, t_lhs[i]);
+            lhs_min = std::min(lhs_min, p);
+            lhs_max = std::max(lhs_max, p);
+        }
+
+        for(int i = 1; i < t_rhs_count; ++i) {
+            float const p = hw::dot(t_axis, t_rhs[i]);
+            rhs_min = std::min(rhs_min, p);
+            rhs_max = std::max(rhs_max, p);
+        }
+
+        return lhs_max <= rhs_min || rhs_max <= lhs_min;
+    }
+
+    ///
+    /// @brief Separating axis test over the edges of @ref t_edges.
+    ///
+    /// Edge directions are tried along with their normals, which is what
+    /// separates flat triangles(lines) from things in line with them.
+    ///
+    bool any_separating_edge(hw::vec2f const* t_edges, int const t_edge_count,
+                             hw::vec2f const* t_other,
+                             int const t_other_count) noexcept
+    {
+        for(int i = 0; i < t_edge_count; ++i) {
+            hw::vec2f const edge =
+                t_edges[(i + 1) % t_edge_count] - t_edges[i];
+
+            if(edge.x == 0.0f && edge.y == 0.0f) {
+                continue;
+            }
+
+            if(separated_on(hw::vec2f{-edge.y, edge.x}, t_edges, t_edge_count,
+                            t_other, t_other_count) ||
+               separated_on(edge, t_edges, t_edge_count, t_other,
+                            t_other_count)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool convex_overlap(hw::collider const& t_lhs,
+                        hw::collider const& t_rhs) noexcept
+    {
+        hw::vec2f lhs[4];
+        hw::vec2f rhs[4];
+        int const lhs_count = corners(t_lhs, lhs);
+        int const rhs_count = corners(t_rhs, rhs);
+
+        return !any_separating_edge(lhs, lhs_count, rhs, rhs_count) &&
+               !any_separating_edge(rhs, rhs_count, lhs, lhs_count);
+    }
+
+    float distance_squared_to_segment(hw::vec2f const& t_point,
+                                      hw::vec2f const& t_a,
+                                      hw::vec2f const& t_b) noexcept
+    {
+        hw::vec2f const ab = t_b - t_a;
+        float const len = hw::length_squared(ab);
+        float t = len > 0.0f ? hw::dot(t_point - t_a, ab) / len : 0.0f;
+
+        t = std::max(0.0f, std::min(t, 1.0f));
+
+        return hw::length_squared(t_point - (t_a + ab * t));
+    }
+
+    bool circle_overlap(hw::collider const& t_circle,
+                        hw::collider const& t_other) noexcept
+    {
+        hw::vec2f const& center = t_circle.points[0];
+        float const radius = t_circle.radius;
+
+        if(!(radius > 0.0f)) {
+            return false;
+        }
+
+        switch(t_other.type) {
+        case hw::collider::kind::circle: {
+            float const reach = radius + t_other.radius;
+            return t_other.radius > 0.0f &&
+                   hw::length_squared(t_other.points[0] - center) <
+                       reach * reach;
+        }
+        case hw::collider::kind::rect: {
+            hw::vec2f const& min = t_other.points[0];
+            hw::vec2f const& max = t_other.points[1];
+
+            if(!(min.x < max.x && min.y < max.y)) {
+                return false;
+            }
+
+            hw::vec2f const closest{std::max(min.x, std::min(center.x, max.x)),
+                                    std::max(min.y, std::min(center.y, max.y))};
+
+            return hw::length_squared(closest - center) < radius * radius;
+        }
+        case hw::collider::kind::triangle: {
+            hw::vec2f const* p = t_other.points;
+            float const d0 = hw::cross(p[1] - p[0], center - p[0]);
+            float const d1 = hw::cross(p[2] - p[1], center - p[1]);
+            float const d2 = hw::cross(p[0] - p[2], center - p[2]);
+
+            // strictly inside, whichever way the corners go around
+            if((d0 > 0.0f && d1 > 0.0f && d2 > 0.0f) ||
+               (d0 < 0.0f && d1 < 0.0f && d2 < 0.0f)) {
+                return true;
+            }
+
+            float const closest =
+                std::min(distance_squared_to_segment(center, p[0], p[1]),
+                         std::min(distance_squared_to_segment(center, p[1],
+                                                              p[2]),
+                                  distance_squared_to_segment(center, p[2],
+                                                              p[0])));
+
+            return closest < radius * radius;
+        }
+        }
+
+        return false;
+    }
+
+    inline bool boxes_overlap(hw::bounds const& t_lhs,
+                              hw::bounds const& t_rhs) noexcept
+    {
+        return t_lhs.min_x < t_rhs.max_x && t_rhs.min_x < t_lhs.max_x &&
+               t_lhs.min_y < t_rhs.max_y && t_rhs.min_y < t_lhs.max_y;
+    }
+
+    inline hw::collision_pair make_pair(std::uint32_t const t_lhs,
+                                        std::uint32_t const t_rhs) noexcept
+    {
+        return t_lhs < t_rhs ? hw::collision_pair{t_lhs, t_rhs}
+                             : hw::collision_pair{t_rhs, t_lhs};
+    }
+} // namespace
+
+hw::collider hw::rect_collider(hw::vec2f const& t_pos,
+                               hw::vec2f const& t_dim) noexcept
+{
+    hw::vec2f const end = t_pos + t_dim;
+    hw::collider result{};
+
+    result.type = hw::collider::kind::rect;
+    result.points[0] = hw::vec2f{std::min(t_pos.x, end.x),
+                                 std::min(t_pos.y, end.y)};
+    result.points[1] = hw::vec2f{std::max(t_pos.x, end.x),
+                                 std::max(t_pos.y, end.y)};
+
+    return result;
+}
+
+hw::collider hw::circle_collider(hw::vec2f const& t_center,
+                                 float const t_radius) noexcept
+{
+    hw::collider result{};
+
+    result.type = hw::collider::kind::circle;
+    result.points[0] = t_center;
+    result.radius = t_radius;
+
+    return result;
+}
+
+hw::collider hw::triangle_collider(hw::vec2f const& t_a,
+                                   hw::vec2f const& t_b,
+                                   hw::vec2f const& t_c) noexcept
+{
+    hw::collider result{};
+
+    result.type = hw::collider::kind::triangle;
+    result.points[0] = t_a;
+    result.points[1] = t_b;
+    result.points[2] = t_c;
+
+    return result;
+}
+
+hw::collider hw::line_collider(hw::vec2f const& t_a,
+                               hw::vec2f const& t_b) noexcept
+{
+    return hw::triangle_collider(t_a, t_b, t_b);
+}
+
+hw::collider hw::point_collider(hw::vec2f const& t_pos) noexcept
+{
+    return hw::rect_collider(t_pos, hw::vec2f{1.0f, 1.0f});
+}
+
+hw::bounds hw::bounds_of(hw::collider const& t_collider) noexcept
+{
+    hw::vec2f const* p = t_collider.points;
+
+    switch(t_collider.type) {
+    case hw::collider::kind::rect:
+        return hw::bounds{p[0].x, p[0].y, p[1].x, p[1].y};
+    case hw::collider::kind::circle: {
+        float const r = std::max(t_collider.radius, 0.0f);
+        return hw::bounds{p[0].x - r, p[0].y - r, p[0].x + r, p[0].y + r};
+    }
+    case hw::collider::kind::triangle:
+        return hw::bounds{std::min(p[0].x, std::min(p[1].x, p[2].x)),
+                          std::min(p[0].y, std::min(p[1].y, p[2].y)),
+                          std::max(p[0].x, std::max(p[1].x, p[2].x)),
+                          std::max(p[0].y, std::max(p[1].y, p[2].y))};
+    }
+
+    return hw::bounds{0.0f, 0.0f, 0.0f, 0.0f};
+}
+
+bool hw::overlap(hw::collider const& t_lhs,
+                 hw::collider const& t_rhs) noexcept
+{
+    if(t_lhs.type == hw::collider::kind::circle) {
+        return circle_overlap(t_lhs, t_rhs);
+    }
+
+    if(t_rhs.type == hw::collider::kind::circle) {
+        return circle_overlap(t_rhs, t_lhs);
+    }
+
+    if(t_lhs.type == hw::collider::kind::rect &&
+       t_rhs.type == hw::collider::kind::rect) {
+        return boxes_overlap(hw::bounds_of(t_lhs), hw::bounds_of(t_rhs));
+    }
+
+    return convex_overlap(t_lhs, t_rhs);
+}
+
+std::uint32_t hw::collision_world::add(hw::collider const& t_collider)
+{
+    std::uint32_t id{0};
+
+    if(m_free.empty()) {
+        id = static_cast<std::uint32_t>(m_colliders.size());
+        m_colliders.push_back(t_collider);
+        m_bounds.push_back(hw::bounds_of(t_collider));
+        m_alive.push_back(true);
+    }
+    else {
+        id = m_free.back();
+        m_free.pop_back();
+        m_colliders[id] = t_collider;
+        m_bounds[id] = hw::bounds_of(t_collider);
+        m_alive[id] = true;
+    }
+
+    m_added.push_back(id);
+    ++m_count;
+
+    return id;
+}
+
+void hw::collision_world::move(std::uint32_t const t_id,
+                               hw::collider const& t_collider) noexcept
+{
+    m_colliders[t_id] = t_collider;
+    m_bounds[t_id] = hw::bounds_of(t_collider);
+}
+
+void hw::collision_world::remove(std::uint32_t const t_id)
+{
+    if(!this->contains(t_id)) {
+        return;
+    }
+
+    m_alive[t_id] = false;
+    m_removed.push_back(t_id);
+    --m_count;
+}
+
+void hw::collision_world::clear() noexcept
+{
+    m_colliders.clear();
+    m_bounds.clear();
+    m_alive.clear();
+    m_free.clear();
+    m_sorted.clear();
+    m_added.clear();
+    m_removed.clear();
+    m_pairs.clear();
+    m_count = 0;
+}
+
+std::vector<hw::collision_pair> const& hw::collision_world::find_pairs()
+{
+    if(!m_removed.empty()) {
+        m_sorted.erase(std::remove_if(m_sorted.begin(), m_sorted.end(),
+                                      [this](entry const& t_entry) {
+                                          return !m_alive[t_entry.id];
+                                      }),
+                       m_sorted.end());
+
+        // only given out again now that nothing refers to them
+        m_free.insert(m_free.end(), m_removed.begin(), m_removed.end());
+        m_removed.clear();
+    }
+
+    for(auto& e : m_sorted) {
+        e.box = m_bounds[e.id];
+    }
+
+    std::size_t const kept = m_sorted.size();
+
+    for(std::uint32_t const id : m_added) {
+        if(m_alive[id]) {
+            m_sorted.push_back(entry{m_bounds[id], id});
+        }
+    }
+
+    m_added.clear();
+
+    auto const by_left = [](entry const& t_lhs, entry const& t_rhs) {
+        return t_lhs.box.min_x < t_rhs.box.min_x;
+    };
+
+    if((m_sorted.size() - kept) * max_insertions_per_box > m_sorted.size()) {
+        std::sort(m_sorted.begin(), m_sorted.end(), by_left);
+    }
+    else {
+        // the order of the last call, where most boxes already are
+        for(std::size_t i = 1; i < m_sorted.size(); ++i) {
+            entry const e = m_sorted[i];
+            std::size_t j = i;
+
+            while(j > 0 && by_left(e, m_sorted[j - 1])) {
+                m_sorted[j] = m_sorted[j - 1];
+                --j;
+            }
+
+            m_sorted[j] = e;
+        }
+    }
+
+    std::size_t const count = m_sorted.size();
+
+    m_min_x.resize(count);
+    m_max_x.resize(count);
+    m_min_y.resize(count);
+    m_max_y.resize(count);
+
+    for(std::size_t i = 0; i < count; ++i) {
+        m_min_x[i] = m_sorted[i].box.min_x;
+        m_max_x[i] = m_sorted[i].box.max_x;
+        m_min_y[i] = m_sorted[i].box.min_y;
+        m_max_y[i] = m_sorted[i].box.max_y;
+    }
+
+    m_pairs.clear();
+
+    for(std::size_t i = 0; i < count; ++i) {
+        bounds const& box = m_sorted[i].box;
+        std::size_t j = i + 1;
+        bool reached_end{false};
+
+#ifdef HW_HAS_SSE2
+        // most boxes that overlap on x do not on y, test 4 of them at once
+        // instead of guessing each branch
+        __m128 const min_x = _mm_set1_ps(box.min_x);
+        __m128 const max_x = _mm_set1_ps(box.max_x);
+        __m128 const min_y = _mm_set1_ps(box.min_y);
+        __m128 const max_y = _mm_set1_ps(box.max_y);
+
+        for(; j + 4 <= count; j += 4) {
+            // sorted by left edge, so once one starts past this box the
+            // rest do too
+            int const in_reach =
+                _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_min_x[j]), max_x));
+            __m128 const hit = _mm_and_ps(
+                _mm_and_ps(_mm_cmplt_ps(min_x, _mm_loadu_ps(&m_max_x[j])),
+                           _mm_cmplt_ps(min_y, _mm_loadu_ps(&m_max_y[j]))),
+                _mm_cmplt_ps(_mm_loadu_ps(&m_min_y[j]), max_y));
+
+            for(int hits = _mm_movemask_ps(hit) & in_reach; hits != 0;
+                hits &= hits - 1) {
+                int lane{0};
+
+                while(((hits >> lane) & 1) == 0) {
+                    ++lane;
+                }
+
+                this->test_pair(i, j + static_cast<std::size_t>(lane));
+            }
+
+            if(in_reach != 0xF) {
+                reached_end = true;
+                break;
+            }
+        }
+#endif
+
+        for(; !reached_end && j < count && m_min_x[j] < box.max_x; ++j) {
+            if(box.min_x < m_max_x[j] && box.min_y < m_max_y[j] &&
+               m_min_y[j] < box.max_y) {
+                this->test_pair(i, j);
+            }
+        }
+    }
+
+    return m_pairs;
+}
+
+void hw::collision_world::test_pair(std::size_t const t_lhs,
+                                    std::size_t const t_rhs)
+{
+    std::uint32_t const lhs = m_sorted[t_lhs].id;
+    std::uint32_t const rhs = m_sorted[t_rhs].id;
+
+    if(hw::overlap(m_colliders[lhs], m_colliders[rhs])) {
+        m_pairs.push_back(make_pair(lhs, rhs));
+    }
+}
+
+std::vector<hw::collision_pair> const&
+hw::collision_world::find_pairs_brute_force()
+{
+    m_pairs.clear();
+
+    for(std::uint32_t i = 0; i < m_alive.size(); ++i) {
+        for(std::uint32_t j = i + 1; j < m_alive.size(); ++j) {
+            if(m_alive[i] && m_alive[j] &&
+               boxes_overlap(m_bounds[i], m_bounds[j]) &&
+               hw::overlap(m_colliders[i], m_colliders[j])) {
+                m_pairs.push_back(make_pair(i, j));
+            }
+        }
+    }
+
+    return m_pairs;
+}
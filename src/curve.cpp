@@ -0,0 +1,115 @@
+#include "curve.hpp"
+
+///
+/// @file curve.cpp
+///
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    ///
+    /// @brief Limits how many lines one curve becomes, for huge curves or
+    ///        tiny tolerances.
+    ///
+    constexpr int max_segments{1024};
+
+    int clamp_segments(float const t_segments) noexcept
+    {
+        if(!(t_segments > 1.0f)) {
+            return 1;
+        }
+
+        return std::min(static_cast<int>(std::ceil(t_segments)), max_segments);
+    }
+} // namespace
+
+float hw::local_tolerance(hw::affine2 const& t_transform) noexcept
+{
+    float const scale = std::max(
+        hw::length(hw::vec2f{t_transform.a, t_transform.b}),
+        hw::length(hw::vec2f{t_transform.c, t_transform.d}));
+
+    return scale > 0.0f ? hw::curve_tolerance / scale : hw::curve_tolerance;
+}
+
+void hw::flatten_quadratic(hw::vec2f const& t_start,
+                           hw::vec2f const& t_control, hw::vec2f const& t_end,
+                           float const t_tolerance,
+                           std::vector<hw::vec2f>& t_points)
+{
+    // the lines are at most |start - 2 * control + end| / (4 * n^2) away
+    // from the curve when it is cut into n equal steps of t
+    float const bend = hw::length(t_start - t_control * 2.0f + t_end);
+    int const segments =
+        clamp_segments(std::sqrt(bend / (4.0f * t_tolerance)));
+
+    t_points.push_back(t_start);
+
+    for(int i = 1; i < segments; ++i) {
+        float const t = static_cast<float>(i) / static_cast<float>(segments);
+        float const u = 1.0f - t;
+
+        t_points.push_back(t_start * (u * u) + t_control * (2.0f * u * t) +
+                           t_end * (t * t));
+    }
+
+    t_points.push_back(t_end);
+}
+
+void hw::flatten_cubic(hw::vec2f const& t_start, hw::vec2f const& t_first,
+                       hw::vec2f const& t_second, hw::vec2f const& t_end,
+                       float const t_tolerance,
+                       std::vector<hw::vec2f>& t_points)
+{
+    // Wang's formula, the same bound as for quadratic curves using the
+    // biggest of the 2 second differences
+    float const bend =
+        std::max(hw::length(t_start - t_first * 2.0f + t_second),
+                 hw::length(t_first - t_second * 2.0f + t_end));
+    int const segments =
+        clamp_segments(std::sqrt(0.75f * bend / t_tolerance));
+
+    t_points.push_back(t_start);
+
+    for(int i = 1; i < segments; ++i) {
+        float const t = static_cast<float>(i) / static_cast<float>(segments);
+        float const u = 1.0f - t;
+
+        t_points.push_back(t_start * (u * u * u) +
+                           t_first * (3.0f * u * u * t) +
+                           t_second * (3.0f * u * t * t) + t_end * (t * t * t));
+    }
+
+    t_points.push_back(t_end);
+}
+
+void hw::flatten_arc(hw::vec2f const& t_center, float const t_radius,
+                     float const t_start_angle, float const t_end_angle,
+                     float const t_tolerance,
+                     std::vector<hw::vec2f>& t_points)
+{
+    float const to_radians = 3.14159265f / 180.0f;
+    float const sweep =
+        std::max(-360.0f, std::min(t_end_angle - t_start_angle, 360.0f)) *
+        to_radians;
+    float const radius = std::fabs(t_radius);
+
+    // a chord of angle a is radius * (1 - cos(a / 2)) away from the arc
+    float step = 3.14159265f / 2.0f;
+
+    if(radius > t_tolerance) {
+        step = std::min(step, 2.0f * std::acos(1.0f - t_tolerance / radius));
+    }
+
+    int const segments = clamp_segments(std::fabs(sweep) / step);
+    float const start = t_start_angle * to_radians;
+
+    for(int i = 0; i <= segments; ++i) {
+        float const angle =
+            start + sweep * static_cast<float>(i) / static_cast<float>(segments);
+
+        t_points.push_back(t_center + hw::vec2f{radius * std::cos(angle),
+                                                radius * std::sin(angle)});
+    }
+}
@@ -0,0 +1,1130 @@
+#include "draw_list.hpp"
+
+///
+/// @file draw_list.cpp
+///
+
+#include <algorithm>
+#include <cmath>
+
+#include "drawing_api.hpp"
+
+namespace {
+    ///
+    /// @brief Texture coordinates of the image inside whatever texture
+    ///        @ref hw::texture::get returned.
+    ///
+    struct uv_rect
+    {
+        float u0;
+        float v0;
+        float u1;
+        float v1;
+    };
+
+    ///
+    /// @brief Which texture an image command is drawn from.
+    ///
+    /// Frames of a sprite sheet always come from the full size image,
+    /// smaller versions would blur neighbouring frames into each other.
+    ///
+    hw::texture& level_of(hw::draw_command const& t_cmd)
+    {
+        if(t_cmd.frame.w > 0 && t_cmd.frame.h > 0) {
+            return *t_cmd.texture;
+        }
+
+        return t_cmd.texture->level_for(t_cmd.second.x, t_cmd.second.y);
+    }
+
+    SDL_Rect source_of(hw::texture const& t_texture,
+                       hw::draw_command const& t_cmd) noexcept
+    {
+        SDL_Rect source = t_texture.source();
+
+        if(t_cmd.frame.w > 0 && t_cmd.frame.h > 0) {
+            source.x += t_cmd.frame.x;
+            source.y += t_cmd.frame.y;
+            source.w = t_cmd.frame.w;
+            source.h = t_cmd.frame.h;
+        }
+
+        return source;
+    }
+
+    uv_rect get_uv(hw::texture const& t_texture,
+                   SDL_Rect const& t_source) noexcept
+    {
+        float const width = static_cast<float>(t_texture.backing_width());
+        float const height = static_cast<float>(t_texture.backing_height());
+
+        return uv_rect{static_cast<float>(t_source.x) / width,
+                       static_cast<float>(t_source.y) / height,
+                       static_cast<float>(t_source.x + t_source.w) / width,
+                       static_cast<float>(t_source.y + t_source.h) / height};
+    }
+
+    hw::vec2 to_pixel(hw::vec2f const& t_pos) noexcept
+    {
+        return hw::vec2{static_cast<int>(std::lround(t_pos.x)),
+                        static_cast<int>(std::lround(t_pos.y))};
+    }
+
+    ///
+    /// @brief Whether rectangles stay rectangles with their edges along
+    ///        the screen's after @ref t_transform.
+    ///
+    bool keeps_axes(hw::affine2 const& t_transform) noexcept
+    {
+        return t_transform.b == 0.0f && t_transform.c == 0.0f;
+    }
+
+    ///
+    /// @brief How much longer @ref t_transform makes things along x and
+    ///        along y.
+    ///
+    hw::vec2f scale_of(hw::affine2 const& t_transform) noexcept
+    {
+        return hw::vec2f{hw::length(hw::vec2f{t_transform.a, t_transform.b}),
+                         hw::length(hw::vec2f{t_transform.c, t_transform.d})};
+    }
+
+    ///
+    /// @brief The corners of what a rectangle, image or canvas command
+    ///        covers, clockwise starting from the top left one.
+    ///
+    void get_corners(hw::draw_command const& t_cmd,
+                     std::vector<hw::vec2f> const& t_points,
+                     SDL_FPoint t_corners[4]) noexcept
+    {
+        if(t_cmd.quad) {
+            for(std::size_t i = 0; i < 4; ++i) {
+                hw::vec2f const& corner = t_points[t_cmd.points + i];
+                t_corners[i] = SDL_FPoint{corner.x, corner.y};
+            }
+
+            return;
+        }
+
+        float const x0 = static_cast<float>(t_cmd.first.x);
+        float const y0 = static_cast<float>(t_cmd.first.y);
+        float const x1 = static_cast<float>(t_cmd.first.x + t_cmd.second.x);
+        float const y1 = static_cast<float>(t_cmd.first.y + t_cmd.second.y);
+
+        t_corners[0] = SDL_FPoint{x0, y0};
+        t_corners[1] = SDL_FPoint{x1, y0};
+        t_corners[2] = SDL_FPoint{x1, y1};
+        t_corners[3] = SDL_FPoint{x0, y1};
+    }
+
+    ///
+    /// @brief Whether @ref t_cmd is made of triangles without a texture,
+    ///        which are batched together.
+    ///
+    bool is_geometry(hw::draw_command const& t_cmd) noexcept
+    {
+        return t_cmd.type == hw::draw_command::kind::polygon ||
+               (t_cmd.type == hw::draw_command::kind::rectangle &&
+                t_cmd.quad);
+    }
+
+    ///
+    /// @brief Whether @ref t_kind is drawn with the renderer's draw color,
+    ///        and so with its draw blend mode.
+    ///
+    bool is_shape(hw::draw_command::kind const t_kind) noexcept
+    {
+        return t_kind != hw::draw_command::kind::clear &&
+               t_kind != hw::draw_command::kind::image &&
+               t_kind != hw::draw_command::kind::sprites &&
+               t_kind != hw::draw_command::kind::canvas &&
+               t_kind != hw::draw_command::kind::text &&
+               t_kind != hw::draw_command::kind::tile_chunk;
+    }
+
+    void set_shape_blend_mode(SDL_Renderer* t_renderer,
+                              hw::blend_mode const t_mode)
+    {
+        if(SDL_SetRenderDrawBlendMode(t_renderer,
+                                      hw::shape_blend_mode(t_mode)) != 0) {
+            // the software renderer has no premultiplied mode
+            SDL_SetRenderDrawBlendMode(t_renderer, SDL_BLENDMODE_BLEND);
+        }
+    }
+
+    void set_canvas_blend_mode(SDL_Texture* t_handle,
+                               hw::blend_mode const t_mode)
+    {
+        if(SDL_SetTextureBlendMode(t_handle, hw::shape_blend_mode(t_mode)) !=
+           0) {
+            SDL_SetTextureBlendMode(t_handle, SDL_BLENDMODE_BLEND);
+        }
+    }
+
+    ///
+    /// @brief Adds two triangles covering @ref t_corners, given clockwise
+    ///        starting from the top left one.
+    ///
+    void push_quad(std::vector<SDL_Vertex>& t_vertices,
+                   std::vector<int>& t_indices, SDL_FPoint const t_corners[4],
+                   SDL_Color const& t_color, uv_rect const& t_uv)
+    {
+        int const base = static_cast<int>(t_vertices.size());
+
+        t_vertices.push_back(
+            SDL_Vertex{t_corners[0], t_color, SDL_FPoint{t_uv.u0, t_uv.v0}});
+        t_vertices.push_back(
+            SDL_Vertex{t_corners[1], t_color, SDL_FPoint{t_uv.u1, t_uv.v0}});
+        t_vertices.push_back(
+            SDL_Vertex{t_corners[2], t_color, SDL_FPoint{t_uv.u1, t_uv.v1}});
+        t_vertices.push_back(
+            SDL_Vertex{t_corners[3], t_color, SDL_FPoint{t_uv.u0, t_uv.v1}});
+
+        int const quad[] = {0, 1, 2, 0, 2, 3};
+
+        for(int const index : quad) {
+            t_indices.push_back(base + index);
+        }
+    }
+} // namespace
+
+void hw::draw_list::push(hw::draw_command::kind const t_kind,
+                         hw::vec2 const& t_first, hw::vec2 const& t_second,
+                         hw::vec2 const& t_third, hw::color const& t_color)
+{
+    m_commands.emplace_back();
+
+    auto& cmd = m_commands.back();
+    cmd.type = t_kind;
+    cmd.first = t_first;
+    cmd.second = t_second;
+    cmd.third = t_third;
+    cmd.color = t_color;
+    cmd.blend = m_blend;
+}
+
+hw::vec2 hw::draw_list::place(hw::vec2 const& t_pos) const noexcept
+{
+    if(!m_transformed) {
+        return t_pos;
+    }
+
+    return to_pixel(m_transform * hw::vec2f{t_pos});
+}
+
+void hw::draw_list::push_rect(hw::draw_command::kind const t_kind,
+                              hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                              hw::color const& t_color)
+{
+    if(!m_transformed) {
+        push(t_kind, t_pos, t_dim, hw::vec2{}, t_color);
+        return;
+    }
+
+    float const x0 = static_cast<float>(t_pos.x);
+    float const y0 = static_cast<float>(t_pos.y);
+    float const x1 = static_cast<float>(t_pos.x + t_dim.x);
+    float const y1 = static_cast<float>(t_pos.y + t_dim.y);
+
+    hw::vec2f const corners[] = {
+        hw::vec2f{x0, y0}, hw::vec2f{x1, y0}, hw::vec2f{x1, y1},
+        hw::vec2f{x0, y1}};
+
+    // SDL_RenderCopy can not mirror, only filled rectangles may flip
+    bool const mirrored = m_transform.a < 0.0f || m_transform.d < 0.0f;
+
+    if(keeps_axes(m_transform) &&
+       (t_kind == draw_command::kind::rectangle || !mirrored)) {
+        hw::vec2f const a = m_transform * corners[0];
+        hw::vec2f const b = m_transform * corners[2];
+        hw::vec2 const low =
+            to_pixel(hw::vec2f{std::min(a.x, b.x), std::min(a.y, b.y)});
+        hw::vec2 const high =
+            to_pixel(hw::vec2f{std::max(a.x, b.x), std::max(a.y, b.y)});
+
+        push(t_kind, low, high - low, hw::vec2{}, t_color);
+        return;
+    }
+
+    // the size on screen is still needed to pick the level of images
+    hw::vec2f const scale = scale_of(m_transform);
+
+    push(t_kind, this->place(t_pos),
+         to_pixel(hw::vec2f{static_cast<float>(t_dim.x) * scale.x,
+                            static_cast<float>(t_dim.y) * scale.y}),
+         hw::vec2{}, t_color);
+
+    auto& cmd = m_commands.back();
+    cmd.quad = true;
+    cmd.points = this->keep_points(corners, 4);
+    cmd.point_count = 4;
+}
+
+std::size_t hw::draw_list::keep_points(hw::vec2f const* t_points,
+                                       std::size_t const t_count)
+{
+    std::size_t const start = m_points.size();
+
+    m_points.resize(start + t_count);
+
+    if(m_transformed) {
+        hw::transform_points(m_transform, t_points, &m_points[start], t_count);
+    }
+    else {
+        std::copy(t_points, t_points + t_count, &m_points[start]);
+    }
+
+    return start;
+}
+
+void hw::draw_list::push_transform(hw::affine2 const& t_transform)
+{
+    m_saved_transforms.push_back(m_transform);
+    m_transform = m_transform * t_transform;
+    m_transformed = m_transform != hw::affine2::identity();
+}
+
+void hw::draw_list::pop_transform() noexcept
+{
+    if(m_saved_transforms.empty()) {
+        return;
+    }
+
+    m_transform = m_saved_transforms.back();
+    m_saved_transforms.pop_back();
+    m_transformed = m_transform != hw::affine2::identity();
+}
+
+void hw::draw_list::reset_transform() noexcept
+{
+    m_saved_transforms.clear();
+    m_transform = hw::affine2::identity();
+    m_transformed = false;
+}
+
+void hw::draw_list::reset() noexcept
+{
+    m_commands.clear();
+    m_sprites.clear();
+    m_pixels.clear();
+    m_points.clear();
+    m_triangles.clear();
+    m_text.clear();
+    m_colors.clear();
+    m_tiles.clear();
+    m_input_time = 0;
+    m_blend = hw::blend_mode::alpha;
+    this->reset_transform();
+}
+
+void hw::draw_list::clear(hw::color const& t_color)
+{
+    push(draw_command::kind::clear, hw::vec2{}, hw::vec2{}, hw::vec2{},
+         t_color);
+}
+
+void hw::draw_list::point(hw::vec2 const& t_pos, hw::color const& t_color)
+{
+    push(draw_command::kind::point, this->place(t_pos), hw::vec2{}, hw::vec2{},
+         t_color);
+}
+
+void hw::draw_list::line(hw::vec2 const& t_start, hw::vec2 const& t_end,
+                         hw::color const& t_color)
+{
+    push(draw_command::kind::line, this->place(t_start), this->place(t_end),
+         hw::vec2{}, t_color);
+}
+
+void hw::draw_list::triangle(hw::vec2 const& t_first, hw::vec2 const& t_second,
+                             hw::vec2 const& t_third, hw::color const& t_color)
+{
+    push(draw_command::kind::triangle, this->place(t_first),
+         this->place(t_second), this->place(t_third), t_color);
+}
+
+void hw::draw_list::outline_triangle(hw::vec2 const& t_first,
+                                     hw::vec2 const& t_second,
+                                     hw::vec2 const& t_third,
+                                     hw::color const& t_color)
+{
+    push(draw_command::kind::outline_triangle, this->place(t_first),
+         this->place(t_second), this->place(t_third), t_color);
+}
+
+void hw::draw_list::rectangle(hw::vec2 const& t_pos, int const t_width,
+                              int const t_height, hw::color const& t_color)
+{
+    push_rect(draw_command::kind::rectangle, t_pos, hw::vec2{t_width, t_height},
+              t_color);
+}
+
+void hw::draw_list::outline_rectangle(hw::vec2 const& t_pos, int const t_width,
+                                      int const t_height,
+                                      hw::color const& t_color)
+{
+    if(!m_transformed || keeps_axes(m_transform)) {
+        push_rect(draw_command::kind::outline_rectangle, t_pos,
+                  hw::vec2{t_width, t_height}, t_color);
+        return;
+    }
+
+    hw::vec2 const corners[] = {
+        this->place(t_pos), this->place(t_pos + hw::vec2{t_width, 0}),
+        this->place(t_pos + hw::vec2{t_width, t_height}),
+        this->place(t_pos + hw::vec2{0, t_height})};
+
+    for(std::size_t i = 0; i < 4; ++i) {
+        push(draw_command::kind::line, corners[i], corners[(i + 1) % 4],
+             hw::vec2{}, t_color);
+    }
+}
+
+void hw::draw_list::circle(hw::vec2 const& t_pos, int const t_radius,
+                           hw::color const& t_color)
+{
+    int const radius =
+        m_transformed ? static_cast<int>(std::lround(
+                            static_cast<float>(t_radius) *
+                            std::sqrt(std::fabs(m_transform.determinant()))))
+                      : t_radius;
+
+    push(draw_command::kind::circle, this->place(t_pos), hw::vec2{radius, 0},
+         hw::vec2{}, t_color);
+}
+
+void hw::draw_list::outline_circle(hw::vec2 const& t_pos, int const t_radius,
+                                   hw::color const& t_color)
+{
+    int const radius =
+        m_transformed ? static_cast<int>(std::lround(
+                            static_cast<float>(t_radius) *
+                            std::sqrt(std::fabs(m_transform.determinant()))))
+                      : t_radius;
+
+    push(draw_command::kind::outline_circle, this->place(t_pos),
+         hw::vec2{radius, 0}, hw::vec2{}, t_color);
+}
+
+void hw::draw_list::image(std::shared_ptr<hw::texture> const& t_texture,
+                          hw::vec2 const& t_pos, hw::vec2 const& t_dim)
+{
+    push_rect(draw_command::kind::image, t_pos, t_dim, hw::color{});
+    m_commands.back().texture = t_texture;
+}
+
+void hw::draw_list::image(std::shared_ptr<hw::texture> const& t_texture,
+                          hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                          SDL_Rect const& t_frame)
+{
+    this->image(t_texture, t_pos, t_dim);
+    m_commands.back().frame = t_frame;
+}
+
+void hw::draw_list::draw_images(SDL_Renderer* t_renderer,
+                                SDL_Texture* t_handle,
+                                std::size_t const t_first,
+                                std::size_t const t_last) const
+{
+    m_vertices.clear();
+    m_indices.clear();
+
+    SDL_Color const white{255, 255, 255, 255};
+
+    SDL_SetTextureBlendMode(t_handle,
+                            hw::image_blend_mode(m_commands[t_first].blend));
+
+    for(std::size_t i = t_first; i < t_last; ++i) {
+        auto const& cmd = m_commands[i];
+        hw::texture& level = level_of(cmd);
+
+        SDL_FPoint corners[4];
+        get_corners(cmd, m_points, corners);
+
+        push_quad(m_vertices, m_indices, corners, white,
+                  get_uv(level, source_of(level, cmd)));
+    }
+
+    SDL_RenderGeometry(t_renderer, t_handle, m_vertices.data(),
+                       static_cast<int>(m_vertices.size()), m_indices.data(),
+                       static_cast<int>(m_indices.size()));
+}
+
+void hw::draw_list::sprites(std::shared_ptr<hw::texture> const& t_texture,
+                            hw::sprite const* t_sprites,
+                            std::size_t const t_count)
+{
+    if(t_count == 0) {
+        return;
+    }
+
+    push(draw_command::kind::sprites, hw::vec2{}, hw::vec2{}, hw::vec2{},
+         hw::color{});
+
+    auto& cmd = m_commands.back();
+    cmd.texture = t_texture;
+    cmd.offset = m_sprites.size();
+    cmd.count = t_count;
+
+    m_sprites.insert(m_sprites.end(), t_sprites, t_sprites + t_count);
+
+    if(!m_transformed) {
+        return;
+    }
+
+    hw::vec2f const scale = scale_of(m_transform);
+    float const angle =
+        std::atan2(m_transform.b, m_transform.a) * 180.0f / 3.14159265f;
+
+    for(std::size_t i = cmd.offset; i < m_sprites.size(); ++i) {
+        hw::sprite& s = m_sprites[i];
+        hw::vec2f const half{static_cast<float>(s.dim.x) / 2.0f,
+                             static_cast<float>(s.dim.y) / 2.0f};
+        hw::vec2f const center = m_transform * (hw::vec2f{s.pos} + half);
+        hw::vec2f const dim{half.x * 2.0f * scale.x, half.y * 2.0f * scale.y};
+
+        s.pos = to_pixel(center - dim / 2.0f);
+        s.dim = to_pixel(dim);
+        s.angle += angle;
+    }
+}
+
+void hw::draw_list::draw_sprites(SDL_Renderer* t_renderer,
+                                 hw::draw_command const& t_cmd) const
+{
+    SDL_Texture* handle = t_cmd.texture->get(t_renderer);
+
+    if(!handle) {
+        return;
+    }
+
+    m_vertices.clear();
+    m_indices.clear();
+
+    SDL_SetTextureBlendMode(handle, hw::image_blend_mode(t_cmd.blend));
+
+    uv_rect const uv = get_uv(*t_cmd.texture, t_cmd.texture->source());
+    float const to_radians = 3.14159265f / 180.0f;
+
+    for(std::size_t i = t_cmd.offset; i < t_cmd.offset + t_cmd.count; ++i) {
+        hw::sprite const& s = m_sprites[i];
+
+        float const half_w = static_cast<float>(s.dim.x) / 2.0f;
+        float const half_h = static_cast<float>(s.dim.y) / 2.0f;
+        float const cx = static_cast<float>(s.pos.x) + half_w;
+        float const cy = static_cast<float>(s.pos.y) + half_h;
+
+        SDL_FPoint corners[] = {
+            {-half_w, -half_h}, {half_w, -half_h}, {half_w, half_h},
+            {-half_w, half_h}};
+
+        float c = 1.0f;
+        float sn = 0.0f;
+
+        if(s.angle != 0.0f) {
+            c = std::cos(s.angle * to_radians);
+            sn = std::sin(s.angle * to_radians);
+        }
+
+        for(auto& corner : corners) {
+            float const x = corner.x * c - corner.y * sn;
+            float const y = corner.x * sn + corner.y * c;
+            corner.x = cx + x;
+            corner.y = cy + y;
+        }
+
+        SDL_Color const tint{s.tint.r, s.tint.g, s.tint.b, s.tint.a};
+
+        push_quad(m_vertices, m_indices, corners, tint, uv);
+    }
+
+    SDL_RenderGeometry(t_renderer, handle, m_vertices.data(),
+                       static_cast<int>(m_vertices.size()), m_indices.data(),
+                       static_cast<int>(m_indices.size()));
+}
+
+void hw::draw_list::canvas(std::shared_ptr<hw::canvas_texture> const& t_canvas,
+                           hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                           std::uint32_t const* t_pixels)
+{
+    push_rect(draw_command::kind::canvas, t_pos, t_dim, hw::color{});
+
+    auto& cmd = m_commands.back();
+    cmd.canvas = t_canvas;
+
+    if(!t_pixels) {
+        return;
+    }
+
+    std::size_t const count = static_cast<std::size_t>(t_canvas->width()) *
+                              static_cast<std::size_t>(t_canvas->height());
+
+    cmd.offset = m_pixels.size();
+    cmd.count = count;
+
+    m_pixels.insert(m_pixels.end(), t_pixels, t_pixels + count);
+}
+
+void hw::draw_list::draw_canvas(SDL_Renderer* t_renderer,
+                                hw::draw_command const& t_cmd) const
+{
+    SDL_Texture* handle = t_cmd.canvas->get(
+        t_renderer, t_cmd.count > 0 ? &m_pixels[t_cmd.offset] : nullptr);
+
+    if(!handle) {
+        return;
+    }
+
+    set_canvas_blend_mode(handle, t_cmd.blend);
+
+    if(t_cmd.quad) {
+        m_vertices.clear();
+        m_indices.clear();
+
+        SDL_FPoint corners[4];
+        get_corners(t_cmd, m_points, corners);
+        push_quad(m_vertices, m_indices, corners,
+                  SDL_Color{255, 255, 255, 255},
+                  uv_rect{0.0f, 0.0f, 1.0f, 1.0f});
+
+        SDL_RenderGeometry(t_renderer, handle, m_vertices.data(),
+                           static_cast<int>(m_vertices.size()),
+                           m_indices.data(),
+                           static_cast<int>(m_indices.size()));
+        return;
+    }
+
+    SDL_Rect dest;
+    dest.x = t_cmd.first.x;
+    dest.y = t_cmd.first.y;
+    dest.w = t_cmd.second.x;
+    dest.h = t_cmd.second.y;
+
+    SDL_RenderCopy(t_renderer, handle, nullptr, &dest);
+}
+
+void hw::draw_list::polygon(hw::vec2f const* t_points,
+                            std::size_t const t_count, int const* t_triangles,
+                            std::size_t const t_index_count,
+                            hw::color const& t_color)
+{
+    if(t_count < 3 || t_index_count < 3) {
+        return;
+    }
+
+    push(draw_command::kind::polygon, hw::vec2{}, hw::vec2{}, hw::vec2{},
+         t_color);
+
+    auto& cmd = m_commands.back();
+    cmd.points = this->keep_points(t_points, t_count);
+    cmd.point_count = t_count;
+    cmd.offset = m_triangles.size();
+    cmd.count = t_index_count;
+
+    m_triangles.insert(m_triangles.end(), t_triangles,
+                       t_triangles + t_index_count);
+}
+
+void hw::draw_list::shaded_polygon(hw::vec2f const* t_points,
+                                   hw::color const* t_colors,
+                                   std::size_t const t_count,
+                                   int const* t_triangles,
+                                   std::size_t const t_index_count)
+{
+    if(t_count < 3 || t_index_count < 3) {
+        return;
+    }
+
+    this->polygon(t_points, t_count, t_triangles, t_index_count,
+                  hw::color{255, 255, 255, 255});
+
+    auto& cmd = m_commands.back();
+    cmd.shaded = true;
+    cmd.colors = m_colors.size();
+
+    m_colors.insert(m_colors.end(), t_colors, t_colors + t_count);
+}
+
+void hw::draw_list::outline_polygon(hw::vec2f const* t_points,
+                                    std::size_t const t_count,
+                                    hw::color const& t_color)
+{
+    if(t_count < 2) {
+        return;
+    }
+
+    push(draw_command::kind::outline_polygon, hw::vec2{}, hw::vec2{},
+         hw::vec2{}, t_color);
+
+    auto& cmd = m_commands.back();
+    cmd.points = this->keep_points(t_points, t_count);
+    cmd.point_count = t_count;
+}
+
+void hw::draw_list::polyline(hw::vec2f const* t_points,
+                             std::size_t const t_count,
+                             hw::color const& t_color)
+{
+    if(t_count < 2) {
+        return;
+    }
+
+    push(draw_command::kind::polyline, hw::vec2{}, hw::vec2{}, hw::vec2{},
+         t_color);
+
+    auto& cmd = m_commands.back();
+    cmd.points = this->keep_points(t_points, t_count);
+    cmd.point_count = t_count;
+}
+
+void hw::draw_list::text(std::shared_ptr<hw::font> const& t_font,
+                         hw::vec2f const* t_corners, char const* t_glyphs,
+                         std::size_t const t_count, hw::color const& t_color)
+{
+    if(t_count == 0) {
+        return;
+    }
+
+    push(draw_command::kind::text, hw::vec2{}, hw::vec2{}, hw::vec2{},
+         t_color);
+
+    auto& cmd = m_commands.back();
+    cmd.font = t_font;
+    cmd.points = this->keep_points(t_corners, t_count * 4);
+    cmd.point_count = t_count * 4;
+    cmd.offset = m_text.size();
+    cmd.count = t_count;
+
+    m_text.append(t_glyphs, t_count);
+}
+
+void hw::draw_list::draw_text(SDL_Renderer* t_renderer,
+                              hw::draw_command const& t_cmd) const
+{
+    SDL_Texture* handle = t_cmd.font->get(t_renderer);
+
+    if(!handle) {
+        return;
+    }
+
+    m_vertices.clear();
+    m_indices.clear();
+
+    SDL_SetTextureBlendMode(handle, hw::image_blend_mode(t_cmd.blend));
+
+    SDL_Color const color{t_cmd.color.r, t_cmd.color.g, t_cmd.color.b,
+                          t_cmd.color.a};
+
+    for(std::size_t i = 0; i < t_cmd.count; ++i) {
+        hw::glyph_uv const uv = t_cmd.font->uv(m_text[t_cmd.offset + i]);
+        SDL_FPoint corners[4];
+
+        for(std::size_t j = 0; j < 4; ++j) {
+            hw::vec2f const& corner = m_points[t_cmd.points + i * 4 + j];
+            corners[j] = SDL_FPoint{corner.x, corner.y};
+        }
+
+        push_quad(m_vertices, m_indices, corners, color,
+                  uv_rect{uv.u0, uv.v0, uv.u1, uv.v1});
+    }
+
+    SDL_RenderGeometry(t_renderer, handle, m_vertices.data(),
+                       static_cast<int>(m_vertices.size()), m_indices.data(),
+                       static_cast<int>(m_indices.size()));
+}
+
+void hw::draw_list::particles(std::shared_ptr<hw::texture> const& t_texture,
+                              float const* t_x, float const* t_y,
+                              hw::color const* t_colors,
+                              std::size_t const t_count, int const t_size)
+{
+    if(t_count == 0 || t_size <= 0) {
+        return;
+    }
+
+    int const size =
+        m_transformed ? static_cast<int>(std::lround(
+                            static_cast<float>(t_size) *
+                            std::sqrt(std::fabs(m_transform.determinant()))))
+                      : t_size;
+
+    push(draw_command::kind::particles, hw::vec2{}, hw::vec2{size, 0},
+         hw::vec2{}, hw::color{});
+
+    auto& cmd = m_commands.back();
+    cmd.texture = t_texture;
+    cmd.points = m_points.size();
+    cmd.point_count = t_count;
+    cmd.offset = m_colors.size();
+    cmd.count = t_count;
+
+    m_points.resize(cmd.points + t_count);
+
+    hw::vec2f* centers = &m_points[cmd.points];
+
+    for(std::size_t i = 0; i < t_count; ++i) {
+        centers[i] = hw::vec2f{t_x[i], t_y[i]};
+    }
+
+    if(m_transformed) {
+        hw::transform_points(m_transform, centers, centers, t_count);
+    }
+
+    m_colors.insert(m_colors.end(), t_colors, t_colors + t_count);
+}
+
+void hw::draw_list::draw_particles(SDL_Renderer* t_renderer,
+                                   hw::draw_command const& t_cmd) const
+{
+    SDL_Texture* handle{nullptr};
+    uv_rect uv{0.0f, 0.0f, 0.0f, 0.0f};
+
+    if(t_cmd.texture) {
+        handle = t_cmd.texture->get(t_renderer);
+
+        if(!handle) {
+            return;
+        }
+
+        SDL_SetTextureBlendMode(handle, hw::image_blend_mode(t_cmd.blend));
+        uv = get_uv(*t_cmd.texture, t_cmd.texture->source());
+    }
+
+    // written in place instead of with push_quad, there can be a lot of
+    // them
+    m_vertices.resize(t_cmd.count * 4);
+    m_indices.resize(t_cmd.count * 6);
+
+    float const half = static_cast<float>(t_cmd.second.x) / 2.0f;
+
+    for(std::size_t i = 0; i < t_cmd.count; ++i) {
+        hw::vec2f const& center = m_points[t_cmd.points + i];
+        hw::color const& c = m_colors[t_cmd.offset + i];
+        SDL_Color const color{c.r, c.g, c.b, c.a};
+        float const x0 = center.x - half;
+        float const y0 = center.y - half;
+        float const x1 = center.x + half;
+        float const y1 = center.y + half;
+        SDL_Vertex* v = &m_vertices[i * 4];
+        int* index = &m_indices[i * 6];
+        int const base = static_cast<int>(i * 4);
+
+        v[0] = SDL_Vertex{SDL_FPoint{x0, y0}, color, SDL_FPoint{uv.u0, uv.v0}};
+        v[1] = SDL_Vertex{SDL_FPoint{x1, y0}, color, SDL_FPoint{uv.u1, uv.v0}};
+        v[2] = SDL_Vertex{SDL_FPoint{x1, y1}, color, SDL_FPoint{uv.u1, uv.v1}};
+        v[3] = SDL_Vertex{SDL_FPoint{x0, y1}, color, SDL_FPoint{uv.u0, uv.v1}};
+
+        index[0] = base;
+        index[1] = base + 1;
+        index[2] = base + 2;
+        index[3] = base;
+        index[4] = base + 2;
+        index[5] = base + 3;
+    }
+
+    SDL_RenderGeometry(t_renderer, handle, m_vertices.data(),
+                       static_cast<int>(m_vertices.size()), m_indices.data(),
+                       static_cast<int>(m_indices.size()));
+}
+
+void hw::draw_list::chunk(std::shared_ptr<hw::tile_chunk> const& t_chunk,
+                          hw::vec2 const& t_pos,
+                          std::shared_ptr<hw::texture> const& t_tileset,
+                          int const* t_tiles, hw::color const* t_palette,
+                          std::size_t const t_palette_size)
+{
+    push_rect(draw_command::kind::tile_chunk, t_pos,
+              hw::vec2{t_chunk->width(), t_chunk->height()}, hw::color{});
+
+    auto& cmd = m_commands.back();
+    cmd.chunk = t_chunk;
+
+    if(!t_tiles) {
+        return;
+    }
+
+    std::size_t const count = static_cast<std::size_t>(t_chunk->columns()) *
+                              static_cast<std::size_t>(t_chunk->rows());
+
+    cmd.texture = t_tileset;
+    cmd.offset = m_tiles.size();
+    cmd.count = count;
+    cmd.third = hw::vec2{static_cast<int>(m_colors.size()),
+                         static_cast<int>(t_palette_size)};
+
+    m_tiles.insert(m_tiles.end(), t_tiles, t_tiles + count);
+    m_colors.insert(m_colors.end(), t_palette, t_palette + t_palette_size);
+}
+
+void hw::draw_list::draw_chunk(SDL_Renderer* t_renderer,
+                               hw::draw_command const& t_cmd) const
+{
+    SDL_Texture* handle = t_cmd.chunk->get(t_renderer);
+
+    if(!handle) {
+        return;
+    }
+
+    SDL_SetTextureBlendMode(handle, hw::image_blend_mode(t_cmd.blend));
+
+    if(t_cmd.quad) {
+        m_vertices.clear();
+        m_indices.clear();
+
+        SDL_FPoint corners[4];
+        get_corners(t_cmd, m_points, corners);
+        push_quad(m_vertices, m_indices, corners,
+                  SDL_Color{255, 255, 255, 255},
+                  uv_rect{0.0f, 0.0f, 1.0f, 1.0f});
+
+        SDL_RenderGeometry(t_renderer, handle, m_vertices.data(),
+                           static_cast<int>(m_vertices.size()),
+                           m_indices.data(),
+                           static_cast<int>(m_indices.size()));
+        return;
+    }
+
+    SDL_Rect dest;
+    dest.x = t_cmd.first.x;
+    dest.y = t_cmd.first.y;
+    dest.w = t_cmd.second.x;
+    dest.h = t_cmd.second.y;
+
+    SDL_RenderCopy(t_renderer, handle, nullptr, &dest);
+}
+
+void hw::draw_list::draw_geometry(SDL_Renderer* t_renderer,
+                                  std::size_t const t_first,
+                                  std::size_t const t_last) const
+{
+    m_vertices.clear();
+    m_indices.clear();
+
+    uv_rect const no_texture{0.0f, 0.0f, 0.0f, 0.0f};
+
+    for(std::size_t i = t_first; i < t_last; ++i) {
+        auto const& cmd = m_commands[i];
+        SDL_Color const color{cmd.color.r, cmd.color.g, cmd.color.b,
+                              cmd.color.a};
+
+        if(cmd.type == draw_command::kind::rectangle) {
+            SDL_FPoint corners[4];
+            get_corners(cmd, m_points, corners);
+
+            push_quad(m_vertices, m_indices, corners, color, no_texture);
+            continue;
+        }
+
+        int const base = static_cast<int>(m_vertices.size());
+
+        for(std::size_t j = cmd.points; j < cmd.points + cmd.point_count;
+            ++j) {
+            SDL_Color corner = color;
+
+            if(cmd.shaded) {
+                hw::color const& c = m_colors[cmd.colors + (j - cmd.points)];
+                corner = SDL_Color{c.r, c.g, c.b, c.a};
+            }
+
+            m_vertices.push_back(
+                SDL_Vertex{SDL_FPoint{m_points[j].x, m_points[j].y}, corner,
+                           SDL_FPoint{0.0f, 0.0f}});
+        }
+
+        for(std::size_t j = cmd.offset; j < cmd.offset + cmd.count; ++j) {
+            m_indices.push_back(base + m_triangles[j]);
+        }
+    }
+
+    SDL_RenderGeometry(t_renderer, nullptr, m_vertices.data(),
+                       static_cast<int>(m_vertices.size()), m_indices.data(),
+                       static_cast<int>(m_indices.size()));
+}
+
+void hw::draw_list::draw_lines(SDL_Renderer* t_renderer,
+                               hw::draw_command const& t_cmd) const
+{
+    m_line_points.clear();
+
+    for(std::size_t i = t_cmd.points; i < t_cmd.points + t_cmd.point_count;
+        ++i) {
+        m_line_points.push_back(SDL_FPoint{m_points[i].x, m_points[i].y});
+    }
+
+    if(t_cmd.type == draw_command::kind::outline_polygon) {
+        m_line_points.push_back(m_line_points.front());
+    }
+
+    SDL_SetRenderDrawColor(t_renderer, t_cmd.color.r, t_cmd.color.g,
+                           t_cmd.color.b, t_cmd.color.a);
+    SDL_RenderDrawLinesF(t_renderer, m_line_points.data(),
+                         static_cast<int>(m_line_points.size()));
+}
+
+void hw::draw_list::execute(SDL_Renderer* t_renderer) const
+{
+    hw::destroy_pending_textures();
+    // before anything looks at the textures, so the whole frame sees the
+    // same version of each
+    hw::swap_reloaded_textures();
+
+    // uploading can repack the atlas and move images that were already
+    // looked at, so everything is uploaded before anything is drawn
+    for(auto const& cmd : m_commands) {
+        if(cmd.type == draw_command::kind::image ||
+           cmd.type == draw_command::kind::sprites ||
+           (cmd.type == draw_command::kind::particles && cmd.texture)) {
+            cmd.texture->get(t_renderer);
+        }
+
+        if(cmd.type == draw_command::kind::image) {
+            cmd.texture->take_levels();
+            level_of(cmd).get(t_renderer);
+        }
+
+        if(cmd.type == draw_command::kind::text) {
+            cmd.font->get(t_renderer);
+        }
+
+        if(cmd.type == draw_command::kind::tile_chunk && cmd.texture) {
+            cmd.texture->get(t_renderer);
+        }
+    }
+
+    // chunks are drawn into with the renderer's state, which the commands
+    // below set again as they need it
+    for(auto const& cmd : m_commands) {
+        if(cmd.type == draw_command::kind::tile_chunk && cmd.count > 0) {
+            cmd.chunk->render(t_renderer, &m_tiles[cmd.offset],
+                              cmd.texture.get(),
+                              m_colors.data() + cmd.third.x,
+                              static_cast<std::size_t>(cmd.third.y),
+                              m_vertices, m_indices);
+        }
+    }
+
+    hw::trim_textures();
+
+    // the renderer keeps its draw blend mode between frames, so the first
+    // shape always sets it
+    bool shape_blend_known{false};
+    hw::blend_mode shape_blend{hw::blend_mode::alpha};
+
+    for(std::size_t i = 0; i < m_commands.size(); ++i) {
+        auto const& cmd = m_commands[i];
+
+        if(is_shape(cmd.type) &&
+           (!shape_blend_known || cmd.blend != shape_blend)) {
+            set_shape_blend_mode(t_renderer, cmd.blend);
+            shape_blend_known = true;
+            shape_blend = cmd.blend;
+        }
+
+        if(is_geometry(cmd)) {
+            std::size_t last = i + 1;
+
+            while(last < m_commands.size() && is_geometry(m_commands[last]) &&
+                  m_commands[last].blend == cmd.blend) {
+                ++last;
+            }
+
+            this->draw_geometry(t_renderer, i, last);
+            i = last - 1;
+            continue;
+        }
+
+        switch(cmd.type) {
+        case draw_command::kind::clear:
+            SDL_SetRenderDrawColor(t_renderer, cmd.color.r, cmd.color.g,
+                                   cmd.color.b, cmd.color.a);
+            SDL_RenderClear(t_renderer);
+            break;
+        case draw_command::kind::point:
+            hw::draw_point(t_renderer, cmd.first, cmd.color);
+            break;
+        case draw_command::kind::line:
+            hw::draw_line(t_renderer, cmd.first, cmd.second, cmd.color);
+            break;
+        case draw_command::kind::triangle:
+            hw::draw_triangle(t_renderer, cmd.first, cmd.second, cmd.third,
+                              cmd.color);
+            break;
+        case draw_command::kind::outline_triangle:
+            hw::draw_outline_triangle(t_renderer, cmd.first, cmd.second,
+                                      cmd.third, cmd.color);
+            break;
+        case draw_command::kind::rectangle:
+            hw::draw_rectangle(t_renderer, cmd.first, cmd.second.x,
+                               cmd.second.y, cmd.color);
+            break;
+        case draw_command::kind::outline_rectangle:
+            hw::draw_outline_rectangle(t_renderer, cmd.first, cmd.second.x,
+                                       cmd.second.y, cmd.color);
+            break;
+        case draw_command::kind::circle:
+            hw::draw_circle(t_renderer, cmd.first, cmd.second.x, cmd.color);
+            break;
+        case draw_command::kind::outline_circle:
+            hw::draw_outline_circle(t_renderer, cmd.first, cmd.second.x,
+                                    cmd.color);
+            break;
+        case draw_command::kind::image: {
+            hw::texture& level = level_of(cmd);
+            SDL_Texture* handle = level.get(t_renderer);
+
+            if(!handle) {
+                break;
+            }
+
+            std::size_t last = i + 1;
+
+            while(last < m_commands.size() &&
+                  m_commands[last].type == draw_command::kind::image &&
+                  m_commands[last].blend == cmd.blend &&
+                  level_of(m_commands[last]).get(t_renderer) == handle) {
+                ++last;
+            }
+
+            if(last - i > 1 || cmd.quad) {
+                this->draw_images(t_renderer, handle, i, last);
+                i = last - 1;
+                break;
+            }
+
+            SDL_Rect dest;
+            dest.x = cmd.first.x;
+            dest.y = cmd.first.y;
+            dest.w = cmd.second.x;
+            dest.h = cmd.second.y;
+
+            SDL_Rect const source = source_of(level, cmd);
+
+            SDL_SetTextureBlendMode(handle, hw::image_blend_mode(cmd.blend));
+            SDL_RenderCopy(t_renderer, handle, &source, &dest);
+            break;
+        }
+        case draw_command::kind::sprites:
+            this->draw_sprites(t_renderer, cmd);
+            break;
+        case draw_command::kind::canvas:
+            this->draw_canvas(t_renderer, cmd);
+            break;
+        case draw_command::kind::polygon:
+            // filled with the other geometry above
+            break;
+        case draw_command::kind::outline_polygon:
+        case draw_command::kind::polyline:
+            this->draw_lines(t_renderer, cmd);
+            break;
+        case draw_command::kind::text:
+            this->draw_text(t_renderer, cmd);
+            break;
+        case draw_command::kind::particles:
+            this->draw_particles(t_renderer, cmd);
+            break;
+        case draw_command::kind::tile_chunk:
+            this->draw_chunk(t_renderer, cmd);
+            break;
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#include "file_watcher.hpp"
+
+///
+/// @file file_watcher.cpp
+///
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+hw::file_watcher::file_watcher()
+    : m_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+}
+
+hw::file_watcher::~file_watcher() noexcept
+{
+    if(m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+std::string hw::file_watcher::watch(std::string const& t_path)
+{
+    char resolved[PATH_MAX];
+
+    if(m_fd < 0 || realpath(t_path.c_str(), resolved) == nullptr) {
+        return std::string{};
+    }
+
+    std::string const path{resolved};
+    std::string const directory = path.substr(0, path.find_last_of('/'));
+
+    // watching the same directory again gives back the same descriptor
+    int const wd = inotify_add_watch(m_fd, directory.c_str(),
+                                     IN_CLOSE_WRITE | IN_MOVED_TO);
+
+    if(wd < 0) {
+        return std::string{};
+    }
+
+    m_directories[wd] = directory;
+
+    return path;
+}
+
+void hw::file_watcher::poll(std::vector<std::string>& t_changed)
+{
+    if(m_fd < 0) {
+        return;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+
+    while(true) {
+        ssize_t const length = read(m_fd, buffer, sizeof(buffer));
+
+        if(length <= 0) {
+            break;
+        }
+
+        for(ssize_t offset = 0; offset < length;) {
+            auto const* event =
+                reinterpret_cast<inotify_event const*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            auto const dir = m_directories.find(event->wd);
+
+            if(event->len == 0 || dir == m_directories.end()) {
+                continue;
+            }
+
+            std::string path = dir->second + '/' + event->name;
+
+            if(std::find(t_changed.begin(), t_changed.end(), path) ==
+               t_changed.end()) {
+                t_changed.push_back(std::move(path));
+            }
+        }
+    }
+}
+
+#else
+
+hw::file_watcher::file_watcher()
+{
+}
+
+hw::file_watcher::~file_watcher() noexcept
+{
+}
+
+std::string hw::file_watcher::watch(std::string const&)
+{
+    return std::string{};
+}
+
+void hw::file_watcher::poll(std::vector<std::string>&)
+{
+}
+
+#endif
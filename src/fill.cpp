@@ -0,0 +1,445 @@
+#include "fill.hpp"
+
+///
+/// @file fill.cpp
+///
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HW_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+// Colors are mixed the way hw::lerp_colors does it, with a weight out of
+// 256. The vectorized spans do the same integer math in floats, which hold
+// every value involved exactly, so both give the same pixels.
+
+namespace {
+    ///
+    /// @brief Pixels between mesh points when blending is not exact, small
+    ///        enough that the corners of the blended colors don't show.
+    ///
+    constexpr float mesh_spacing{16.0f};
+    ///
+    /// @brief Limits how many cells one edge is split into, for huge shapes
+    ///        or tiny spacings.
+    ///
+    constexpr int max_cells{128};
+
+    inline int weight_of(float const t_amount) noexcept
+    {
+        float const clamped = std::max(0.0f, std::min(t_amount, 1.0f));
+        return static_cast<int>(clamped * 256.0f + 0.5f);
+    }
+
+    inline std::uint8_t mix(std::uint8_t const t_from, std::uint8_t const t_to,
+                            int const t_weight) noexcept
+    {
+        int const from = t_from;
+        int const to = t_to;
+
+        return static_cast<std::uint8_t>(
+            (from * 256 + (to - from) * t_weight + 128) >> 8);
+    }
+
+    inline hw::color mix(hw::color const& t_from, hw::color const& t_to,
+                         int const t_weight) noexcept
+    {
+        return hw::color{mix(t_from.r, t_to.r, t_weight),
+                         mix(t_from.g, t_to.g, t_weight),
+                         mix(t_from.b, t_to.b, t_weight),
+                         mix(t_from.a, t_to.a, t_weight)};
+    }
+
+    int cells(float const t_length, float const t_spacing) noexcept
+    {
+        float const count = std::ceil(std::fabs(t_length) / t_spacing);
+
+        if(!(count > 1.0f)) {
+            return 1;
+        }
+
+        return static_cast<int>(std::min(count, static_cast<float>(max_cells)));
+    }
+
+#ifdef HW_HAS_SSE2
+    ///
+    /// @brief One channel of the colors of 4 pixels, mixed by the weights
+    ///        in @ref t_weights(whole numbers from 0 to 256).
+    ///
+    struct channel_mix
+    {
+        __m128 base;
+        __m128 difference;
+
+        channel_mix(std::uint8_t const t_from, std::uint8_t const t_to) noexcept
+            : base(_mm_set1_ps(static_cast<float>(t_from) * 256.0f + 128.0f))
+            , difference(_mm_set1_ps(static_cast<float>(t_to) -
+                                     static_cast<float>(t_from)))
+        {
+        }
+
+        inline __m128i operator()(__m128 const t_weights) const noexcept
+        {
+            // never negative, truncating is the shift of the scalar mix
+            __m128 const sum =
+                _mm_add_ps(base, _mm_mul_ps(difference, t_weights));
+
+            return _mm_cvttps_epi32(
+                _mm_mul_ps(sum, _mm_set1_ps(1.0f / 256.0f)));
+        }
+    };
+
+    ///
+    /// @brief Turns 4 amounts into ARGB8888 pixels, like @ref weight_of
+    ///        and @ref mix.
+    ///
+    inline __m128i to_pixels(__m128 const t_amounts, channel_mix const& t_a,
+                             channel_mix const& t_r, channel_mix const& t_g,
+                             channel_mix const& t_b) noexcept
+    {
+        __m128 const clamped = _mm_max_ps(
+            _mm_setzero_ps(), _mm_min_ps(t_amounts, _mm_set1_ps(1.0f)));
+        __m128 const weights = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_add_ps(
+            _mm_mul_ps(clamped, _mm_set1_ps(256.0f)), _mm_set1_ps(0.5f))));
+
+        return _mm_or_si128(
+            _mm_or_si128(_mm_slli_epi32(t_a(weights), 24),
+                         _mm_slli_epi32(t_r(weights), 16)),
+            _mm_or_si128(_mm_slli_epi32(t_g(weights), 8), t_b(weights)));
+    }
+#endif
+} // namespace
+
+hw::fill_style hw::fill_style::linear(hw::vec2f const& t_start,
+                                      hw::color const& t_from,
+                                      hw::vec2f const& t_end,
+                                      hw::color const& t_to)
+{
+    hw::fill_style result{};
+
+    result.m_type = kind::linear;
+    result.m_start = t_start;
+    result.m_end = t_end;
+    result.m_from = t_from;
+    result.m_to = t_to;
+
+    return result;
+}
+
+hw::fill_style hw::fill_style::radial(hw::vec2f const& t_center,
+                                      float const t_radius,
+                                      hw::color const& t_inner,
+                                      hw::color const& t_outer)
+{
+    hw::fill_style result{};
+
+    result.m_type = kind::radial;
+    result.m_start = t_center;
+    // a radius of 0 is all the outer color, without dividing by 0
+    result.m_radius = std::max(std::fabs(t_radius),
+                               std::numeric_limits<float>::min());
+    result.m_from = t_inner;
+    result.m_to = t_outer;
+
+    return result;
+}
+
+hw::fill_style hw::fill_style::function(
+    std::function<hw::color(hw::vec2f const&)> t_function)
+{
+    hw::fill_style result{};
+
+    result.m_type = t_function ? kind::function : kind::flat;
+    result.m_function = std::move(t_function);
+
+    return result;
+}
+
+float hw::fill_style::amount(hw::vec2f const& t_pos) const noexcept
+{
+    if(m_type == kind::radial) {
+        return hw::length(t_pos - m_start) / m_radius;
+    }
+
+    hw::vec2f const direction = m_end - m_start;
+    float const length = hw::length_squared(direction);
+
+    if(!(length > 0.0f)) {
+        return 0.0f;
+    }
+
+    hw::vec2f const scaled = direction / length;
+
+    return (t_pos.x - m_start.x) * scaled.x + (t_pos.y - m_start.y) * scaled.y;
+}
+
+hw::color hw::fill_style::at(hw::vec2f const& t_pos) const
+{
+    switch(m_type) {
+    case kind::flat:
+        return m_from;
+    case kind::linear:
+    case kind::radial:
+        return mix(m_from, m_to, weight_of(this->amount(t_pos)));
+    case kind::function:
+        return m_function(t_pos);
+    }
+
+    return m_from;
+}
+
+void hw::fill_style::colors(hw::vec2f const* t_points,
+                            std::size_t const t_count, hw::color* t_out) const
+{
+    for(std::size_t i = 0; i < t_count; ++i) {
+        t_out[i] = this->at(t_points[i]);
+    }
+}
+
+void hw::fill_style::span(float const t_x, float const t_y,
+                          std::uint32_t* t_out,
+                          std::size_t const t_count) const
+{
+    if(m_type == kind::flat || m_type == kind::function) {
+        this->span_scalar(t_x, t_y, t_out, t_count);
+        return;
+    }
+
+    std::size_t i{0};
+
+#ifdef HW_HAS_SSE2
+    channel_mix const a{m_from.a, m_to.a};
+    channel_mix const r{m_from.r, m_to.r};
+    channel_mix const g{m_from.g, m_to.g};
+    channel_mix const b{m_from.b, m_to.b};
+
+    __m128 const x = _mm_set1_ps(t_x);
+    __m128 const start_x = _mm_set1_ps(m_start.x);
+    // whole numbers, so stepping them is exact and the same as the scalar
+    // t_x + i
+    __m128 offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    __m128 const four = _mm_set1_ps(4.0f);
+
+    if(m_type == kind::linear) {
+        hw::vec2f const direction = m_end - m_start;
+        float const length = hw::length_squared(direction);
+        hw::vec2f const scaled =
+            length > 0.0f ? direction / length : hw::vec2f{0.0f, 0.0f};
+
+        // the part that only depends on the row
+        __m128 const row = _mm_set1_ps((t_y - m_start.y) * scaled.y);
+        __m128 const step = _mm_set1_ps(scaled.x);
+
+        for(; i + 4 <= t_count; i += 4) {
+            __m128 const dx = _mm_sub_ps(_mm_add_ps(x, offsets), start_x);
+            __m128 const amounts = _mm_add_ps(_mm_mul_ps(dx, step), row);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(t_out + i),
+                             to_pixels(amounts, a, r, g, b));
+            offsets = _mm_add_ps(offsets, four);
+        }
+    }
+    else {
+        float const dy = t_y - m_start.y;
+        __m128 const dy2 = _mm_set1_ps(dy * dy);
+        __m128 const radius = _mm_set1_ps(m_radius);
+
+        for(; i + 4 <= t_count; i += 4) {
+            __m128 const dx = _mm_sub_ps(_mm_add_ps(x, offsets), start_x);
+            __m128 const amounts = _mm_div_ps(
+                _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), dy2)), radius);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(t_out + i),
+                             to_pixels(amounts, a, r, g, b));
+            offsets = _mm_add_ps(offsets, four);
+        }
+    }
+#endif
+
+    for(; i < t_count; ++i) {
+        t_out[i] = hw::to_argb(
+            this->at(hw::vec2f{t_x + static_cast<float>(i), t_y}));
+    }
+}
+
+void hw::fill_style::span_scalar(float const t_x, float const t_y,
+                                 std::uint32_t* t_out,
+                                 std::size_t const t_count) const
+{
+    for(std::size_t i = 0; i < t_count; ++i) {
+        t_out[i] = hw::to_argb(
+            this->at(hw::vec2f{t_x + static_cast<float>(i), t_y}));
+    }
+}
+
+float hw::fill_style::spacing(hw::vec2f const& t_min,
+                              hw::vec2f const& t_max) const noexcept
+{
+    float const exact = std::numeric_limits<float>::max();
+
+    if(m_type == kind::flat) {
+        return exact;
+    }
+
+    if(m_type != kind::linear) {
+        return mesh_spacing;
+    }
+
+    // the amount changes linearly, so blending the corners is exact unless
+    // it stops changing somewhere inside(past either end)
+    hw::vec2f const corners[] = {t_min, hw::vec2f{t_max.x, t_min.y}, t_max,
+                                 hw::vec2f{t_min.x, t_max.y}};
+
+    for(auto const& corner : corners) {
+        float const amount = this->amount(corner);
+
+        if(amount < 0.0f || amount > 1.0f) {
+            return mesh_spacing;
+        }
+    }
+
+    return exact;
+}
+
+void hw::mesh_rectangle(hw::vec2f const& t_pos, hw::vec2f const& t_dim,
+                        float const t_spacing,
+                        std::vector<hw::vec2f>& t_points,
+                        std::vector<int>& t_triangles)
+{
+    int const columns = cells(t_dim.x, t_spacing);
+    int const rows = cells(t_dim.y, t_spacing);
+    int const base = static_cast<int>(t_points.size());
+
+    for(int row = 0; row <= rows; ++row) {
+        float const y = t_pos.y + t_dim.y * static_cast<float>(row) /
+                                      static_cast<float>(rows);
+
+        for(int column = 0; column <= columns; ++column) {
+            float const x = t_pos.x + t_dim.x * static_cast<float>(column) /
+                                          static_cast<float>(columns);
+            t_points.push_back(hw::vec2f{x, y});
+        }
+    }
+
+    for(int row = 0; row < rows; ++row) {
+        for(int column = 0; column < columns; ++column) {
+            int const top_left = base + row * (columns + 1) + column;
+            int const bottom_left = top_left + columns + 1;
+            int const quad[] = {top_left,    top_left + 1,    bottom_left + 1,
+                                top_left,    bottom_left + 1, bottom_left};
+
+            t_triangles.insert(t_triangles.end(), quad, quad + 6);
+        }
+    }
+}
+
+void hw::mesh_circle(hw::vec2f const& t_center, float const t_radius,
+                     float const t_spacing, float const t_tolerance,
+                     std::vector<hw::vec2f>& t_points,
+                     std::vector<int>& t_triangles)
+{
+    float const pi = 3.14159265f;
+    float const radius = std::fabs(t_radius);
+
+    // a chord of angle a is radius * (1 - cos(a / 2)) away from the circle
+    float step = pi / 4.0f;
+
+    if(radius > t_tolerance) {
+        step = std::min(step, 2.0f * std::acos(1.0f - t_tolerance / radius));
+    }
+
+    int const segments =
+        std::max(8, std::min(static_cast<int>(std::ceil(2.0f * pi / step)),
+                             max_cells * 8));
+    int const rings = cells(radius, t_spacing);
+    int const center = static_cast<int>(t_points.size());
+
+    t_points.push_back(t_center);
+
+    for(int ring = 1; ring <= rings; ++ring) {
+        float const r =
+            radius * static_cast<float>(ring) / static_cast<float>(rings);
+
+        for(int i = 0; i < segments; ++i) {
+            float const angle = 2.0f * pi * static_cast<float>(i) /
+                                static_cast<float>(segments);
+            t_points.push_back(t_center + hw::vec2f{r * std::cos(angle),
+                                                    r * std::sin(angle)});
+        }
+    }
+
+    for(int i = 0; i < segments; ++i) {
+        int const fan[] = {center, center + 1 + i,
+                           center + 1 + (i + 1) % segments};
+        t_triangles.insert(t_triangles.end(), fan, fan + 3);
+    }
+
+    for(int ring = 1; ring < rings; ++ring) {
+        int const inner = center + 1 + (ring - 1) * segments;
+        int const outer = inner + segments;
+
+        for(int i = 0; i < segments; ++i) {
+            int const next = (i + 1) % segments;
+            int const quad[] = {inner + i,    outer + i,    outer + next,
+                                inner + i,    outer + next, inner + next};
+
+            t_triangles.insert(t_triangles.end(), quad, quad + 6);
+        }
+    }
+}
+
+void hw::mesh_triangles(hw::vec2f const* t_corners,
+                        int const* t_corner_triangles,
+                        std::size_t const t_index_count,
+                        float const t_spacing,
+                        std::vector<hw::vec2f>& t_points,
+                        std::vector<int>& t_triangles)
+{
+    for(std::size_t t = 0; t + 3 <= t_index_count; t += 3) {
+        hw::vec2f const& a = t_corners[t_corner_triangles[t]];
+        hw::vec2f const& b = t_corners[t_corner_triangles[t + 1]];
+        hw::vec2f const& c = t_corners[t_corner_triangles[t + 2]];
+
+        float const longest = std::sqrt(std::max(
+            hw::length_squared(b - a),
+            std::max(hw::length_squared(c - b), hw::length_squared(a - c))));
+        int const n = cells(longest, t_spacing);
+        int const base = static_cast<int>(t_points.size());
+
+        // row i holds the points i / n of the way from a to b, with j / n
+        // of the way from a to c added, while i + j <= n
+        for(int i = 0; i <= n; ++i) {
+            for(int j = 0; i + j <= n; ++j) {
+                float const u = static_cast<float>(i) / static_cast<float>(n);
+                float const v = static_cast<float>(j) / static_cast<float>(n);
+
+                t_points.push_back(a + (b - a) * u + (c - a) * v);
+            }
+        }
+
+        auto const index = [base, n](int const t_i, int const t_j) {
+            // rows before t_i hold n + 1, n, ... n - t_i + 2 points
+            return base + t_i * (n + 1) - t_i * (t_i - 1) / 2 + t_j;
+        };
+
+        for(int i = 0; i < n; ++i) {
+            for(int j = 0; i + j < n; ++j) {
+                int const lower[] = {index(i, j), index(i + 1, j),
+                                     index(i, j + 1)};
+                t_triangles.insert(t_triangles.end(), lower, lower + 3);
+
+                if(i + j + 1 < n) {
+                    int const upper[] = {index(i + 1, j), index(i + 1, j + 1),
+                                         index(i, j + 1)};
+                    t_triangles.insert(t_triangles.end(), upper, upper + 3);
+                }
+            }
+        }
+    }
+}
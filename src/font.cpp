@@ -0,0 +1,271 @@
+#include "font.hpp"
+
+///
+/// @file font.cpp
+///
+
+#include <algorithm>
+
+namespace {
+    ///
+    /// @brief Printable ASCII from font8x8_basic by Daniel Hepper, which is
+    ///        in the public domain.
+    ///
+    /// One byte per row, the lowest bit is the leftmost pixel.
+    ///
+    std::uint8_t const g_font8x8[96][8] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // space
+        {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00}, // !
+        {0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // "
+        {0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00}, // #
+        {0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00}, // $
+        {0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00}, // %
+        {0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00}, // &
+        {0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00}, // '
+        {0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00}, // (
+        {0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00}, // )
+        {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00}, // *
+        {0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00}, // +
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06}, // ,
+        {0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00}, // -
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // .
+        {0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00}, // /
+        {0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00}, // 0
+        {0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00}, // 1
+        {0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00}, // 2
+        {0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00}, // 3
+        {0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00}, // 4
+        {0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00}, // 5
+        {0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00}, // 6
+        {0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00}, // 7
+        {0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00}, // 8
+        {0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00}, // 9
+        {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // :
+        {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06}, // ;
+        {0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00}, // <
+        {0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00}, // =
+        {0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00}, // >
+        {0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00}, // ?
+        {0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00}, // @
+        {0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00}, // A
+        {0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00}, // B
+        {0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00}, // C
+        {0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00}, // D
+        {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00}, // E
+        {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00}, // F
+        {0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00}, // G
+        {0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00}, // H
+        {0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // I
+        {0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00}, // J
+        {0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00}, // K
+        {0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00}, // L
+        {0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00}, // M
+        {0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00}, // N
+        {0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00}, // O
+        {0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00}, // P
+        {0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00}, // Q
+        {0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00}, // R
+        {0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00}, // S
+        {0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // T
+        {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00}, // U
+        {0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00}, // V
+        {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00}, // W
+        {0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00}, // X
+        {0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00}, // Y
+        {0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00}, // Z
+        {0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00}, // [
+        {0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00}, // backslash
+        {0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00}, // ]
+        {0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00}, // ^
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF}, // _
+        {0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00}, // `
+        {0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00}, // a
+        {0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00}, // b
+        {0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00}, // c
+        {0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00}, // d
+        {0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00}, // e
+        {0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00}, // f
+        {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F}, // g
+        {0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00}, // h
+        {0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // i
+        {0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E}, // j
+        {0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00}, // k
+        {0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // l
+        {0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00}, // m
+        {0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00}, // n
+        {0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00}, // o
+        {0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F}, // p
+        {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78}, // q
+        {0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00}, // r
+        {0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00}, // s
+        {0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00}, // t
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00}, // u
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00}, // v
+        {0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00}, // w
+        {0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00}, // x
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F}, // y
+        {0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00}, // z
+        {0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00}, // {
+        {0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00}, // |
+        {0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00}, // }
+        {0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ~
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // DEL
+    };
+
+    constexpr int builtin_columns{16};
+} // namespace
+
+std::shared_ptr<hw::font> const& hw::font::builtin()
+{
+    // never destroyed, shapes drawing text may outlive everything else and
+    // the renderer is gone by then anyway
+    static std::shared_ptr<hw::font>* const instance = [] {
+        std::shared_ptr<hw::font> result{new hw::font{}};
+        int const count = static_cast<int>(sizeof(g_font8x8) / 8);
+        int const rows = (count + builtin_columns - 1) / builtin_columns;
+        int const width = builtin_columns * 8;
+
+        result->m_glyph = hw::vec2{8, 8};
+        result->m_first = ' ';
+        result->m_count = count;
+        result->m_canvas =
+            std::make_shared<hw::canvas_texture>(width, rows * 8);
+        result->m_pixels.assign(static_cast<std::size_t>(width * rows * 8),
+                                0x00FFFFFFu);
+
+        for(int i = 0; i < count; ++i) {
+            int const left = (i % builtin_columns) * 8;
+            int const top = (i / builtin_columns) * 8;
+
+            for(int y = 0; y < 8; ++y) {
+                for(int x = 0; x < 8; ++x) {
+                    if((g_font8x8[i][y] >> x) & 1) {
+                        result->m_pixels[static_cast<std::size_t>(
+                            (top + y) * width + left + x)] = 0xFFFFFFFFu;
+                    }
+                }
+            }
+        }
+
+        return new std::shared_ptr<hw::font>{result};
+    }();
+
+    return *instance;
+}
+
+std::shared_ptr<hw::font> hw::font::from_image(std::string const& t_path,
+                                               int const t_glyph_width,
+                                               int const t_glyph_height,
+                                               char const t_first,
+                                               hw::color const& t_color_key)
+{
+    std::shared_ptr<hw::font> result{new hw::font{}};
+
+    result->m_glyph = hw::vec2{std::max(1, t_glyph_width),
+                               std::max(1, t_glyph_height)};
+    result->m_first = t_first;
+    result->m_texture = hw::load_texture(t_path, t_color_key);
+
+    return result;
+}
+
+void hw::font::layout(std::string const& t_text, hw::vec2 const& t_pos,
+                      int const t_scale, std::vector<hw::vec2f>& t_corners,
+                      std::string& t_glyphs) const
+{
+    t_corners.clear();
+    t_glyphs.clear();
+
+    float const width = static_cast<float>(m_glyph.x * t_scale);
+    float const height = static_cast<float>(m_glyph.y * t_scale);
+    float x = static_cast<float>(t_pos.x);
+    float y = static_cast<float>(t_pos.y);
+
+    for(char const c : t_text) {
+        if(c == '\n') {
+            x = static_cast<float>(t_pos.x);
+            y += height;
+            continue;
+        }
+
+        if(c != ' ') {
+            int const index = static_cast<unsigned char>(c) - m_first;
+            bool const known =
+                index >= 0 && (m_count == 0 || index < m_count);
+
+            t_corners.push_back(hw::vec2f{x, y});
+            t_corners.push_back(hw::vec2f{x + width, y});
+            t_corners.push_back(hw::vec2f{x + width, y + height});
+            t_corners.push_back(hw::vec2f{x, y + height});
+            t_glyphs.push_back(known ? c : '?');
+        }
+
+        x += width;
+    }
+}
+
+hw::vec2 hw::font::measure(std::string const& t_text,
+                           int const t_scale) const noexcept
+{
+    int columns{0};
+    int longest{0};
+    int lines{t_text.empty() ? 0 : 1};
+
+    for(char const c : t_text) {
+        if(c == '\n') {
+            columns = 0;
+            ++lines;
+            continue;
+        }
+
+        longest = std::max(longest, ++columns);
+    }
+
+    return hw::vec2{longest * m_glyph.x * t_scale, lines * m_glyph.y * t_scale};
+}
+
+SDL_Texture* hw::font::get(SDL_Renderer* t_renderer)
+{
+    if(m_canvas) {
+        return m_canvas->get(t_renderer, m_canvas->needs_pixels()
+                                             ? m_pixels.data()
+                                             : nullptr);
+    }
+
+    return m_texture->get(t_renderer);
+}
+
+hw::glyph_uv hw::font::uv(char const t_glyph) const noexcept
+{
+    SDL_Rect image{0, 0, 0, 0};
+    float backing_width{0.0f};
+    float backing_height{0.0f};
+
+    if(m_canvas) {
+        image.w = m_canvas->width();
+        image.h = m_canvas->height();
+        backing_width = static_cast<float>(image.w);
+        backing_height = static_cast<float>(image.h);
+    }
+    else {
+        image = m_texture->source();
+        backing_width = static_cast<float>(m_texture->backing_width());
+        backing_height = static_cast<float>(m_texture->backing_height());
+    }
+
+    int const columns = std::max(1, image.w / m_glyph.x);
+    int const index = static_cast<unsigned char>(t_glyph) - m_first;
+
+    if(index < 0 || backing_width <= 0.0f || backing_height <= 0.0f) {
+        return hw::glyph_uv{0.0f, 0.0f, 0.0f, 0.0f};
+    }
+
+    float const x =
+        static_cast<float>(image.x + (index % columns) * m_glyph.x);
+    float const y =
+        static_cast<float>(image.y + (index / columns) * m_glyph.y);
+
+    return hw::glyph_uv{x / backing_width, y / backing_height,
+                        (x + static_cast<float>(m_glyph.x)) / backing_width,
+                        (y + static_cast<float>(m_glyph.y)) / backing_height};
+}
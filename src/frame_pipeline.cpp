@@ -0,0 +1,113 @@
+#include "frame_pipeline.hpp"
+
+///
+/// @file frame_pipeline.cpp
+///
+
+#include "profiling.hpp"
+
+namespace {
+    void report_input_latency(hw::draw_list const& t_list)
+    {
+        if(t_list.input_time() == 0) {
+            return;
+        }
+
+        hw::record_input_latency(
+            static_cast<double>(SDL_GetTicks() - t_list.input_time()));
+    }
+} // namespace
+
+hw::frame_pipeline::frame_pipeline(hw::window& t_window, int const t_latency)
+    : m_window(t_window)
+    , m_lists(static_cast<std::size_t>(t_latency > 0 ? t_latency + 1 : 1))
+{
+    if(this->latency() > 0) {
+        // the renderer has to be created by the thread that uses it
+        m_window.destroy_renderer();
+        m_thread = std::thread{&frame_pipeline::run, this};
+    }
+}
+
+hw::frame_pipeline::~frame_pipeline()
+{
+    if(!m_thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_stop = true;
+    }
+
+    m_submitted.notify_one();
+    m_thread.join();
+}
+
+void hw::frame_pipeline::run()
+{
+    m_window.create_renderer();
+
+    while(true) {
+        std::size_t current{0};
+
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_submitted.wait(lock, [this] { return m_pending > 0 || m_stop; });
+
+            if(m_pending == 0) {
+                break;
+            }
+
+            --m_pending;
+            current = m_next_to_render;
+            m_next_to_render = (m_next_to_render + 1) % m_lists.size();
+        }
+
+        m_lists[current].execute(m_window.get_renderer());
+        m_window.present();
+        report_input_latency(m_lists[current]);
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            --m_in_flight;
+        }
+
+        m_presented.notify_all();
+    }
+
+    m_window.destroy_renderer();
+}
+
+void hw::frame_pipeline::submit()
+{
+    if(!m_thread.joinable()) {
+        m_lists[m_recording].execute(m_window.get_renderer());
+        m_window.present();
+        report_input_latency(m_lists[m_recording]);
+        m_lists[m_recording].reset();
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+
+        ++m_pending;
+        ++m_in_flight;
+        m_recording = (m_recording + 1) % m_lists.size();
+        m_submitted.notify_one();
+
+        // the list after the one just submitted is free once there are at
+        // most 'latency' frames waiting to be presented
+        m_presented.wait(lock,
+                         [this] { return m_in_flight < m_lists.size(); });
+    }
+
+    m_lists[m_recording].reset();
+}
+
+void hw::frame_pipeline::finish()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_presented.wait(lock, [this] { return m_in_flight == 0; });
+}
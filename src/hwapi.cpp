@@ -1,14 +1,19 @@
 #include "hwapi.hpp"
 #include "window.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <iterator>
 #include <string>
+#include <thread>
 #include <utility>
 
 #include "SDL2/SDL_image.h"
 
-#include "drawing_api.hpp"
+#include "frame_pipeline.hpp"
+#include "triangulate.hpp"
 
 ///
 /// @file hwapi.cpp
@@ -68,6 +73,33 @@ inline namespace globals {
     /// destructor is non trivial and it adds shapes to the global vector.
     ///
     bool g_inside_draw_call{false};
+    ///
+    /// Where shapes are recorded during the current frame, see
+    /// @ref hw::draw_list.
+    ///
+    hw::draw_list* g_draw_list{nullptr};
+    ///
+    /// See @ref dummy_api::set_frame_latency.
+    ///
+    int g_frame_latency{0};
+    ///
+    /// See @ref dummy_api::set_low_latency.
+    ///
+    bool g_low_latency{false};
+    double g_input_wait{0.0};
+    ///
+    /// See @ref dummy_api::set_hot_reload.
+    ///
+    bool g_hot_reload{false};
+    ///
+    /// Seconds since the last frame, what the drawing loop is called with.
+    /// Animated shapes advance by this much when they are drawn.
+    ///
+    double g_elapsed_time{0.0};
+    ///
+    /// See @ref dummy_api::set_blend_mode.
+    ///
+    hw::blend_mode g_blend_mode{hw::blend_mode::alpha};
 } // namespace globals
 
 namespace dummy_api {
@@ -79,6 +111,10 @@ namespace dummy_api {
 
     std::vector<std::unique_ptr<da::Shape>>& get_anon_shapes()
     {
+        // anonymous shapes remove themselves from get_shapes when they are
+        // destroyed at exit, so it must be created first to outlive them
+        get_shapes();
+
         static std::vector<std::unique_ptr<da::Shape>> shapes;
         return shapes;
     }
@@ -118,6 +154,87 @@ namespace dummy_api {
         return g_background;
     }
 
+    void set_frame_latency(int const t_frames) noexcept
+    {
+        g_frame_latency = t_frames < 0 ? 0 : t_frames;
+    }
+
+    int get_frame_latency() noexcept
+    {
+        return g_frame_latency;
+    }
+
+    void set_low_latency(bool const t_enabled, double const t_wait) noexcept
+    {
+        g_low_latency = t_enabled;
+        g_input_wait = std::max(0.0, std::min(t_wait, 0.9));
+    }
+
+    bool get_low_latency() noexcept
+    {
+        return g_low_latency;
+    }
+
+    void preload(std::string const& t_path, hw::color const& t_color_key)
+    {
+        static std::vector<std::shared_ptr<hw::texture>> preloaded;
+        preloaded.push_back(hw::load_texture(t_path, t_color_key));
+    }
+
+    void wait_all()
+    {
+        hw::wait_for_textures();
+    }
+
+    void set_hot_reload(bool const t_enabled)
+    {
+        g_hot_reload = t_enabled;
+        hw::set_texture_hot_reload(t_enabled);
+    }
+
+    void set_texture_budget(std::size_t const t_megabytes)
+    {
+        hw::set_texture_budget(t_megabytes * 1024 * 1024);
+    }
+
+    void set_blend_mode(hw::blend_mode const t_mode)
+    {
+        g_blend_mode = t_mode;
+
+        if(g_draw_list != nullptr) {
+            g_draw_list->set_blend_mode(t_mode);
+        }
+    }
+
+    hw::blend_mode get_blend_mode() noexcept
+    {
+        return g_blend_mode;
+    }
+
+    void push_transform(hw::affine2 const& t_transform)
+    {
+        if(g_inside_draw_call) {
+            g_draw_list->push_transform(t_transform);
+        }
+    }
+
+    void pop_transform()
+    {
+        if(g_inside_draw_call) {
+            g_draw_list->pop_transform();
+        }
+    }
+
+    bool load_pack(std::string const& t_path)
+    {
+        return hw::mount_asset_pack(t_path);
+    }
+
+    hw::draw_list* get_draw_list() noexcept
+    {
+        return g_draw_list;
+    }
+
     void draw_shapes()
     {
         for(auto& shape : get_shapes()) {
@@ -125,6 +242,58 @@ namespace dummy_api {
         }
     }
 
+    ///
+    /// @brief One iteration of the main loop, shared by @ref draw and
+    ///        @ref draw_to_file.
+    ///
+    static void render_frame(hw::window& t_window,
+                             hw::frame_pipeline& t_pipeline,
+                             std::function<void(double)> const& t_call,
+                             double const t_elapsed_time)
+    {
+        if(g_low_latency) {
+            t_window.handle_events();
+        }
+
+        if(g_hot_reload) {
+            hw::reload_changed_textures();
+        }
+
+        g_draw_list = &t_pipeline.record();
+        g_draw_list->set_input_time(t_window.input_time());
+        g_draw_list->clear(t_window.get_bgcolor());
+        g_draw_list->set_blend_mode(g_blend_mode);
+        g_elapsed_time = t_elapsed_time;
+
+        t_call(t_elapsed_time);
+
+        // kept shapes are placed by their groups, not by what the loop left
+        g_draw_list->reset_transform();
+        draw_shapes();
+
+        // files written by draw_to_file must not depend on decoding speed
+        if(t_window.is_headless()) {
+            hw::wait_for_textures();
+        }
+
+        t_pipeline.submit();
+        g_draw_list = &t_pipeline.record();
+
+        if(!g_low_latency) {
+            t_window.handle_events();
+            return;
+        }
+
+        // with vsync submit returns right after the frame was presented,
+        // sleeping here lets more input arrive before the next frame is
+        // simulated while still finishing it before the next refresh
+        if(g_input_wait > 0.0 && !t_window.is_headless()) {
+            std::chrono::duration<double, std::milli> const wait{
+                g_input_wait * t_window.refresh_interval()};
+            std::this_thread::sleep_for(wait);
+        }
+    }
+
     int draw(std::function<void(double)> t_call)
     {
         hw::window wnd{g_global_width, g_global_height, "HWindow"};
@@ -132,7 +301,10 @@ namespace dummy_api {
         g_global_window = &wnd;
         wnd.set_bgcolor(g_background);
 
+        hw::frame_pipeline pipeline{wnd, g_frame_latency};
+
         g_inside_draw_call = true;
+        hw::reset_input_latency();
 
         double avg_fps{0.0};
 
@@ -148,32 +320,111 @@ namespace dummy_api {
             avg_fps /= 2;
             start = end;
 
-            wnd.clear();
+            render_frame(wnd, pipeline, t_call, elapsed_time);
+        }
+
+        pipeline.finish();
+        g_draw_list = nullptr;
 
-            t_call(elapsed_time);
+        std::cout << "FPS: " << avg_fps << '\n';
 
-            draw_shapes();
+        hw::latency_stats const latency = hw::get_input_latency();
 
-            wnd.update();
+        if(latency.samples > 0) {
+            std::cout << "Input latency(ms): average " << latency.average
+                      << ", p95 " << latency.p95 << ", max " << latency.max
+                      << '\n';
         }
 
-        std::cout << "FPS: " << avg_fps << '\n';
+        hw::texture_stats const textures = hw::get_texture_stats();
+
+        if(textures.decodes > 0) {
+            std::cout << "Textures: " << textures.decodes << " decoded, "
+                      << textures.hit_rate() * 100.0 << "% cache hits, "
+                      << textures.bytes_resident / 1024 << " KiB resident\n";
+        }
+
+        if(textures.budget > 0) {
+            std::cout << "Texture budget: " << textures.budget / 1024
+                      << " KiB, " << textures.textures_resident
+                      << " textures resident, " << textures.evictions
+                      << " evictions\n";
+        }
+
+        hw::atlas_stats const atlas = hw::get_atlas_stats();
+
+        if(atlas.pages > 0) {
+            std::cout << "Atlas: " << atlas.images << " images in "
+                      << atlas.pages << " pages, " << atlas.occupancy * 100.0
+                      << "% occupied, " << atlas.repacks << " repacks\n";
+        }
 
         return 1;
     }
 
+    bool draw_to_file(std::string const& t_path,
+                      std::function<void(double)> t_call, int const t_frames)
+    {
+        hw::window wnd{g_global_width, g_global_height, hw::headless};
+
+        g_global_window = &wnd;
+        wnd.set_bgcolor(g_background);
+
+        hw::frame_pipeline pipeline{wnd, 0};
+
+        g_inside_draw_call = true;
+
+        for(int i = 0; i < t_frames; ++i) {
+            render_frame(wnd, pipeline, t_call, 1.0 / 60.0);
+        }
+
+        SDL_Surface* frame = wnd.capture();
+        bool const saved =
+            frame != nullptr && IMG_SavePNG(frame, t_path.c_str()) == 0;
+
+        if(!saved) {
+            SDL_Log("Could not save %s: %s\n", t_path.c_str(), SDL_GetError());
+        }
+
+        SDL_FreeSurface(frame);
+
+        g_inside_draw_call = false;
+        g_draw_list = nullptr;
+        g_global_window = nullptr;
+
+        return saved;
+    }
+
     Shape::Shape()
     {
         get_shapes().push_back(this);
     }
 
+    Shape::~Shape() noexcept
+    {
+        auto& shapes = get_shapes();
+        // shapes usually go away in the opposite order they were made in
+        auto const found = std::find(shapes.rbegin(), shapes.rend(), this);
+
+        if(found != shapes.rend()) {
+            shapes.erase(std::next(found).base());
+        }
+    }
+
     void Shape::draw_shape() noexcept
     {
         if(m_hidden) {
             return;
         }
 
+        if(m_group == nullptr) {
+            this->draw();
+            return;
+        }
+
+        g_draw_list->push_transform(m_group->transform());
         this->draw();
+        g_draw_list->pop_transform();
     }
 
     void Shape::hide() noexcept
@@ -186,13 +437,30 @@ namespace dummy_api {
         m_hidden = false;
     }
 
+    Group::Group(hw::affine2 const& t_transform)
+        : m_transform(t_transform)
+    {
+    }
+
+    void Group::add(Shape& t_shape) noexcept
+    {
+        t_shape.set_group(this);
+    }
+
+    void Group::remove(Shape& t_shape) noexcept
+    {
+        if(t_shape.group() == this) {
+            t_shape.set_group(nullptr);
+        }
+    }
+
     void point(const hw::vec2& t_pos, const hw::color& t_color)
     {
         if(!g_inside_draw_call) {
             get_anon_shapes().push_back(make_unique<da::Point>(t_pos, t_color));
         }
         else {
-            hw::draw_point(get_global_window()->get_renderer(), t_pos, t_color);
+            g_draw_list->point(t_pos, t_color);
         }
     }
 
@@ -221,7 +489,7 @@ namespace dummy_api {
 
     void Point::draw()
     {
-        hw::draw_point(get_global_window()->get_renderer(), m_value, m_color);
+        g_draw_list->point(m_value, m_color);
     }
 
     void line(const hw::vec2& t_a, const hw::vec2& t_b,
@@ -231,8 +499,7 @@ namespace dummy_api {
             get_anon_shapes().push_back(make_unique<Line>(t_a, t_b, t_color));
         }
         else {
-            hw::draw_line(get_global_window()->get_renderer(), t_a, t_b,
-                          t_color);
+            g_draw_list->line(t_a, t_b, t_color);
         }
     }
     void line(const int t_x1, const int t_y1, const int t_x2, const int t_y2,
@@ -266,8 +533,71 @@ namespace dummy_api {
 
     void Line::draw()
     {
-        hw::draw_line(get_global_window()->get_renderer(), m_start, m_end,
-                      m_color);
+        g_draw_list->line(m_start, m_end, m_color);
+    }
+
+    ///
+    /// @brief A shape with a fill split into small triangles, kept between
+    ///        calls so drawing them does not allocate.
+    ///
+    struct fill_mesh
+    {
+        std::vector<hw::vec2f> points{};
+        std::vector<int> triangles{};
+        std::vector<hw::color> colors{};
+    };
+
+    static fill_mesh& get_fill_mesh()
+    {
+        static fill_mesh mesh;
+
+        mesh.points.clear();
+        mesh.triangles.clear();
+
+        return mesh;
+    }
+
+    ///
+    /// @brief How far apart the points of a mesh covering @ref t_min to
+    ///        @ref t_max must be, in the space shapes are given in.
+    ///
+    static float fill_spacing(hw::fill_style const& t_fill,
+                              hw::vec2f const& t_min, hw::vec2f const& t_max)
+    {
+        // a scaled shape scales its mesh too
+        return t_fill.spacing(t_min, t_max) *
+               hw::local_tolerance(g_draw_list->transform()) /
+               hw::curve_tolerance;
+    }
+
+    static float fill_spacing(hw::fill_style const& t_fill,
+                              hw::vec2f const* t_points,
+                              std::size_t const t_count)
+    {
+        hw::vec2f min = t_points[0];
+        hw::vec2f max = t_points[0];
+
+        for(std::size_t i = 1; i < t_count; ++i) {
+            min.x = std::min(min.x, t_points[i].x);
+            min.y = std::min(min.y, t_points[i].y);
+            max.x = std::max(max.x, t_points[i].x);
+            max.y = std::max(max.y, t_points[i].y);
+        }
+
+        return fill_spacing(t_fill, min, max);
+    }
+
+    static void draw_fill_mesh(hw::fill_style const& t_fill,
+                               fill_mesh& t_mesh)
+    {
+        t_mesh.colors.resize(t_mesh.points.size());
+        t_fill.colors(t_mesh.points.data(), t_mesh.points.size(),
+                      t_mesh.colors.data());
+
+        g_draw_list->shaded_polygon(t_mesh.points.data(),
+                                    t_mesh.colors.data(), t_mesh.points.size(),
+                                    t_mesh.triangles.data(),
+                                    t_mesh.triangles.size());
     }
 
     void triangle(const hw::vec2& t_pos1, const hw::vec2& t_pos2,
@@ -278,8 +608,7 @@ namespace dummy_api {
                 make_unique<Triangle>(t_pos1, t_pos2, t_pos3, t_color));
         }
         else {
-            hw::draw_triangle(get_global_window()->get_renderer(), t_pos1,
-                              t_pos2, t_pos3, t_color);
+            g_draw_list->triangle(t_pos1, t_pos2, t_pos3, t_color);
         }
     }
 
@@ -321,8 +650,20 @@ namespace dummy_api {
 
     void Triangle::draw()
     {
-        hw::draw_triangle(get_global_window()->get_renderer(), m_first,
-                          m_second, m_third, m_color);
+        if(m_fill.flat()) {
+            g_draw_list->triangle(m_first, m_second, m_third, m_color);
+            return;
+        }
+
+        hw::vec2f const corners[] = {hw::vec2f{m_first}, hw::vec2f{m_second},
+                                     hw::vec2f{m_third}};
+        int const order[] = {0, 1, 2};
+        auto& mesh = get_fill_mesh();
+
+        hw::mesh_triangles(corners, order, 3,
+                           fill_spacing(m_fill, corners, 3), mesh.points,
+                           mesh.triangles);
+        draw_fill_mesh(m_fill, mesh);
     }
 
     void outline_triangle(const hw::vec2& t_pos1, const hw::vec2& t_pos2,
@@ -333,8 +674,7 @@ namespace dummy_api {
                 make_unique<OutlineTriangle>(t_pos1, t_pos2, t_pos3, t_color));
         }
         else {
-            hw::draw_outline_triangle(get_global_window()->get_renderer(),
-                                      t_pos1, t_pos2, t_pos3, t_color);
+            g_draw_list->outline_triangle(t_pos1, t_pos2, t_pos3, t_color);
         }
     }
     void outline_triangle(const int t_x1, const int t_y1, const int t_x2,
@@ -378,8 +718,7 @@ namespace dummy_api {
 
     void OutlineTriangle::draw()
     {
-        hw::draw_outline_triangle(get_global_window()->get_renderer(), m_first,
-                                  m_second, m_third, m_color);
+        g_draw_list->outline_triangle(m_first, m_second, m_third, m_color);
     }
 
     void rectangle(const hw::vec2& t_pos, const int t_width, const int t_height,
@@ -390,8 +729,7 @@ namespace dummy_api {
                 make_unique<Rectangle>(t_pos, t_width, t_height, t_color));
         }
         else {
-            hw::draw_rectangle(get_global_window()->get_renderer(), t_pos,
-                               t_width, t_height, t_color);
+            g_draw_list->rectangle(t_pos, t_width, t_height, t_color);
         }
     }
 
@@ -427,8 +765,20 @@ namespace dummy_api {
 
     void Rectangle::draw()
     {
-        hw::draw_rectangle(get_global_window()->get_renderer(), m_pos,
-                           m_dimensions.x, m_dimensions.y, m_color);
+        if(m_fill.flat()) {
+            g_draw_list->rectangle(m_pos, m_dimensions.x, m_dimensions.y,
+                                   m_color);
+            return;
+        }
+
+        hw::vec2f const corners[] = {hw::vec2f{m_pos},
+                                     hw::vec2f{m_pos + m_dimensions}};
+        auto& mesh = get_fill_mesh();
+
+        hw::mesh_rectangle(corners[0], hw::vec2f{m_dimensions},
+                           fill_spacing(m_fill, corners, 2), mesh.points,
+                           mesh.triangles);
+        draw_fill_mesh(m_fill, mesh);
     }
 
     void outline_rectangle(const hw::vec2& t_pos, const int t_width,
@@ -439,8 +789,7 @@ namespace dummy_api {
                 t_pos, t_width, t_height, t_color));
         }
         else {
-            hw::draw_outline_rectangle(get_global_window()->get_renderer(),
-                                       t_pos, t_width, t_height, t_color);
+            g_draw_list->outline_rectangle(t_pos, t_width, t_height, t_color);
         }
     }
     void outline_rectangle(const int t_x, const int t_y, const int t_width,
@@ -477,8 +826,8 @@ namespace dummy_api {
 
     void OutlineRectangle::draw()
     {
-        hw::draw_outline_rectangle(get_global_window()->get_renderer(), m_pos,
-                                   m_dimensions.x, m_dimensions.y, m_color);
+        g_draw_list->outline_rectangle(m_pos, m_dimensions.x, m_dimensions.y,
+                                       m_color);
     }
 
     void circle(const hw::vec2& t_pos, const int t_radius,
@@ -489,8 +838,7 @@ namespace dummy_api {
                 make_unique<Circle>(t_pos, t_radius, t_color));
         }
         else {
-            hw::draw_circle(get_global_window()->get_renderer(), t_pos,
-                            t_radius, t_color);
+            g_draw_list->circle(t_pos, t_radius, t_color);
         }
     }
 
@@ -525,8 +873,23 @@ namespace dummy_api {
 
     void Circle::draw()
     {
-        hw::draw_circle(get_global_window()->get_renderer(), m_pos, m_radius,
-                        m_color);
+        if(m_fill.flat()) {
+            g_draw_list->circle(m_pos, m_radius, m_color);
+            return;
+        }
+
+        // the pixels hw::draw_circle fills, centers and all
+        hw::vec2f const center{static_cast<float>(m_pos.x) + 0.5f,
+                               static_cast<float>(m_pos.y) + 0.5f};
+        float const radius = static_cast<float>(m_radius) + 0.5f;
+        hw::vec2f const corners[] = {center - hw::vec2f{radius, radius},
+                                     center + hw::vec2f{radius, radius}};
+        auto& mesh = get_fill_mesh();
+
+        hw::mesh_circle(center, radius, fill_spacing(m_fill, corners, 2),
+                        hw::local_tolerance(g_draw_list->transform()),
+                        mesh.points, mesh.triangles);
+        draw_fill_mesh(m_fill, mesh);
     }
 
     void outline_circle(const hw::vec2& t_pos, const int t_radius,
@@ -537,8 +900,7 @@ namespace dummy_api {
                 make_unique<OutlineCircle>(t_pos, t_radius, t_color));
         }
         else {
-            hw::draw_outline_circle(get_global_window()->get_renderer(), t_pos,
-                                    t_radius, t_color);
+            g_draw_list->outline_circle(t_pos, t_radius, t_color);
         }
     }
 
@@ -574,120 +936,1104 @@ namespace dummy_api {
 
     void OutlineCircle::draw()
     {
-        hw::draw_outline_circle(get_global_window()->get_renderer(), m_pos,
-                                m_radius, m_color);
+        g_draw_list->outline_circle(m_pos, m_radius, m_color);
     }
 
-    void Image::delete_rect_if_created_here() noexcept
+    ///
+    /// @brief Corners the way @ref hw::draw_list takes them.
+    ///
+    static void to_corners(std::vector<hw::vec2> const& t_points,
+                           std::vector<hw::vec2f>& t_corners)
     {
-        if(m_created_here) {
-            delete m_rect;
+        t_corners.clear();
+
+        for(auto const& point : t_points) {
+            t_corners.emplace_back(point);
         }
     }
 
-    void Image::create_image() noexcept
+    void polygon(const std::vector<hw::vec2>& t_points,
+                 const hw::color& t_color)
     {
-        if(m_created_image) {
+        if(!g_inside_draw_call) {
+            get_anon_shapes().push_back(
+                make_unique<Polygon>(t_points, t_color));
             return;
         }
-        SDL_Surface* img = IMG_Load(m_path.c_str());
 
-        SDL_SetColorKey(img, SDL_TRUE,
-                        SDL_MapRGB(img->format, m_color_key.r, m_color_key.g,
-                                   m_color_key.b));
+        // kept between calls so drawing polygons does not allocate
+        static std::vector<hw::vec2f> corners{};
+        static std::vector<int> triangles{};
 
-        m_image = SDL_CreateTextureFromSurface(
-            get_global_window()->get_renderer(), img);
-
-        SDL_FreeSurface(img);
+        to_corners(t_points, corners);
+        hw::triangulate(corners.data(), corners.size(), triangles);
+        g_draw_list->polygon(corners.data(), corners.size(), triangles.data(),
+                             triangles.size(), t_color);
+    }
 
-        if(m_rect == nullptr) {
-            m_created_here = true;
-            m_rect = new OutlineRectangle{
-                get_global_window()->get_width() / 2 - 50,
-                get_global_window()->get_height() / 2 - 50, 100, 100,
-                get_global_window()->get_bgcolor()};
+    void outline_polygon(const std::vector<hw::vec2>& t_points,
+                         const hw::color& t_color)
+    {
+        if(!g_inside_draw_call) {
+            get_anon_shapes().push_back(
+                make_unique<OutlinePolygon>(t_points, t_color));
+            return;
         }
 
-        m_created_image = true;
+        static std::vector<hw::vec2f> corners{};
+
+        to_corners(t_points, corners);
+        g_draw_list->outline_polygon(corners.data(), corners.size(), t_color);
     }
 
-    Image::Image(std::string const t_path)
-        : m_rect(nullptr)
-        , m_path(t_path)
-        , m_created_here(true)
-        , m_color_key(0, 0, 0)
-        , m_created_image(false)
-        , m_image(nullptr)
-    {
+    ///
+    /// @brief Flattens a quadratic or cubic curve given by @ref t_points
+    ///        into @ref t_curve.
+    ///
+    static void flatten_bezier(hw::vec2 const* t_points,
+                               std::size_t const t_count,
+                               float const t_tolerance,
+                               hw::flattened_curve& t_curve)
+    {
+        t_curve.points.clear();
+        t_curve.tolerance = t_tolerance;
+
+        if(t_count == 3) {
+            hw::flatten_quadratic(hw::vec2f{t_points[0]},
+                                  hw::vec2f{t_points[1]},
+                                  hw::vec2f{t_points[2]}, t_tolerance,
+                                  t_curve.points);
+        }
+        else if(t_count == 4) {
+            hw::flatten_cubic(hw::vec2f{t_points[0]}, hw::vec2f{t_points[1]},
+                              hw::vec2f{t_points[2]}, hw::vec2f{t_points[3]},
+                              t_tolerance, t_curve.points);
+        }
     }
 
-    Image::Image(std::string const t_path, int const t_x, int const t_y,
-                 int const t_width, int const t_height)
-        : m_rect(new OutlineRectangle{t_x, t_y, t_width, t_height})
-        , m_path(t_path)
-        , m_created_here(true)
-        , m_color_key(0, 0, 0)
-        , m_created_image(false)
-        , m_image(nullptr)
+    ///
+    /// @brief Flattens an arc into @ref t_curve, with the center first
+    ///        when it is filled so it becomes a slice.
+    ///
+    static void flatten_slice(hw::vec2 const& t_center, int const t_radius,
+                              float const t_start_angle,
+                              float const t_end_angle, bool const t_filled,
+                              float const t_tolerance,
+                              hw::flattened_curve& t_curve)
     {
+        bool const full = std::fabs(t_end_angle - t_start_angle) >= 360.0f;
+
+        t_curve.points.clear();
+        t_curve.tolerance = t_tolerance;
+
+        if(t_filled && !full) {
+            t_curve.points.emplace_back(t_center);
+        }
+
+        hw::flatten_arc(hw::vec2f{t_center}, static_cast<float>(t_radius),
+                        t_start_angle, t_end_angle, t_tolerance,
+                        t_curve.points);
+
+        // a filled circle would end on its first point again
+        if(t_filled && full) {
+            t_curve.points.pop_back();
+        }
     }
 
-    Image::Image(std::string const t_path, hw::vec2 const& t_pos,
-                 hw::vec2 const& t_dim)
-        : m_rect(new OutlineRectangle{t_pos, t_dim.x, t_dim.y})
-        , m_path(t_path)
-        , m_created_here(true)
-        , m_color_key(0, 0, 0)
-        , m_created_image(false)
-        , m_image(nullptr)
+    ///
+    /// @brief Records a curve that was just flattened, splitting it into
+    ///        triangles first if it is filled.
+    ///
+    static void draw_curve(hw::flattened_curve& t_curve, bool const t_filled,
+                           bool const t_flattened, hw::color const& t_color)
     {
+        if(!t_filled) {
+            g_draw_list->polyline(t_curve.points.data(), t_curve.points.size(),
+                                  t_color);
+            return;
+        }
+
+        if(t_flattened) {
+            hw::triangulate(t_curve.points.data(), t_curve.points.size(),
+                            t_curve.triangles);
+        }
+
+        g_draw_list->polygon(t_curve.points.data(), t_curve.points.size(),
+                             t_curve.triangles.data(),
+                             t_curve.triangles.size(), t_color);
     }
 
-    Image::Image(std::string const t_path, OutlineRectangle& t_rect)
-        : m_rect(&t_rect)
-        , m_path(t_path)
-        , m_created_here(false)
-        , m_color_key(0, 0, 0)
-        , m_created_image(false)
-        , m_image(nullptr)
+    ///
+    /// @brief Where the functions that draw curves every frame flatten
+    ///        them, kept between calls so they do not allocate.
+    ///
+    static hw::flattened_curve& scratch_curve()
     {
+        static hw::flattened_curve curve{};
+        return curve;
     }
 
-    Image::~Image() noexcept
+    ///
+    /// @brief What @ref bezier and @ref filled_bezier do.
+    ///
+    static void record_bezier(hw::vec2 const* t_points,
+                              std::size_t const t_count, bool const t_filled,
+                              hw::color const& t_color)
     {
-        this->delete_rect_if_created_here();
-        SDL_DestroyTexture(m_image);
+        if(!g_inside_draw_call) {
+            std::unique_ptr<Bezier> shape =
+                t_count == 3 ? make_unique<Bezier>(t_points[0], t_points[1],
+                                                   t_points[2], t_color)
+                             : make_unique<Bezier>(t_points[0], t_points[1],
+                                                   t_points[2], t_points[3],
+                                                   t_color);
+            shape->set_filled(t_filled);
+            get_anon_shapes().push_back(std::move(shape));
+            return;
+        }
+
+        auto& curve = scratch_curve();
+
+        flatten_bezier(t_points, t_count,
+                       hw::local_tolerance(g_draw_list->transform()), curve);
+        draw_curve(curve, t_filled, true, t_color);
     }
 
-    void Image::draw()
+    ///
+    /// @brief What @ref arc and @ref filled_arc do.
+    ///
+    static void record_arc(hw::vec2 const& t_center, int const t_radius,
+                           float const t_start_angle, float const t_end_angle,
+                           bool const t_filled, hw::color const& t_color)
     {
-        this->create_image();
+        if(!g_inside_draw_call) {
+            auto shape = make_unique<Arc>(t_center, t_radius, t_start_angle,
+                                          t_end_angle, t_color);
+            shape->set_filled(t_filled);
+            get_anon_shapes().push_back(std::move(shape));
+            return;
+        }
 
-        SDL_Rect dest;
-        dest.x = m_rect->pos().x;
-        dest.y = m_rect->pos().y;
-        dest.w = m_rect->dim().x;
-        dest.h = m_rect->dim().y;
+        auto& curve = scratch_curve();
 
-        SDL_RenderCopy(get_global_window()->get_renderer(), m_image, NULL,
-                       &dest);
+        flatten_slice(t_center, t_radius, t_start_angle, t_end_angle, t_filled,
+                      hw::local_tolerance(g_draw_list->transform()), curve);
+        draw_curve(curve, t_filled, true, t_color);
     }
 
-    void Image::set_path(std::string const t_path)
+    void bezier(const hw::vec2& t_start, const hw::vec2& t_control,
+                const hw::vec2& t_end, const hw::color& t_color)
     {
-        m_path = t_path;
+        hw::vec2 const points[] = {t_start, t_control, t_end};
+        record_bezier(points, 3, false, t_color);
     }
 
-    void Image::set_color_key(hw::color const& t_color) noexcept
+    void bezier(const hw::vec2& t_start, const hw::vec2& t_first,
+                const hw::vec2& t_second, const hw::vec2& t_end,
+                const hw::color& t_color)
     {
-        m_color_key = t_color;
+        hw::vec2 const points[] = {t_start, t_first, t_second, t_end};
+        record_bezier(points, 4, false, t_color);
     }
 
-    void Image::follow(OutlineRectangle& t_rect)
+    void filled_bezier(const hw::vec2& t_start, const hw::vec2& t_control,
+                       const hw::vec2& t_end, const hw::color& t_color)
     {
-        this->delete_rect_if_created_here();
+        hw::vec2 const points[] = {t_start, t_control, t_end};
+        record_bezier(points, 3, true, t_color);
+    }
+
+    void filled_bezier(const hw::vec2& t_start, const hw::vec2& t_first,
+                       const hw::vec2& t_second, const hw::vec2& t_end,
+                       const hw::color& t_color)
+    {
+        hw::vec2 const points[] = {t_start, t_first, t_second, t_end};
+        record_bezier(points, 4, true, t_color);
+    }
+
+    void arc(const hw::vec2& t_center, const int t_radius,
+             const float t_start_angle, const float t_end_angle,
+             const hw::color& t_color)
+    {
+        record_arc(t_center, t_radius, t_start_angle, t_end_angle, false,
+                   t_color);
+    }
+
+    void arc(const int t_x, const int t_y, const int t_radius,
+             const float t_start_angle, const float t_end_angle,
+             const hw::color& t_color)
+    {
+        arc(hw::vec2{t_x, t_y}, t_radius, t_start_angle, t_end_angle, t_color);
+    }
+
+    void filled_arc(const hw::vec2& t_center, const int t_radius,
+                    const float t_start_angle, const float t_end_angle,
+                    const hw::color& t_color)
+    {
+        record_arc(t_center, t_radius, t_start_angle, t_end_angle, true,
+                   t_color);
+    }
+
+    void filled_arc(const int t_x, const int t_y, const int t_radius,
+                    const float t_start_angle, const float t_end_angle,
+                    const hw::color& t_color)
+    {
+        filled_arc(hw::vec2{t_x, t_y}, t_radius, t_start_angle, t_end_angle,
+                   t_color);
+    }
+
+    Bezier::Bezier(const hw::vec2& t_start, const hw::vec2& t_control,
+                   const hw::vec2& t_end, const hw::color& t_color)
+        : m_points{t_start, t_control, t_end}
+        , m_color{t_color}
+    {
+    }
+
+    Bezier::Bezier(const hw::vec2& t_start, const hw::vec2& t_first,
+                   const hw::vec2& t_second, const hw::vec2& t_end,
+                   const hw::color& t_color)
+        : m_points{t_start, t_first, t_second, t_end}
+        , m_color{t_color}
+    {
+    }
+
+    void Bezier::draw()
+    {
+        float const tolerance = hw::local_tolerance(g_draw_list->transform());
+        bool const flatten = m_curve.tolerance != tolerance;
+
+        if(flatten) {
+            flatten_bezier(m_points.data(), m_points.size(), tolerance,
+                           m_curve);
+        }
+
+        draw_curve(m_curve, m_filled, flatten, m_color);
+    }
+
+    Arc::Arc(const hw::vec2& t_center, const int t_radius,
+             const float t_start_angle, const float t_end_angle,
+             const hw::color& t_color)
+        : m_center{t_center}
+        , m_radius{t_radius}
+        , m_start_angle{t_start_angle}
+        , m_end_angle{t_end_angle}
+        , m_color{t_color}
+    {
+    }
+
+    Arc::Arc(const int t_x, const int t_y, const int t_radius,
+             const float t_start_angle, const float t_end_angle,
+             const hw::color& t_color)
+        : Arc(hw::vec2{t_x, t_y}, t_radius, t_start_angle, t_end_angle,
+              t_color)
+    {
+    }
+
+    void Arc::draw()
+    {
+        float const tolerance = hw::local_tolerance(g_draw_list->transform());
+        bool const flatten = m_curve.tolerance != tolerance;
+
+        if(flatten) {
+            flatten_slice(m_center, m_radius, m_start_angle, m_end_angle,
+                          m_filled, tolerance, m_curve);
+        }
+
+        draw_curve(m_curve, m_filled, flatten, m_color);
+    }
+
+    void text(const hw::vec2& t_pos, const std::string& t_text,
+              const hw::color& t_color)
+    {
+        if(!g_inside_draw_call) {
+            get_anon_shapes().push_back(
+                make_unique<Text>(t_pos, t_text, t_color));
+            return;
+        }
+
+        // kept between calls so drawing text does not allocate
+        static std::vector<hw::vec2f> corners{};
+        static std::string glyphs{};
+
+        auto const& font = hw::font::builtin();
+
+        font->layout(t_text, t_pos, 1, corners, glyphs);
+        g_draw_list->text(font, corners.data(), glyphs.data(), glyphs.size(),
+                          t_color);
+    }
+
+    void text(const int t_x, const int t_y, const std::string& t_text,
+              const hw::color& t_color)
+    {
+        text(hw::vec2{t_x, t_y}, t_text, t_color);
+    }
+
+    std::shared_ptr<hw::font> load_font(const std::string& t_path,
+                                        const int t_glyph_width,
+                                        const int t_glyph_height,
+                                        const char t_first,
+                                        const hw::color& t_color_key)
+    {
+        return hw::font::from_image(t_path, t_glyph_width, t_glyph_height,
+                                    t_first, t_color_key);
+    }
+
+    Text::Text(const hw::vec2& t_pos, std::string t_text,
+               const hw::color& t_color)
+        : m_pos{t_pos}
+        , m_text{std::move(t_text)}
+        , m_color{t_color}
+    {
+    }
+
+    Text::Text(const int t_x, const int t_y, std::string t_text,
+               const hw::color& t_color)
+        : Text(hw::vec2{t_x, t_y}, std::move(t_text), t_color)
+    {
+    }
+
+    void Text::draw()
+    {
+        if(m_modified) {
+            m_font->layout(m_text, m_pos, m_scale, m_corners, m_glyphs);
+            m_modified = false;
+        }
+
+        g_draw_list->text(m_font, m_corners.data(), m_glyphs.data(),
+                          m_glyphs.size(), m_color);
+    }
+
+    Polygon::Polygon(std::vector<hw::vec2> t_points, const hw::color& t_color)
+        : m_points{std::move(t_points)}
+        , m_color{t_color}
+    {
+    }
+
+    void Polygon::draw()
+    {
+        if(m_modified) {
+            to_corners(m_points, m_corners);
+            hw::triangulate(m_corners.data(), m_corners.size(), m_triangles);
+            m_modified = false;
+        }
+
+        if(m_fill.flat() || m_corners.empty()) {
+            g_draw_list->polygon(m_corners.data(), m_corners.size(),
+                                 m_triangles.data(), m_triangles.size(),
+                                 m_color);
+            return;
+        }
+
+        auto& mesh = get_fill_mesh();
+
+        hw::mesh_triangles(m_corners.data(), m_triangles.data(),
+                           m_triangles.size(),
+                           fill_spacing(m_fill, m_corners.data(),
+                                        m_corners.size()),
+                           mesh.points, mesh.triangles);
+        draw_fill_mesh(m_fill, mesh);
+    }
+
+    OutlinePolygon::OutlinePolygon(std::vector<hw::vec2> t_points,
+                                   const hw::color& t_color)
+        : m_points{std::move(t_points)}
+        , m_color{t_color}
+    {
+    }
+
+    void OutlinePolygon::draw()
+    {
+        if(m_modified) {
+            to_corners(m_points, m_corners);
+            m_modified = false;
+        }
+
+        g_draw_list->outline_polygon(m_corners.data(), m_corners.size(),
+                                     m_color);
+    }
+
+    void Image::delete_rect_if_created_here() noexcept
+    {
+        if(m_created_here) {
+            delete m_rect;
+        }
+    }
+
+    void Image::create_image() noexcept
+    {
+        if(m_created_image) {
+            return;
+        }
+
+        // the file is only loaded when the texture is first drawn, on the
+        // thread that owns the renderer, and only once for all images that
+        // show it
+        m_image = hw::load_texture(m_path, m_color_key);
+
+        if(m_rect == nullptr) {
+            m_created_here = true;
+            m_rect = new OutlineRectangle{
+                get_global_window()->get_width() / 2 - 50,
+                get_global_window()->get_height() / 2 - 50, 100, 100,
+                get_global_window()->get_bgcolor()};
+        }
+
+        m_created_image = true;
+    }
+
+    Image::Image(std::string const t_path)
+        : m_rect(nullptr)
+        , m_path(t_path)
+        , m_created_here(true)
+        , m_color_key(0, 0, 0)
+        , m_created_image(false)
+        , m_image()
+    {
+    }
+
+    Image::Image(std::string const t_path, int const t_x, int const t_y,
+                 int const t_width, int const t_height)
+        : m_rect(new OutlineRectangle{t_x, t_y, t_width, t_height})
+        , m_path(t_path)
+        , m_created_here(true)
+        , m_color_key(0, 0, 0)
+        , m_created_image(false)
+        , m_image()
+    {
+    }
+
+    Image::Image(std::string const t_path, hw::vec2 const& t_pos,
+                 hw::vec2 const& t_dim)
+        : m_rect(new OutlineRectangle{t_pos, t_dim.x, t_dim.y})
+        , m_path(t_path)
+        , m_created_here(true)
+        , m_color_key(0, 0, 0)
+        , m_created_image(false)
+        , m_image()
+    {
+    }
+
+    Image::Image(std::string const t_path, OutlineRectangle& t_rect)
+        : m_rect(&t_rect)
+        , m_path(t_path)
+        , m_created_here(false)
+        , m_color_key(0, 0, 0)
+        , m_created_image(false)
+        , m_image()
+    {
+    }
+
+    Image::~Image() noexcept
+    {
+        this->delete_rect_if_created_here();
+    }
+
+    void Image::draw()
+    {
+        this->create_image();
+
+        if(m_frames.empty()) {
+            g_draw_list->image(m_image, m_rect->pos(), m_rect->dim());
+            return;
+        }
+
+        this->advance(g_elapsed_time);
+
+        g_draw_list->image(m_image, m_rect->pos(), m_rect->dim(),
+                           m_frames[m_frame]);
+    }
+
+    void Image::advance(double const t_elapsed_time) noexcept
+    {
+        if(m_frame_duration <= 0.0 || this->finished()) {
+            return;
+        }
+
+        m_frame_time += t_elapsed_time;
+
+        // a long frame(eg. the window was dragged) can skip several frames
+        while(m_frame_time >= m_frame_duration && !this->finished()) {
+            m_frame_time -= m_frame_duration;
+            m_frame = (m_frame + 1) % m_frames.size();
+        }
+    }
+
+    void Image::set_frame_grid(int const t_frame_width,
+                               int const t_frame_height, int const t_columns,
+                               int const t_count)
+    {
+        m_frames.clear();
+        m_frames.reserve(static_cast<std::size_t>(std::max(t_count, 0)));
+
+        for(int i = 0; i < t_count && t_columns > 0; ++i) {
+            m_frames.push_back(SDL_Rect{(i % t_columns) * t_frame_width,
+                                        (i / t_columns) * t_frame_height,
+                                        t_frame_width, t_frame_height});
+        }
+
+        m_frame = 0;
+        m_frame_time = 0.0;
+    }
+
+    void Image::add_frame(int const t_x, int const t_y, int const t_width,
+                          int const t_height)
+    {
+        m_frames.push_back(SDL_Rect{t_x, t_y, t_width, t_height});
+    }
+
+    void Image::clear_frames() noexcept
+    {
+        m_frames.clear();
+        m_frame = 0;
+        m_frame_time = 0.0;
+    }
+
+    void Image::set_frame(std::size_t const t_frame) noexcept
+    {
+        m_frame = m_frames.empty() ? 0 : t_frame % m_frames.size();
+        m_frame_time = 0.0;
+    }
+
+    void Image::animate(double const t_seconds, bool const t_loop) noexcept
+    {
+        m_frame_duration = t_seconds;
+        m_loop = t_loop;
+        m_frame_time = 0.0;
+    }
+
+    bool Image::finished() const noexcept
+    {
+        return !m_loop && !m_frames.empty() && m_frame + 1 == m_frames.size();
+    }
+
+    void Image::set_path(std::string const t_path)
+    {
+        m_path = t_path;
+
+        // frames that were already recorded keep the old texture alive
+        if(m_created_image) {
+            m_image = hw::load_texture(m_path, m_color_key);
+        }
+    }
+
+    void Image::set_color_key(hw::color const& t_color)
+    {
+        m_color_key = t_color;
+
+        if(m_created_image) {
+            m_image = hw::load_texture(m_path, m_color_key);
+        }
+    }
+
+    void Image::follow(OutlineRectangle& t_rect)
+    {
+        this->delete_rect_if_created_here();
         m_rect = &t_rect;
         m_created_here = false;
     }
+
+    Canvas::Canvas(int const t_x, int const t_y, int const t_width,
+                   int const t_height)
+        : Canvas(hw::vec2{t_x, t_y}, hw::vec2{t_width, t_height}, t_width,
+                 t_height)
+    {
+    }
+
+    Canvas::Canvas(hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                   int const t_pixels_x, int const t_pixels_y)
+        : m_pos(t_pos)
+        , m_dim(t_dim)
+        , m_width(std::max(t_pixels_x, 1))
+        , m_height(std::max(t_pixels_y, 1))
+        , m_pixels(static_cast<std::size_t>(m_width) *
+                       static_cast<std::size_t>(m_height),
+                   0)
+        , m_texture(std::make_shared<hw::canvas_texture>(m_width, m_height))
+    {
+    }
+
+    std::uint32_t* Canvas::pixels() noexcept
+    {
+        m_modified = true;
+        return m_pixels.data();
+    }
+
+    std::uint32_t* Canvas::row(int const t_y) noexcept
+    {
+        std::size_t const offset =
+            static_cast<std::size_t>(t_y) * static_cast<std::size_t>(m_width);
+
+        return this->pixels() + offset;
+    }
+
+    void Canvas::set_pixel(int const t_x, int const t_y,
+                           hw::color const& t_color) noexcept
+    {
+        if(t_x < 0 || t_y < 0 || t_x >= m_width || t_y >= m_height) {
+            return;
+        }
+
+        this->row(t_y)[t_x] = hw::to_argb(t_color);
+    }
+
+    hw::color Canvas::get_pixel(int const t_x, int const t_y) const noexcept
+    {
+        if(t_x < 0 || t_y < 0 || t_x >= m_width || t_y >= m_height) {
+            return hw::color{0, 0, 0, 0};
+        }
+
+        return hw::from_argb(m_pixels[static_cast<std::size_t>(t_y) *
+                                          static_cast<std::size_t>(m_width) +
+                                      static_cast<std::size_t>(t_x)]);
+    }
+
+    void Canvas::fill(hw::color const& t_color) noexcept
+    {
+        std::fill(m_pixels.begin(), m_pixels.end(), hw::to_argb(t_color));
+        m_modified = true;
+    }
+
+    void Canvas::fill(hw::fill_style const& t_fill)
+    {
+        for(int y = 0; y < m_height; ++y) {
+            t_fill.span(0.5f, static_cast<float>(y) + 0.5f, this->row(y),
+                        static_cast<std::size_t>(m_width));
+        }
+
+        m_modified = true;
+    }
+
+    void Canvas::draw()
+    {
+        // the texture is new(first frame, new renderer) or the pixels changed
+        bool const upload = m_modified || m_texture->needs_pixels();
+
+        g_draw_list->canvas(m_texture, m_pos, m_dim,
+                            upload ? m_pixels.data() : nullptr);
+        m_modified = false;
+    }
+
+    SpriteBatch::SpriteBatch(std::string const& t_path,
+                             hw::color const& t_color_key)
+        : m_texture(hw::load_texture(t_path, t_color_key))
+    {
+    }
+
+    void SpriteBatch::add(int const t_x, int const t_y, int const t_width,
+                          int const t_height)
+    {
+        this->add(hw::vec2{t_x, t_y}, hw::vec2{t_width, t_height});
+    }
+
+    void SpriteBatch::add(hw::vec2 const& t_pos, hw::vec2 const& t_dim,
+                          hw::color const& t_tint, float const t_angle)
+    {
+        hw::sprite s;
+        s.pos = t_pos;
+        s.dim = t_dim;
+        s.tint = t_tint;
+        s.angle = t_angle;
+
+        m_sprites.push_back(s);
+    }
+
+    void SpriteBatch::clear() noexcept
+    {
+        m_sprites.clear();
+    }
+
+    void SpriteBatch::reserve(std::size_t const t_count)
+    {
+        m_sprites.reserve(t_count);
+    }
+
+    void SpriteBatch::draw()
+    {
+        g_draw_list->sprites(m_texture, m_sprites.data(), m_sprites.size());
+    }
+
+    ParticleSystem::ParticleSystem(std::size_t const t_capacity)
+    {
+        m_particles.reserve(t_capacity);
+        m_colors.reserve(t_capacity);
+    }
+
+    float ParticleSystem::random() noexcept
+    {
+        // xorshift32
+        m_random ^= m_random << 13;
+        m_random ^= m_random >> 17;
+        m_random ^= m_random << 5;
+
+        return static_cast<float>(m_random >> 8) / 16777216.0f;
+    }
+
+    void ParticleSystem::emit(hw::vec2f const& t_pos,
+                              hw::vec2f const& t_velocity,
+                              hw::color const& t_color, float const t_lifetime)
+    {
+        m_particles.emit(t_pos, t_velocity, t_color, t_lifetime);
+    }
+
+    void ParticleSystem::burst(std::size_t const t_count,
+                               hw::vec2f const& t_pos, float const t_speed,
+                               hw::color const& t_color,
+                               float const t_lifetime)
+    {
+        float const two_pi = 2.0f * 3.14159265f;
+
+        for(std::size_t i = 0; i < t_count; ++i) {
+            float const angle = this->random() * two_pi;
+            float const speed = this->random() * t_speed;
+
+            m_particles.emit(t_pos,
+                             hw::vec2f{std::cos(angle) * speed,
+                                       std::sin(angle) * speed},
+                             t_color, t_lifetime);
+        }
+    }
+
+    void ParticleSystem::clear() noexcept
+    {
+        m_particles.clear();
+    }
+
+    void ParticleSystem::set_image(std::string const& t_path,
+                                   hw::color const& t_color_key)
+    {
+        m_texture = hw::load_texture(t_path, t_color_key);
+    }
+
+    void ParticleSystem::draw()
+    {
+        m_particles.update(static_cast<float>(g_elapsed_time), m_gravity);
+
+        hw::color const* colors = m_particles.colors();
+
+        if(m_fade) {
+            m_particles.faded_colors(m_colors);
+            colors = m_colors.data();
+        }
+
+        g_draw_list->particles(m_texture, m_particles.x(), m_particles.y(),
+                               colors, m_particles.size(), m_size);
+    }
+
+    constexpr int TileMap::chunk_size;
+
+    TileMap::TileMap(int const t_columns, int const t_rows,
+                     int const t_tile_width, int const t_tile_height)
+        : m_columns{std::max(0, t_columns)}
+        , m_rows{std::max(0, t_rows)}
+        , m_tile{std::max(1, t_tile_width), std::max(1, t_tile_height)}
+        , m_tiles(static_cast<std::size_t>(m_columns * m_rows), -1)
+    {
+        m_chunk_columns = (m_columns + chunk_size - 1) / chunk_size;
+        m_chunk_rows = (m_rows + chunk_size - 1) / chunk_size;
+
+        for(int y = 0; y < m_chunk_rows; ++y) {
+            for(int x = 0; x < m_chunk_columns; ++x) {
+                int const columns =
+                    std::min(chunk_size, m_columns - x * chunk_size);
+                int const rows = std::min(chunk_size, m_rows - y * chunk_size);
+
+                m_chunks.push_back(
+                    std::make_shared<hw::tile_chunk>(columns, rows, m_tile));
+            }
+        }
+
+        m_dirty.assign(m_chunks.size(), 1);
+    }
+
+    void TileMap::mark_all_dirty() noexcept
+    {
+        std::fill(m_dirty.begin(), m_dirty.end(), 1);
+    }
+
+    void TileMap::set_tile(int const t_column, int const t_row,
+                           int const t_tile)
+    {
+        if(t_column < 0 || t_row < 0 || t_column >= m_columns ||
+           t_row >= m_rows) {
+            return;
+        }
+
+        int& tile = m_tiles[static_cast<std::size_t>(t_row * m_columns +
+                                                     t_column)];
+
+        if(tile == t_tile) {
+            return;
+        }
+
+        tile = t_tile;
+        m_dirty[static_cast<std::size_t>(
+            (t_row / chunk_size) * m_chunk_columns + t_column / chunk_size)] =
+            1;
+    }
+
+    int TileMap::tile(int const t_column, int const t_row) const noexcept
+    {
+        if(t_column < 0 || t_row < 0 || t_column >= m_columns ||
+           t_row >= m_rows) {
+            return -1;
+        }
+
+        return m_tiles[static_cast<std::size_t>(t_row * m_columns + t_column)];
+    }
+
+    void TileMap::fill(int const t_tile)
+    {
+        std::fill(m_tiles.begin(), m_tiles.end(), t_tile);
+        this->mark_all_dirty();
+    }
+
+    hw::vec2 TileMap::cell_at(hw::vec2 const& t_pos) const noexcept
+    {
+        hw::vec2 const local = t_pos - m_pos;
+
+        // rounds down for positions left of or above the map too
+        auto const cell = [](int const t_value, int const t_size) {
+            return t_value >= 0 ? t_value / t_size
+                                : -((-t_value + t_size - 1) / t_size);
+        };
+
+        return hw::vec2{cell(local.x, m_tile.x), cell(local.y, m_tile.y)};
+    }
+
+    void TileMap::set_palette(std::vector<hw::color> t_palette)
+    {
+        m_palette = std::move(t_palette);
+        this->mark_all_dirty();
+    }
+
+    void TileMap::set_tileset(std::string const& t_path,
+                              hw::color const& t_color_key)
+    {
+        m_tileset = hw::load_texture(t_path, t_color_key);
+        this->mark_all_dirty();
+    }
+
+    void TileMap::draw()
+    {
+        if(m_chunks.empty()) {
+            return;
+        }
+
+        // the part of the map the screen shows, found by taking the corners
+        // of the screen back through the transform
+        hw::affine2 const to_map = g_draw_list->transform().inverse();
+        float const width =
+            static_cast<float>(get_global_window()->get_width());
+        float const height =
+            static_cast<float>(get_global_window()->get_height());
+        hw::vec2f const corners[] = {to_map * hw::vec2f{0.0f, 0.0f},
+                                     to_map * hw::vec2f{width, 0.0f},
+                                     to_map * hw::vec2f{width, height},
+                                     to_map * hw::vec2f{0.0f, height}};
+
+        hw::vec2f low = corners[0];
+        hw::vec2f high = corners[0];
+
+        for(auto const& corner : corners) {
+            low.x = std::min(low.x, corner.x);
+            low.y = std::min(low.y, corner.y);
+            high.x = std::max(high.x, corner.x);
+            high.y = std::max(high.y, corner.y);
+        }
+
+        float const chunk_width = static_cast<float>(chunk_size * m_tile.x);
+        float const chunk_height = static_cast<float>(chunk_size * m_tile.y);
+        hw::vec2f const origin{m_pos};
+
+        auto const first = [](float const t_value, float const t_size) {
+            return std::max(0, static_cast<int>(std::floor(t_value / t_size)));
+        };
+        auto const last = [](float const t_value, float const t_size,
+                             int const t_count) {
+            return std::min(t_count - 1,
+                            static_cast<int>(std::floor(t_value / t_size)));
+        };
+
+        int const first_x = first(low.x - origin.x, chunk_width);
+        int const first_y = first(low.y - origin.y, chunk_height);
+        int const last_x =
+            last(high.x - origin.x, chunk_width, m_chunk_columns);
+        int const last_y =
+            last(high.y - origin.y, chunk_height, m_chunk_rows);
+
+        for(int y = first_y; y <= last_y; ++y) {
+            for(int x = first_x; x <= last_x; ++x) {
+                std::size_t const index =
+                    static_cast<std::size_t>(y * m_chunk_columns + x);
+                auto const& chunk = m_chunks[index];
+                hw::vec2 const pos =
+                    m_pos + hw::vec2{x * chunk_size * m_tile.x,
+                                     y * chunk_size * m_tile.y};
+
+                if(!m_dirty[index] && !chunk->needs_tiles()) {
+                    g_draw_list->chunk(chunk, pos, nullptr, nullptr, nullptr,
+                                       0);
+                    continue;
+                }
+
+                m_chunk_tiles.clear();
+
+                for(int row = 0; row < chunk->rows(); ++row) {
+                    auto const start =
+                        m_tiles.begin() +
+                        (y * chunk_size + row) * m_columns + x * chunk_size;
+                    m_chunk_tiles.insert(m_chunk_tiles.end(), start,
+                                         start + chunk->columns());
+                }
+
+                g_draw_list->chunk(chunk, pos, m_tileset, m_chunk_tiles.data(),
+                                   m_palette.data(), m_palette.size());
+                m_dirty[index] = 0;
+            }
+        }
+    }
+
+    static hw::vec2f to_vec2f(hw::vec2 const& t_vec) noexcept
+    {
+        return hw::vec2f{t_vec};
+    }
+
+    static hw::collider point_collider(Shape const& t_shape)
+    {
+        auto const& point = static_cast<Point const&>(t_shape);
+        return hw::point_collider(to_vec2f(point.data()));
+    }
+
+    static hw::collider line_collider(Shape const& t_shape)
+    {
+        auto const& line = static_cast<Line const&>(t_shape);
+        return hw::line_collider(to_vec2f(line.first()),
+                                 to_vec2f(line.second()));
+    }
+
+    template<typename T>
+    static hw::collider triangle_collider(Shape const& t_shape)
+    {
+        auto const& triangle = static_cast<T const&>(t_shape);
+        return hw::triangle_collider(to_vec2f(triangle.first()),
+                                     to_vec2f(triangle.second()),
+                                     to_vec2f(triangle.third()));
+    }
+
+    template<typename T>
+    static hw::collider rect_collider(Shape const& t_shape)
+    {
+        auto const& rect = static_cast<T const&>(t_shape);
+        return hw::rect_collider(to_vec2f(rect.pos()),
+                                 to_vec2f(rect.dim()));
+    }
+
+    template<typename T>
+    static hw::collider circle_collider(Shape const& t_shape)
+    {
+        auto const& circle = static_cast<T const&>(t_shape);
+        return hw::circle_collider(to_vec2f(circle.pos()),
+                                   static_cast<float>(circle.radius()));
+    }
+
+    void Collisions::add(Shape& t_shape, collider_fn const t_collider)
+    {
+        if(m_ids.count(&t_shape) != 0) {
+            return;
+        }
+
+        std::uint32_t const id = m_world.add(t_collider(t_shape));
+
+        if(id >= m_tracked.size()) {
+            m_tracked.resize(id + 1);
+        }
+
+        m_tracked[id] = tracked{&t_shape, t_collider};
+        m_ids[&t_shape] = id;
+    }
+
+    void Collisions::add(Point& t_point)
+    {
+        this->add(t_point, &point_collider);
+    }
+
+    void Collisions::add(Line& t_line)
+    {
+        this->add(t_line, &line_collider);
+    }
+
+    void Collisions::add(Triangle& t_triangle)
+    {
+        this->add(t_triangle, &triangle_collider<Triangle>);
+    }
+
+    void Collisions::add(OutlineTriangle& t_triangle)
+    {
+        this->add(t_triangle, &triangle_collider<OutlineTriangle>);
+    }
+
+    void Collisions::add(Rectangle& t_rect)
+    {
+        this->add(t_rect, &rect_collider<Rectangle>);
+    }
+
+    void Collisions::add(OutlineRectangle& t_rect)
+    {
+        this->add(t_rect, &rect_collider<OutlineRectangle>);
+    }
+
+    void Collisions::add(Circle& t_circle)
+    {
+        this->add(t_circle, &circle_collider<Circle>);
+    }
+
+    void Collisions::add(OutlineCircle& t_circle)
+    {
+        this->add(t_circle, &circle_collider<OutlineCircle>);
+    }
+
+    void Collisions::remove(Shape const& t_shape)
+    {
+        auto const it = m_ids.find(&t_shape);
+
+        if(it == m_ids.end()) {
+            return;
+        }
+
+        m_world.remove(it->second);
+        m_tracked[it->second] = tracked{nullptr, nullptr};
+        m_ids.erase(it);
+    }
+
+    void Collisions::clear() noexcept
+    {
+        m_world.clear();
+        m_tracked.clear();
+        m_ids.clear();
+        m_pairs.clear();
+    }
+
+    std::vector<Collisions::pair> const& Collisions::update()
+    {
+        for(std::uint32_t id = 0; id < m_tracked.size(); ++id) {
+            tracked const& t = m_tracked[id];
+
+            if(t.shape) {
+                m_world.move(id, t.collider(*t.shape));
+            }
+        }
+
+        m_pairs.clear();
+
+        for(auto const& p : m_world.find_pairs()) {
+            Shape* first = m_tracked[p.first].shape;
+            Shape* second = m_tracked[p.second].shape;
+
+            if(!first->hidden() && !second->hidden()) {
+                m_pairs.push_back(pair{first, second});
+            }
+        }
+
+        return m_pairs;
+    }
 } // namespace dummy_api
@@ -0,0 +1,192 @@
+#include "image_filter.hpp"
+
+///
+/// @file image_filter.cpp
+///
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "blend.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HW_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+    ///
+    /// @brief Rounded average of the 2x2 block whose top left corner is
+    ///        @ref t_top[0].
+    ///
+    std::uint32_t average(std::uint32_t const* t_top,
+                          std::uint32_t const* t_bottom) noexcept
+    {
+        std::uint32_t result{0};
+
+        for(int shift = 0; shift < 32; shift += 8) {
+            std::uint32_t const sum =
+                ((t_top[0] >> shift) & 0xFF) + ((t_top[1] >> shift) & 0xFF) +
+                ((t_bottom[0] >> shift) & 0xFF) +
+                ((t_bottom[1] >> shift) & 0xFF);
+
+            result |= ((sum + 2) >> 2) << shift;
+        }
+
+        return result;
+    }
+
+#ifdef HW_HAS_SSE2
+    ///
+    /// @brief Sums horizontal pairs of the two pixels in @ref t_pixels,
+    ///        16 bits per channel, into the lower 64 bits.
+    ///
+    inline __m128i sum_pair(__m128i const t_pixels) noexcept
+    {
+        return _mm_add_epi16(t_pixels, _mm_srli_si128(t_pixels, 8));
+    }
+
+    ///
+    /// @brief 8 pixels of two rows in, 4 averaged pixels out.
+    ///
+    inline __m128i average4(std::uint32_t const* t_top,
+                            std::uint32_t const* t_bottom) noexcept
+    {
+        __m128i const zero = _mm_setzero_si128();
+        __m128i const top0 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(t_top));
+        __m128i const top1 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(t_top + 4));
+        __m128i const bottom0 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(t_bottom));
+        __m128i const bottom1 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(t_bottom + 4));
+
+        // vertical sums, 2 pixels per register
+        __m128i const v0 = _mm_add_epi16(_mm_unpacklo_epi8(top0, zero),
+                                         _mm_unpacklo_epi8(bottom0, zero));
+        __m128i const v1 = _mm_add_epi16(_mm_unpackhi_epi8(top0, zero),
+                                         _mm_unpackhi_epi8(bottom0, zero));
+        __m128i const v2 = _mm_add_epi16(_mm_unpacklo_epi8(top1, zero),
+                                         _mm_unpacklo_epi8(bottom1, zero));
+        __m128i const v3 = _mm_add_epi16(_mm_unpackhi_epi8(top1, zero),
+                                         _mm_unpackhi_epi8(bottom1, zero));
+
+        __m128i const rounding = _mm_set1_epi16(2);
+        __m128i const low = _mm_srli_epi16(
+            _mm_add_epi16(_mm_unpacklo_epi64(sum_pair(v0), sum_pair(v1)),
+                          rounding),
+            2);
+        __m128i const high = _mm_srli_epi16(
+            _mm_add_epi16(_mm_unpacklo_epi64(sum_pair(v2), sum_pair(v3)),
+                          rounding),
+            2);
+
+        return _mm_packus_epi16(low, high);
+    }
+#endif
+
+    ///
+    /// @brief Turns premultiplied pixels back into straight ones in place,
+    ///        fully transparent ones become transparent black.
+    ///
+    void unpremultiply(std::uint32_t* t_pixels, int const t_count) noexcept
+    {
+        for(int i = 0; i < t_count; ++i) {
+            std::uint32_t const alpha = t_pixels[i] >> 24;
+
+            if(alpha == 0) {
+                t_pixels[i] = 0;
+                continue;
+            }
+
+            std::uint32_t result = alpha << 24;
+
+            for(int shift = 0; shift < 24; shift += 8) {
+                std::uint32_t const channel = (t_pixels[i] >> shift) & 0xFF;
+
+                result |= std::min<std::uint32_t>(
+                              (channel * 255 + alpha / 2) / alpha, 255)
+                          << shift;
+            }
+
+            t_pixels[i] = result;
+        }
+    }
+
+    ///
+    /// @brief @ref hw::downscale_half, 4 pixels at a time only when
+    ///        @ref t_simd is set.
+    ///
+    SDL_Surface* downscale(SDL_Surface const* t_source, bool const t_simd)
+    {
+        int const width = t_source->w / 2;
+        int const height = t_source->h / 2;
+
+        SDL_Surface* result = SDL_CreateRGBSurfaceWithFormat(
+            0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+
+        if(!result) {
+            return nullptr;
+        }
+
+        auto const* source =
+            static_cast<unsigned char const*>(t_source->pixels);
+        auto* dest = static_cast<unsigned char*>(result->pixels);
+
+        // averaged premultiplied, so transparent pixels(eg. color keyed
+        // ones) add nothing to the color of the ones next to them
+        std::size_t const row_size = static_cast<std::size_t>(width) * 2;
+        std::vector<std::uint32_t> top(row_size);
+        std::vector<std::uint32_t> bottom(row_size);
+        std::uint32_t const* row0 = top.data();
+        std::uint32_t const* row1 = bottom.data();
+
+        for(int y = 0; y < height; ++y) {
+            hw::premultiply_pixels(
+                reinterpret_cast<std::uint32_t const*>(
+                    source + (2 * y) * t_source->pitch),
+                top.data(), row_size);
+            hw::premultiply_pixels(
+                reinterpret_cast<std::uint32_t const*>(
+                    source + (2 * y + 1) * t_source->pitch),
+                bottom.data(), row_size);
+
+            auto* out =
+                reinterpret_cast<std::uint32_t*>(dest + y * result->pitch);
+
+            int x = 0;
+
+#ifdef HW_HAS_SSE2
+            for(; t_simd && x + 4 <= width; x += 4) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x),
+                                 average4(row0 + 2 * x, row1 + 2 * x));
+            }
+#else
+            static_cast<void>(t_simd);
+#endif
+
+            for(; x < width; ++x) {
+                out[x] = average(row0 + 2 * x, row1 + 2 * x);
+            }
+
+            unpremultiply(out, width);
+        }
+
+        return result;
+    }
+} // namespace
+
+SDL_Surface* hw::downscale_half(SDL_Surface const* t_source)
+{
+    return downscale(t_source, true);
+}
+
+SDL_Surface* hw::downscale_half_scalar(SDL_Surface const* t_source)
+{
+    return downscale(t_source, false);
+}
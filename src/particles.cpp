@@ -0,0 +1,175 @@
+#include "particles.hpp"
+
+///
+/// @file particles.cpp
+///
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HW_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+void hw::particles::reserve(std::size_t const t_count)
+{
+    m_x.reserve(t_count);
+    m_y.reserve(t_count);
+    m_vx.reserve(t_count);
+    m_vy.reserve(t_count);
+    m_life.reserve(t_count);
+    m_lifetime.reserve(t_count);
+    m_colors.reserve(t_count);
+}
+
+void hw::particles::emit(hw::vec2f const& t_pos, hw::vec2f const& t_velocity,
+                         hw::color const& t_color, float const t_lifetime)
+{
+    if(t_lifetime <= 0.0f) {
+        return;
+    }
+
+    m_x.push_back(t_pos.x);
+    m_y.push_back(t_pos.y);
+    m_vx.push_back(t_velocity.x);
+    m_vy.push_back(t_velocity.y);
+    m_life.push_back(t_lifetime);
+    m_lifetime.push_back(t_lifetime);
+    m_colors.push_back(t_color);
+}
+
+void hw::particles::clear() noexcept
+{
+    m_x.clear();
+    m_y.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_life.clear();
+    m_lifetime.clear();
+    m_colors.clear();
+}
+
+void hw::particles::integrate(float const t_seconds,
+                              hw::vec2f const& t_gravity) noexcept
+{
+    std::size_t const count = this->size();
+    std::size_t i{0};
+
+#ifdef HW_HAS_SSE2
+    __m128 const dt4 = _mm_set1_ps(t_seconds);
+    __m128 const ax4 = _mm_set1_ps(t_gravity.x * t_seconds);
+    __m128 const ay4 = _mm_set1_ps(t_gravity.y * t_seconds);
+
+    for(; i + 4 <= count; i += 4) {
+        __m128 const vx = _mm_add_ps(_mm_loadu_ps(&m_vx[i]), ax4);
+        __m128 const vy = _mm_add_ps(_mm_loadu_ps(&m_vy[i]), ay4);
+
+        _mm_storeu_ps(&m_vx[i], vx);
+        _mm_storeu_ps(&m_vy[i], vy);
+        _mm_storeu_ps(&m_x[i],
+                      _mm_add_ps(_mm_loadu_ps(&m_x[i]), _mm_mul_ps(vx, dt4)));
+        _mm_storeu_ps(&m_y[i],
+                      _mm_add_ps(_mm_loadu_ps(&m_y[i]), _mm_mul_ps(vy, dt4)));
+        _mm_storeu_ps(&m_life[i], _mm_sub_ps(_mm_loadu_ps(&m_life[i]), dt4));
+    }
+#endif
+
+    float const ax = t_gravity.x * t_seconds;
+    float const ay = t_gravity.y * t_seconds;
+
+    for(; i < count; ++i) {
+        m_vx[i] += ax;
+        m_vy[i] += ay;
+        m_x[i] += m_vx[i] * t_seconds;
+        m_y[i] += m_vy[i] * t_seconds;
+        m_life[i] -= t_seconds;
+    }
+}
+
+void hw::particles::integrate_scalar(float const t_seconds,
+                                     hw::vec2f const& t_gravity) noexcept
+{
+    float const ax = t_gravity.x * t_seconds;
+    float const ay = t_gravity.y * t_seconds;
+
+    for(std::size_t i = 0; i < this->size(); ++i) {
+        m_vx[i] += ax;
+        m_vy[i] += ay;
+        m_x[i] += m_vx[i] * t_seconds;
+        m_y[i] += m_vy[i] * t_seconds;
+        m_life[i] -= t_seconds;
+    }
+}
+
+void hw::particles::remove(std::size_t const t_index) noexcept
+{
+    std::size_t const last = this->size() - 1;
+
+    m_x[t_index] = m_x[last];
+    m_y[t_index] = m_y[last];
+    m_vx[t_index] = m_vx[last];
+    m_vy[t_index] = m_vy[last];
+    m_life[t_index] = m_life[last];
+    m_lifetime[t_index] = m_lifetime[last];
+    m_colors[t_index] = m_colors[last];
+
+    m_x.pop_back();
+    m_y.pop_back();
+    m_vx.pop_back();
+    m_vy.pop_back();
+    m_life.pop_back();
+    m_lifetime.pop_back();
+    m_colors.pop_back();
+}
+
+void hw::particles::kill_dead() noexcept
+{
+    std::size_t i{0};
+
+    while(i < this->size()) {
+#ifdef HW_HAS_SSE2
+        // most particles are alive, skip them 4 at a time
+        __m128 const zero = _mm_setzero_ps();
+
+        while(i + 4 <= this->size() &&
+              _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&m_life[i]), zero)) ==
+                  0) {
+            i += 4;
+        }
+
+        if(i >= this->size()) {
+            break;
+        }
+#endif
+
+        if(m_life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+
+        // the last particle moves here and is looked at next
+        this->remove(i);
+    }
+}
+
+void hw::particles::update(float const t_seconds,
+                           hw::vec2f const& t_gravity) noexcept
+{
+    this->integrate(t_seconds, t_gravity);
+    this->kill_dead();
+}
+
+void hw::particles::faded_colors(std::vector<hw::color>& t_out) const
+{
+    t_out.resize(this->size());
+
+    for(std::size_t i = 0; i < this->size(); ++i) {
+        float const left = std::max(0.0f, std::min(m_life[i] / m_lifetime[i],
+                                                   1.0f));
+        hw::color c = m_colors[i];
+
+        c.a = static_cast<std::uint8_t>(static_cast<float>(c.a) * left + 0.5f);
+        t_out[i] = c;
+    }
+}
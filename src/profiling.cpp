@@ -0,0 +1,85 @@
+#include "profiling.hpp"
+
+///
+/// @file profiling.cpp
+///
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+#include "ring_buffer.hpp"
+
+namespace {
+    struct latency_recorder
+    {
+        std::mutex mutex{};
+        hw::latency_stats stats{};
+        double total{0.0};
+        hw::ring_buffer<double, 256> recent{};
+    };
+
+    latency_recorder& get_input_recorder()
+    {
+        static latency_recorder recorder{};
+        return recorder;
+    }
+} // namespace
+
+void hw::record_input_latency(double const t_milliseconds)
+{
+    auto& recorder = get_input_recorder();
+    std::lock_guard<std::mutex> lock{recorder.mutex};
+
+    auto& stats = recorder.stats;
+
+    if(stats.samples == 0) {
+        stats.min = t_milliseconds;
+        stats.max = t_milliseconds;
+    }
+
+    ++stats.samples;
+    stats.last = t_milliseconds;
+    stats.min = std::min(stats.min, t_milliseconds);
+    stats.max = std::max(stats.max, t_milliseconds);
+
+    recorder.total += t_milliseconds;
+    recorder.recent.push(t_milliseconds);
+}
+
+hw::latency_stats hw::get_input_latency()
+{
+    auto& recorder = get_input_recorder();
+    std::lock_guard<std::mutex> lock{recorder.mutex};
+
+    hw::latency_stats result = recorder.stats;
+
+    if(result.samples == 0) {
+        return result;
+    }
+
+    result.average = recorder.total / static_cast<double>(result.samples);
+
+    std::array<double, decltype(recorder.recent)::capacity()> sorted;
+    std::size_t const count = recorder.recent.size();
+
+    for(std::size_t i = 0; i < count; ++i) {
+        sorted[i] = recorder.recent[i];
+    }
+
+    auto const nth = sorted.begin() + (count * 95) / 100;
+    std::nth_element(sorted.begin(), nth, sorted.begin() + count);
+    result.p95 = *nth;
+
+    return result;
+}
+
+void hw::reset_input_latency()
+{
+    auto& recorder = get_input_recorder();
+    std::lock_guard<std::mutex> lock{recorder.mutex};
+
+    recorder.stats = hw::latency_stats{};
+    recorder.total = 0.0;
+    recorder.recent.clear();
+}
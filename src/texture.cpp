@@ -0,0 +1,779 @@
+#include "texture.hpp"
+
+///
+/// @file texture.cpp
+///
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "SDL2/SDL_image.h"
+
+#include "asset_pack.hpp"
+#include "file_watcher.hpp"
+#include "image_filter.hpp"
+#include "thread_pool.hpp"
+
+struct hw::decoded_image
+{
+    enum state_t : int
+    {
+        decoding,
+        ready,
+        failed
+    };
+
+    std::atomic<int> state{decoding};
+    ///
+    /// ARGB8888 with the color key turned into transparent pixels, only
+    /// valid once @ref state is ready.
+    ///
+    SDL_Surface* surface{nullptr};
+    std::string error{};
+    ///
+    /// Set when @ref surface points straight into a mapped pack.
+    ///
+    std::shared_ptr<hw::asset_pack> pack{};
+    ///
+    /// Halved versions of @ref surface, already in the ready state.
+    ///
+    std::vector<std::shared_ptr<decoded_image>> levels{};
+
+    decoded_image() = default;
+    decoded_image(decoded_image const&) = delete;
+    ~decoded_image() noexcept
+    {
+        SDL_FreeSurface(surface);
+    }
+
+    decoded_image& operator=(decoded_image const&) = delete;
+};
+
+namespace {
+    ///
+    /// @brief Every texture alive and every SDL_Texture waiting to be
+    ///        destroyed.
+    ///
+    struct texture_registry
+    {
+        std::mutex mutex{};
+        std::vector<hw::texture*> live{};
+        std::vector<std::pair<SDL_Renderer*, SDL_Texture*>> pending{};
+
+        std::size_t decodes{0};
+        std::size_t bytes_resident{0};
+
+        hw::texture_atlas atlas{};
+
+        ///
+        /// Only exists while hot reload is on.
+        ///
+        std::unique_ptr<hw::file_watcher> watcher{};
+        std::vector<std::string> changed{};
+
+        std::vector<std::shared_ptr<hw::asset_pack>> packs{};
+        std::size_t pack_loads{0};
+
+        ///
+        /// See @ref hw::set_texture_budget, 0 is no limit.
+        ///
+        std::size_t budget{0};
+        std::size_t evictions{0};
+        ///
+        /// Counts calls to @ref hw::trim_textures. Only changed on the
+        /// render thread but read when uploading, so it's atomic to keep
+        /// that from needing the lock.
+        ///
+        std::atomic<std::uint64_t> frame{1};
+    };
+
+    texture_registry& get_registry()
+    {
+        static texture_registry registry;
+        return registry;
+    }
+
+    using cache_key =
+        std::tuple<std::string, std::uint8_t, std::uint8_t, std::uint8_t>;
+
+    ///
+    /// @brief Every texture handed out by @ref hw::load_texture that may
+    ///        still be alive.
+    ///
+    /// Locked before the registry when both are needed.
+    ///
+    struct texture_cache
+    {
+        std::mutex mutex{};
+        std::map<cache_key, std::weak_ptr<hw::texture>> entries{};
+
+        std::size_t hits{0};
+        std::size_t misses{0};
+    };
+
+    texture_cache& get_cache()
+    {
+        static texture_cache cache;
+        return cache;
+    }
+
+    hw::thread_pool& get_decoders()
+    {
+        static hw::thread_pool decoders{};
+        return decoders;
+    }
+
+    ///
+    /// @brief Points @ref t_result at the pixels of @ref t_path if a mounted
+    ///        pack has them, the most recently mounted pack wins.
+    ///
+    bool from_pack(std::string const& t_path, hw::color const& t_color_key,
+                   hw::decoded_image& t_result)
+    {
+        auto& registry = get_registry();
+        std::lock_guard<std::mutex> lock{registry.mutex};
+
+        for(auto it = registry.packs.rbegin(); it != registry.packs.rend();
+            ++it) {
+            hw::pack_entry const* entry = (*it)->find(t_path, t_color_key);
+
+            if(!entry) {
+                continue;
+            }
+
+            // SDL only reads from it, the mapping is read only
+            t_result.surface = SDL_CreateRGBSurfaceWithFormatFrom(
+                const_cast<void*>((*it)->pixels(*entry)),
+                static_cast<int>(entry->width),
+                static_cast<int>(entry->height), 32,
+                static_cast<int>(entry->pitch), SDL_PIXELFORMAT_ARGB8888);
+
+            if(!t_result.surface) {
+                return false;
+            }
+
+            t_result.pack = *it;
+            t_result.state.store(hw::decoded_image::ready,
+                                 std::memory_order_release);
+            ++registry.pack_loads;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    ///
+    /// No more halved versions than this are made, and none smaller than
+    /// @ref min_level_size on either side.
+    ///
+    constexpr std::size_t max_levels = 6;
+    constexpr int min_level_size = 16;
+
+    void make_levels(SDL_Surface const* t_source, hw::decoded_image& t_result)
+    {
+        SDL_Surface const* level = t_source;
+
+        while(t_result.levels.size() < max_levels &&
+              level->w / 2 >= min_level_size &&
+              level->h / 2 >= min_level_size) {
+            auto next = std::make_shared<hw::decoded_image>();
+            next->surface = hw::downscale_half(level);
+
+            if(!next->surface) {
+                break;
+            }
+
+            next->state.store(hw::decoded_image::ready,
+                              std::memory_order_release);
+            level = next->surface;
+            t_result.levels.push_back(std::move(next));
+        }
+    }
+
+    ///
+    /// @brief Runs on a worker thread, does everything except the upload.
+    ///
+    void decode_image(std::string const& t_path, hw::color const& t_color_key,
+                      hw::decoded_image& t_result)
+    {
+        SDL_Surface* img = IMG_Load(t_path.c_str());
+
+        if(!img) {
+            t_result.error = SDL_GetError();
+            t_result.state.store(hw::decoded_image::failed,
+                                 std::memory_order_release);
+            return;
+        }
+
+        SDL_SetColorKey(img, SDL_TRUE,
+                        SDL_MapRGB(img->format, t_color_key.r, t_color_key.g,
+                                   t_color_key.b));
+
+        // converting to a format with alpha makes the color key transparent
+        // so the upload is a plain copy
+        t_result.surface =
+            SDL_ConvertSurfaceFormat(img, SDL_PIXELFORMAT_ARGB8888, 0);
+
+        SDL_FreeSurface(img);
+
+        if(!t_result.surface) {
+            t_result.error = SDL_GetError();
+            t_result.state.store(hw::decoded_image::failed,
+                                 std::memory_order_release);
+            return;
+        }
+
+        {
+            auto& registry = get_registry();
+            std::lock_guard<std::mutex> lock{registry.mutex};
+            ++registry.decodes;
+        }
+
+        t_result.state.store(hw::decoded_image::ready,
+                             std::memory_order_release);
+    }
+
+    ///
+    /// @brief Runs on a worker thread, loads the image again and puts its
+    ///        halved versions in the levels of @ref t_result.
+    ///
+    /// The full size pixels are gone once they are uploaded, and most
+    /// images are never drawn smaller, so the halved versions are only
+    /// made for the ones that are.
+    ///
+    void build_levels(std::string const& t_path, hw::color const& t_color_key,
+                      hw::decoded_image& t_result)
+    {
+        hw::decoded_image full{};
+
+        if(!from_pack(t_path, t_color_key, full)) {
+            decode_image(t_path, t_color_key, full);
+        }
+
+        if(full.state.load(std::memory_order_acquire) !=
+           hw::decoded_image::ready) {
+            t_result.state.store(hw::decoded_image::failed,
+                                 std::memory_order_release);
+            return;
+        }
+
+        make_levels(full.surface, t_result);
+        t_result.state.store(hw::decoded_image::ready,
+                             std::memory_order_release);
+    }
+} // namespace
+
+hw::texture::texture(std::string const& t_path, hw::color const& t_color_key)
+    : m_path(t_path)
+    , m_color_key(t_color_key)
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.live.push_back(this);
+
+    if(registry.watcher) {
+        m_watched_path = registry.watcher->watch(m_path);
+    }
+}
+
+hw::texture::~texture() noexcept
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    registry.live.erase(
+        std::remove(registry.live.begin(), registry.live.end(), this),
+        registry.live.end());
+
+    if(m_in_atlas) {
+        registry.atlas.remove(*this);
+    }
+    else if(m_handle) {
+        registry.pending.emplace_back(m_renderer, m_handle);
+        registry.bytes_resident -= m_bytes;
+    }
+}
+
+void hw::texture::decode()
+{
+    if(m_handle || m_decoded || m_failed || m_level > 0) {
+        return;
+    }
+
+    auto decoded = std::make_shared<hw::decoded_image>();
+    m_decoded = decoded;
+
+    if(from_pack(m_path, m_color_key, *decoded)) {
+        return;
+    }
+
+    std::string const path = m_path;
+    hw::color const color_key = m_color_key;
+
+    // the job keeps the result alive in case the texture goes away first
+    get_decoders().push([path, color_key, decoded] {
+        decode_image(path, color_key, *decoded);
+    });
+}
+
+void hw::texture::swap_reloaded()
+{
+    int const state = m_reload->state.load(std::memory_order_acquire);
+
+    if(state == hw::decoded_image::decoding) {
+        return;
+    }
+
+    std::shared_ptr<hw::decoded_image> reloaded = std::move(m_reload);
+
+    if(state == hw::decoded_image::failed) {
+        // keep showing what was there before
+        SDL_Log("Could not reload %s: %s\n", m_path.c_str(),
+                reloaded->error.c_str());
+        return;
+    }
+
+    this->release_upload();
+    this->forget_levels();
+    m_failed = false;
+    m_decoded = std::move(reloaded);
+}
+
+void hw::texture::release_upload()
+{
+    auto& registry = get_registry();
+
+    if(m_in_atlas) {
+        registry.atlas.remove(*this);
+    }
+    else if(m_handle) {
+        SDL_DestroyTexture(m_handle);
+        registry.bytes_resident -= m_bytes;
+    }
+
+    m_handle = nullptr;
+    m_renderer = nullptr;
+    m_in_atlas = false;
+}
+
+void hw::texture::adopt(std::shared_ptr<hw::decoded_image> const& t_decoded)
+{
+    {
+        auto& registry = get_registry();
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        this->release_upload();
+    }
+
+    m_decoded = t_decoded;
+}
+
+void hw::texture::forget_levels()
+{
+    for(auto const& level : m_levels) {
+        level->release_upload();
+        level->m_decoded.reset();
+    }
+
+    m_levels_job.reset();
+}
+
+void hw::texture::adopt_levels(hw::decoded_image const& t_decoded)
+{
+    m_levels.resize(std::min(m_levels.size(), t_decoded.levels.size()));
+
+    for(std::size_t i = 0; i < t_decoded.levels.size(); ++i) {
+        if(i == m_levels.size()) {
+            m_levels.push_back(
+                std::make_shared<hw::texture>(m_path, m_color_key));
+            m_levels.back()->m_level = static_cast<int>(i) + 1;
+        }
+
+        m_levels[i]->adopt(t_decoded.levels[i]);
+    }
+}
+
+hw::texture& hw::texture::level_for(int const t_width, int const t_height)
+{
+    std::size_t level{0};
+    int width = m_source.w;
+    int height = m_source.h;
+
+    while(level < max_levels && width / 2 >= t_width &&
+          height / 2 >= t_height && width / 2 >= min_level_size &&
+          height / 2 >= min_level_size) {
+        width /= 2;
+        height /= 2;
+        ++level;
+    }
+
+    // the size is only known once the full one was uploaded
+    if(level > 0 && m_handle && !m_levels_job) {
+        auto job = std::make_shared<hw::decoded_image>();
+        m_levels_job = job;
+
+        std::string const path = m_path;
+        hw::color const color_key = m_color_key;
+
+        get_decoders().push([path, color_key, job] {
+            build_levels(path, color_key, *job);
+        });
+    }
+
+    level = std::min(level, m_levels.size());
+
+    while(level > 0 && !m_levels[level - 1]->m_handle &&
+          !m_levels[level - 1]->m_decoded) {
+        --level;
+    }
+
+    return level == 0 ? *this : *m_levels[level - 1];
+}
+
+void hw::texture::take_levels()
+{
+    if(!m_levels_job ||
+       m_levels_job->state.load(std::memory_order_acquire) !=
+           hw::decoded_image::ready ||
+       m_levels_job->levels.empty()) {
+        return;
+    }
+
+    // the halved versions are uploaded the first time they are drawn, the
+    // job stays so they are not made again
+    this->adopt_levels(*m_levels_job);
+    m_levels_job->levels.clear();
+}
+
+SDL_Texture* hw::texture::get(SDL_Renderer* t_renderer)
+{
+    m_last_used = get_registry().frame.load(std::memory_order_relaxed);
+
+    if(m_handle || m_failed) {
+        return m_handle;
+    }
+
+    this->decode();
+
+    if(!m_decoded) {
+        return nullptr;
+    }
+
+    int const state = m_decoded->state.load(std::memory_order_acquire);
+
+    if(state == hw::decoded_image::decoding) {
+        return nullptr;
+    }
+
+    if(state == hw::decoded_image::failed) {
+        SDL_Log("Could not load %s: %s\n", m_path.c_str(),
+                m_decoded->error.c_str());
+        m_decoded.reset();
+        m_failed = true;
+        return nullptr;
+    }
+
+    // the pixels live on the GPU after this, a new renderer decodes them
+    // again
+    std::shared_ptr<hw::decoded_image> const decoded = std::move(m_decoded);
+    SDL_Surface* img = decoded->surface;
+
+    {
+        auto& registry = get_registry();
+        std::lock_guard<std::mutex> lock{registry.mutex};
+
+        if(!registry.atlas.insert(t_renderer, *this, img)) {
+            m_handle = SDL_CreateTextureFromSurface(t_renderer, img);
+            m_renderer = t_renderer;
+            m_source = SDL_Rect{0, 0, img->w, img->h};
+            m_backing_width = img->w;
+            m_backing_height = img->h;
+
+            if(!m_handle) {
+                // decoding again would fail the same way every frame
+                SDL_Log("Could not upload %s: %s\n", m_path.c_str(),
+                        SDL_GetError());
+                m_renderer = nullptr;
+                m_failed = true;
+                return nullptr;
+            }
+
+            m_bytes = static_cast<std::size_t>(img->w) *
+                      static_cast<std::size_t>(img->h) * 4;
+            registry.bytes_resident += m_bytes;
+        }
+    }
+
+    return m_handle;
+}
+
+void hw::destroy_pending_textures()
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    for(auto const& p : registry.pending) {
+        SDL_DestroyTexture(p.second);
+    }
+
+    registry.pending.clear();
+}
+
+void hw::destroy_texture_later(SDL_Renderer* t_renderer,
+                               SDL_Texture* t_handle)
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.pending.emplace_back(t_renderer, t_handle);
+}
+
+void hw::forget_textures(SDL_Renderer* t_renderer)
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    registry.pending.erase(
+        std::remove_if(registry.pending.begin(), registry.pending.end(),
+                       [t_renderer](std::pair<SDL_Renderer*, SDL_Texture*> const&
+                                        t_pending) {
+                           return t_pending.first == t_renderer;
+                       }),
+        registry.pending.end());
+
+    registry.atlas.forget(t_renderer);
+
+    for(auto* t : registry.live) {
+        if(t->m_renderer == t_renderer) {
+            if(t->m_handle && !t->m_in_atlas) {
+                registry.bytes_resident -= t->m_bytes;
+            }
+
+            t->m_handle = nullptr;
+            t->m_renderer = nullptr;
+            t->m_in_atlas = false;
+            // made again from the file for the new renderer
+            t->m_levels_job.reset();
+        }
+    }
+}
+
+std::shared_ptr<hw::texture> hw::load_texture(std::string const& t_path,
+                                              hw::color const& t_color_key)
+{
+    auto& cache = get_cache();
+    std::lock_guard<std::mutex> lock{cache.mutex};
+
+    cache_key const key{t_path, t_color_key.r, t_color_key.g, t_color_key.b};
+    auto it = cache.entries.find(key);
+
+    if(it != cache.entries.end()) {
+        std::shared_ptr<hw::texture> cached = it->second.lock();
+
+        if(cached) {
+            ++cache.hits;
+            return cached;
+        }
+    }
+
+    ++cache.misses;
+
+    // misses are rare so this is a good time to drop dead entries
+    for(auto entry = cache.entries.begin(); entry != cache.entries.end();) {
+        if(entry->second.expired()) {
+            entry = cache.entries.erase(entry);
+        }
+        else {
+            ++entry;
+        }
+    }
+
+    auto created = std::make_shared<hw::texture>(t_path, t_color_key);
+    created->decode();
+    cache.entries[key] = created;
+
+    return created;
+}
+
+void hw::set_texture_budget(std::size_t const t_bytes)
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.budget = t_bytes;
+}
+
+void hw::trim_textures()
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    std::uint64_t const frame = registry.frame.load(std::memory_order_relaxed);
+    registry.frame.store(frame + 1, std::memory_order_relaxed);
+
+    if(registry.budget == 0 ||
+       registry.bytes_resident + registry.atlas.bytes() <= registry.budget) {
+        return;
+    }
+
+    // halved versions go together with the image they belong to, which is
+    // drawn whenever one of them is
+    std::vector<hw::texture*> candidates;
+
+    for(auto* t : registry.live) {
+        if(t->m_level == 0 && t->m_handle && !t->m_in_atlas &&
+           t->m_last_used < frame) {
+            candidates.push_back(t);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](hw::texture const* t_lhs, hw::texture const* t_rhs) {
+                  return t_lhs->m_last_used < t_rhs->m_last_used;
+              });
+
+    for(auto* t : candidates) {
+        if(registry.bytes_resident + registry.atlas.bytes() <=
+           registry.budget) {
+            break;
+        }
+
+        t->release_upload();
+        t->forget_levels();
+
+        ++registry.evictions;
+    }
+}
+
+hw::texture_stats hw::get_texture_stats()
+{
+    hw::texture_stats stats{};
+
+    {
+        auto& cache = get_cache();
+        std::lock_guard<std::mutex> lock{cache.mutex};
+        stats.hits = cache.hits;
+        stats.misses = cache.misses;
+    }
+
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    stats.decodes = registry.decodes;
+    stats.pack_loads = registry.pack_loads;
+    stats.bytes_resident = registry.bytes_resident + registry.atlas.bytes();
+    stats.textures_alive = registry.live.size();
+    stats.textures_resident = static_cast<std::size_t>(
+        std::count_if(registry.live.begin(), registry.live.end(),
+                      [](hw::texture const* t_texture) {
+                          return t_texture->resident();
+                      }));
+    stats.evictions = registry.evictions;
+    stats.budget = registry.budget;
+
+    return stats;
+}
+
+void hw::wait_for_textures()
+{
+    get_decoders().wait_idle();
+}
+
+hw::atlas_stats hw::get_atlas_stats()
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    return registry.atlas.stats();
+}
+
+void hw::set_texture_hot_reload(bool const t_enabled)
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    if(!t_enabled) {
+        registry.watcher.reset();
+
+        for(auto* t : registry.live) {
+            t->m_watched_path.clear();
+        }
+        return;
+    }
+
+    if(registry.watcher) {
+        return;
+    }
+
+    registry.watcher.reset(new hw::file_watcher{});
+
+    for(auto* t : registry.live) {
+        t->m_watched_path = registry.watcher->watch(t->m_path);
+    }
+}
+
+void hw::reload_changed_textures()
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    if(!registry.watcher) {
+        return;
+    }
+
+    registry.changed.clear();
+    registry.watcher->poll(registry.changed);
+
+    if(registry.changed.empty()) {
+        return;
+    }
+
+    for(auto* t : registry.live) {
+        // halved versions are refreshed by the texture they came from
+        if(t->m_level > 0 || t->m_watched_path.empty() ||
+           std::find(registry.changed.begin(), registry.changed.end(),
+                     t->m_watched_path) == registry.changed.end()) {
+            continue;
+        }
+
+        // a file saved twice quickly only needs the newest version
+        auto decoded = std::make_shared<hw::decoded_image>();
+        t->m_reload = decoded;
+
+        std::string const path = t->m_path;
+        hw::color const color_key = t->m_color_key;
+
+        get_decoders().push([path, color_key, decoded] {
+            decode_image(path, color_key, *decoded);
+        });
+    }
+}
+
+void hw::swap_reloaded_textures()
+{
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    for(auto* t : registry.live) {
+        if(t->m_reload) {
+            t->swap_reloaded();
+        }
+    }
+}
+
+bool hw::mount_asset_pack(std::string const& t_path)
+{
+    std::shared_ptr<hw::asset_pack> pack = hw::asset_pack::open(t_path);
+
+    if(!pack) {
+        return false;
+    }
+
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.packs.push_back(std::move(pack));
+
+    return true;
+}
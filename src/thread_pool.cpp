@@ -0,0 +1,82 @@
+#include "thread_pool.hpp"
+
+///
+/// @file thread_pool.cpp
+///
+
+#include <utility>
+
+hw::thread_pool::thread_pool(std::size_t const t_threads)
+{
+    std::size_t count = t_threads;
+
+    if(count == 0) {
+        unsigned const cores = std::thread::hardware_concurrency();
+        count = cores > 1 ? cores - 1 : 1;
+    }
+
+    m_threads.reserve(count);
+
+    for(std::size_t i = 0; i < count; ++i) {
+        m_threads.emplace_back(&thread_pool::run, this);
+    }
+}
+
+hw::thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_stop = true;
+    }
+
+    m_work.notify_all();
+
+    for(auto& t : m_threads) {
+        t.join();
+    }
+}
+
+void hw::thread_pool::run()
+{
+    while(true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_work.wait(lock, [this] { return !m_tasks.empty() || m_stop; });
+
+            if(m_tasks.empty()) {
+                break;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            --m_unfinished;
+        }
+
+        m_idle.notify_all();
+    }
+}
+
+void hw::thread_pool::push(std::function<void()> t_task)
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_tasks.push_back(std::move(t_task));
+        ++m_unfinished;
+    }
+
+    m_work.notify_one();
+}
+
+void hw::thread_pool::wait_idle()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_idle.wait(lock, [this] { return m_unfinished == 0; });
+}
@@ -0,0 +1,220 @@
+#include "tile_map.hpp"
+
+///
+/// @file tile_map.cpp
+///
+
+#include <algorithm>
+#include <mutex>
+
+namespace {
+    ///
+    /// @brief Every chunk alive, so they can let go of a renderer that is
+    ///        about to be destroyed.
+    ///
+    struct chunk_registry
+    {
+        std::mutex mutex{};
+        std::vector<hw::tile_chunk*> live{};
+    };
+
+    chunk_registry& get_chunk_registry()
+    {
+        static chunk_registry registry;
+        return registry;
+    }
+
+    void push_tile(std::vector<SDL_Vertex>& t_vertices,
+                   std::vector<int>& t_indices, float const t_x0,
+                   float const t_y0, float const t_x1, float const t_y1,
+                   SDL_Color const& t_color, float const t_u0,
+                   float const t_v0, float const t_u1, float const t_v1)
+    {
+        int const base = static_cast<int>(t_vertices.size());
+
+        t_vertices.push_back(SDL_Vertex{SDL_FPoint{t_x0, t_y0}, t_color,
+                                        SDL_FPoint{t_u0, t_v0}});
+        t_vertices.push_back(SDL_Vertex{SDL_FPoint{t_x1, t_y0}, t_color,
+                                        SDL_FPoint{t_u1, t_v0}});
+        t_vertices.push_back(SDL_Vertex{SDL_FPoint{t_x1, t_y1}, t_color,
+                                        SDL_FPoint{t_u1, t_v1}});
+        t_vertices.push_back(SDL_Vertex{SDL_FPoint{t_x0, t_y1}, t_color,
+                                        SDL_FPoint{t_u0, t_v1}});
+
+        int const quad[] = {0, 1, 2, 0, 2, 3};
+
+        for(int const index : quad) {
+            t_indices.push_back(base + index);
+        }
+    }
+} // namespace
+
+hw::tile_chunk::tile_chunk(int const t_columns, int const t_rows,
+                           hw::vec2 const& t_tile)
+    : m_columns(t_columns)
+    , m_rows(t_rows)
+    , m_tile(t_tile)
+{
+    auto& registry = get_chunk_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.live.push_back(this);
+}
+
+hw::tile_chunk::~tile_chunk() noexcept
+{
+    auto& registry = get_chunk_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    registry.live.erase(
+        std::remove(registry.live.begin(), registry.live.end(), this),
+        registry.live.end());
+
+    if(m_handle) {
+        hw::destroy_texture_later(m_renderer, m_handle);
+    }
+}
+
+void hw::tile_chunk::render(SDL_Renderer* t_renderer, int const* t_tiles,
+                            hw::texture* t_tileset,
+                            hw::color const* t_palette,
+                            std::size_t const t_palette_size,
+                            std::vector<SDL_Vertex>& t_vertices,
+                            std::vector<int>& t_indices)
+{
+    if(!m_handle) {
+        if(!SDL_RenderTargetSupported(t_renderer)) {
+            return;
+        }
+
+        m_handle = SDL_CreateTexture(t_renderer, SDL_PIXELFORMAT_ARGB8888,
+                                     SDL_TEXTUREACCESS_TARGET, this->width(),
+                                     this->height());
+
+        if(!m_handle) {
+            SDL_Log("Could not create a tile chunk: %s\n", SDL_GetError());
+            return;
+        }
+
+        SDL_SetTextureBlendMode(m_handle, SDL_BLENDMODE_BLEND);
+        m_renderer = t_renderer;
+    }
+
+    SDL_Texture* tileset{nullptr};
+    SDL_Rect source{0, 0, 0, 0};
+    float backing_width{1.0f};
+    float backing_height{1.0f};
+    int tileset_columns{1};
+
+    if(t_tileset) {
+        tileset = t_tileset->get(t_renderer);
+
+        // asked for again next frame, once the image is decoded
+        if(!tileset) {
+            return;
+        }
+
+        source = t_tileset->source();
+        backing_width = static_cast<float>(t_tileset->backing_width());
+        backing_height = static_cast<float>(t_tileset->backing_height());
+        tileset_columns = std::max(1, source.w / m_tile.x);
+    }
+
+    t_vertices.clear();
+    t_indices.clear();
+
+    float const tile_width = static_cast<float>(m_tile.x);
+    float const tile_height = static_cast<float>(m_tile.y);
+
+    for(int row = 0; row < m_rows; ++row) {
+        for(int column = 0; column < m_columns; ++column) {
+            int const tile = t_tiles[row * m_columns + column];
+            float const x = static_cast<float>(column) * tile_width;
+            float const y = static_cast<float>(row) * tile_height;
+
+            if(tile < 0) {
+                continue;
+            }
+
+            if(!tileset) {
+                if(static_cast<std::size_t>(tile) >= t_palette_size) {
+                    continue;
+                }
+
+                hw::color const& c = t_palette[tile];
+
+                push_tile(t_vertices, t_indices, x, y, x + tile_width,
+                          y + tile_height, SDL_Color{c.r, c.g, c.b, c.a},
+                          0.0f, 0.0f, 0.0f, 0.0f);
+                continue;
+            }
+
+            float const u = static_cast<float>(
+                source.x + (tile % tileset_columns) * m_tile.x);
+            float const v = static_cast<float>(
+                source.y + (tile / tileset_columns) * m_tile.y);
+
+            push_tile(t_vertices, t_indices, x, y, x + tile_width,
+                      y + tile_height, SDL_Color{255, 255, 255, 255},
+                      u / backing_width, v / backing_height,
+                      (u + tile_width) / backing_width,
+                      (v + tile_height) / backing_height);
+        }
+    }
+
+    SDL_Texture* previous = SDL_GetRenderTarget(t_renderer);
+
+    SDL_SetRenderTarget(t_renderer, m_handle);
+    SDL_SetRenderDrawColor(t_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(t_renderer);
+
+    // tiles do not overlap, they replace the cleared pixels alpha included
+    if(tileset) {
+        SDL_SetTextureBlendMode(tileset, SDL_BLENDMODE_NONE);
+    }
+    else {
+        SDL_SetRenderDrawBlendMode(t_renderer, SDL_BLENDMODE_NONE);
+    }
+
+    if(!t_indices.empty()) {
+        SDL_RenderGeometry(t_renderer, tileset, t_vertices.data(),
+                           static_cast<int>(t_vertices.size()),
+                           t_indices.data(),
+                           static_cast<int>(t_indices.size()));
+    }
+
+    SDL_SetRenderTarget(t_renderer, previous);
+    m_needs_tiles.store(false, std::memory_order_release);
+}
+
+SDL_Texture* hw::tile_chunk::get(SDL_Renderer* t_renderer) const noexcept
+{
+    if(m_renderer != t_renderer || this->needs_tiles()) {
+        return nullptr;
+    }
+
+    return m_handle;
+}
+
+void hw::forget_tile_chunks(SDL_Renderer* t_renderer)
+{
+    auto& registry = get_chunk_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    for(auto* c : registry.live) {
+        if(c->m_renderer == t_renderer) {
+            c->m_handle = nullptr;
+            c->m_renderer = nullptr;
+            c->m_needs_tiles.store(true, std::memory_order_release);
+        }
+    }
+}
+
+void hw::reset_tile_chunks()
+{
+    auto& registry = get_chunk_registry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    for(auto* c : registry.live) {
+        c->m_needs_tiles.store(true, std::memory_order_release);
+    }
+}
@@ -0,0 +1,122 @@
+#include "triangulate.hpp"
+
+///
+/// @file triangulate.cpp
+///
+
+namespace {
+    ///
+    /// @brief Twice the area of the polygon, positive when the corners go
+    ///        clockwise on the screen.
+    ///
+    float signed_area(hw::vec2f const* t_points,
+                      std::size_t const t_count) noexcept
+    {
+        float area{0.0f};
+
+        for(std::size_t i = 0, j = t_count - 1; i < t_count; j = i++) {
+            area += hw::cross(t_points[j], t_points[i]);
+        }
+
+        return area;
+    }
+
+    ///
+    /// @brief Whether @ref t_point is inside or on the edges of the
+    ///        triangle @ref t_a, @ref t_b, @ref t_c, given clockwise.
+    ///
+    bool inside(hw::vec2f const& t_point, hw::vec2f const& t_a,
+                hw::vec2f const& t_b, hw::vec2f const& t_c) noexcept
+    {
+        return hw::cross(t_b - t_a, t_point - t_a) >= 0.0f &&
+               hw::cross(t_c - t_b, t_point - t_b) >= 0.0f &&
+               hw::cross(t_a - t_c, t_point - t_c) >= 0.0f;
+    }
+} // namespace
+
+bool hw::triangulate(hw::vec2f const* t_points, std::size_t const t_count,
+                     std::vector<int>& t_indices)
+{
+    t_indices.clear();
+
+    if(t_count < 3) {
+        return false;
+    }
+
+    float const area = signed_area(t_points, t_count);
+
+    if(area == 0.0f) {
+        return false;
+    }
+
+    // the corners still to be clipped, always walked clockwise
+    std::vector<int> remaining(t_count);
+
+    for(std::size_t i = 0; i < t_count; ++i) {
+        remaining[i] = static_cast<int>(area > 0.0f ? i : t_count - 1 - i);
+    }
+
+    t_indices.reserve((t_count - 2) * 3);
+
+    std::size_t current{0};
+    std::size_t misses{0};
+
+    while(remaining.size() > 3) {
+        std::size_t const n = remaining.size();
+        std::size_t const prev = (current + n - 1) % n;
+        std::size_t const next = (current + 1) % n;
+
+        hw::vec2f const& a = t_points[remaining[prev]];
+        hw::vec2f const& b = t_points[remaining[current]];
+        hw::vec2f const& c = t_points[remaining[next]];
+
+        bool ear = hw::cross(b - a, c - b) > 0.0f;
+
+        for(std::size_t i = 0; ear && i < n; ++i) {
+            if(i == prev || i == current || i == next) {
+                continue;
+            }
+
+            hw::vec2f const& p = t_points[remaining[i]];
+
+            // corners shared with the triangle do not stop it from being
+            // an ear, polygons that touch themselves have those
+            if(p != a && p != b && p != c && inside(p, a, b, c)) {
+                ear = false;
+            }
+        }
+
+        if(!ear) {
+            current = next;
+
+            if(++misses < n) {
+                continue;
+            }
+
+            // no ear left means the polygon crosses itself, what is left
+            // is filled as a fan so the shape still shows up
+            for(std::size_t i = 1; i + 1 < n; ++i) {
+                t_indices.push_back(remaining[0]);
+                t_indices.push_back(remaining[i]);
+                t_indices.push_back(remaining[i + 1]);
+            }
+
+            return false;
+        }
+
+        t_indices.push_back(remaining[prev]);
+        t_indices.push_back(remaining[current]);
+        t_indices.push_back(remaining[next]);
+
+        remaining.erase(remaining.begin() +
+                        static_cast<std::ptrdiff_t>(current));
+        current = current % remaining.size();
+        misses = 0;
+    }
+
+    t_indices.push_back(remaining[0]);
+    t_indices.push_back(remaining[1]);
+    t_indices.push_back(remaining[2]);
+
+    return true;
+}
@@ -1,11 +0,0 @@
-#include "vec2.hpp"
-
-///
-/// @file vec2.cpp
-///
-
-hw::vec2::vec2(int t_x, int t_y)
-    : x(t_x)
-    , y(t_y)
-{
-}
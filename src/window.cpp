@@ -6,12 +6,15 @@
 
 #include <utility>
 
+#include "canvas.hpp"
+#include "texture.hpp"
+#include "tile_map.hpp"
+
 hw::window::window(const int t_width, const int t_height, const char* t_name)
     : m_window(nullptr)
     , m_renderer(nullptr)
     , m_width(t_width)
     , m_height(t_height)
-    , m_event_queue(std::vector<SDL_Event>{})
     , m_color{0, 0, 0, 255}
 {
     SDL_Init(SDL_INIT_VIDEO);
@@ -22,42 +25,202 @@ hw::window::window(const int t_width, const int t_height, const char* t_name)
 
     SDL_SetWindowResizable(m_window, SDL_FALSE);
 
-    // keep SDL_RENDERER_PRESENTVSYNC so that when somebody decides to
-    // change something about a primitive and their computer is
-    // beefy it won't seem like nothing is happening(and hopefully less
-    // glitches will appear)
-    m_renderer = SDL_CreateRenderer(
-        m_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-
-    m_event_queue.reserve(10);
+    this->create_renderer();
 
     if(!m_window) {
         SDL_Log("Could not initialize window %s \n", SDL_GetError());
     }
 }
 
+hw::window::window(const int t_width, const int t_height, hw::headless_t)
+    : m_window(nullptr)
+    , m_renderer(nullptr)
+    , m_surface(nullptr)
+    , m_width(t_width)
+    , m_height(t_height)
+    , m_color{0, 0, 0, 255}
+{
+    SDL_Init(SDL_INIT_EVENTS);
+
+    m_surface = SDL_CreateRGBSurfaceWithFormat(0, m_width, m_height, 32,
+                                               SDL_PIXELFORMAT_ARGB8888);
+
+    if(!m_surface) {
+        SDL_Log("Could not create headless surface %s \n", SDL_GetError());
+        return;
+    }
+
+    this->create_renderer();
+}
+
 hw::window::~window()
 {
-    SDL_DestroyRenderer(m_renderer);
+    this->destroy_renderer();
     SDL_DestroyWindow(m_window);
+    SDL_FreeSurface(m_surface);
 
     SDL_Quit();
 }
 
-void hw::window::update()
+void hw::window::create_renderer()
+{
+    if(m_renderer) {
+        return;
+    }
+
+    if(m_surface) {
+        m_renderer = SDL_CreateSoftwareRenderer(m_surface);
+        return;
+    }
+
+    // keep SDL_RENDERER_PRESENTVSYNC so that when somebody decides to
+    // change something about a primitive and their computer is
+    // beefy it won't seem like nothing is happening(and hopefully less
+    // glitches will appear)
+    m_renderer = SDL_CreateRenderer(
+        m_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+}
+
+void hw::window::destroy_renderer()
+{
+    if(!m_renderer) {
+        return;
+    }
+
+    hw::forget_textures(m_renderer);
+    hw::forget_canvases(m_renderer);
+    hw::forget_tile_chunks(m_renderer);
+    SDL_DestroyRenderer(m_renderer);
+    m_renderer = nullptr;
+}
+
+void hw::window::present()
 {
     SDL_RenderPresent(m_renderer);
+}
+
+void hw::window::update()
+{
+    present();
     handle_events();
 }
 
+constexpr std::size_t hw::window::key_count;
+
+void hw::window::fold_event(SDL_Event const& t_event) noexcept
+{
+    switch(t_event.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+    case SDL_MOUSEMOTION:
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        if(m_input_time == 0 || t_event.common.timestamp < m_input_time) {
+            m_input_time = t_event.common.timestamp;
+        }
+        break;
+    default:
+        break;
+    }
+
+    switch(t_event.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP: {
+        int const index = key_index(t_event.key.keysym.sym);
+
+        if(index < 0) {
+            break;
+        }
+
+        if(t_event.type == SDL_KEYDOWN) {
+            m_pressed.set(static_cast<std::size_t>(index));
+        }
+        else {
+            m_released.set(static_cast<std::size_t>(index));
+        }
+        break;
+    }
+    case SDL_MOUSEMOTION:
+        m_mouse = hw::vec2{t_event.motion.x, t_event.motion.y};
+        m_mouse_delta += hw::vec2{t_event.motion.xrel, t_event.motion.yrel};
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+        m_buttons_pressed |= SDL_BUTTON(t_event.button.button);
+        m_events.push(t_event);
+        break;
+    case SDL_QUIT:
+        m_closed = true;
+        m_events.push(t_event);
+        break;
+    case SDL_RENDER_TARGETS_RESET:
+        hw::reset_tile_chunks();
+        m_events.push(t_event);
+        break;
+    default:
+        m_events.push(t_event);
+        break;
+    }
+}
+
 void hw::window::handle_events()
 {
-    m_event_queue.clear();
+    m_events.clear();
+    m_pressed.reset();
+    m_released.reset();
+    m_mouse_delta = hw::vec2{0, 0};
+    m_buttons_pressed = 0;
+    m_input_time = 0;
+
+    SDL_PumpEvents();
+
+    int constexpr batch_size = 64;
+    SDL_Event batch[batch_size];
+    int fetched{0};
+
+    do {
+        fetched = SDL_PeepEvents(batch, batch_size, SDL_GETEVENT,
+                                 SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+        for(int i = 0; i < fetched; ++i) {
+            fold_event(batch[i]);
+        }
+    } while(fetched == batch_size);
+
+    // rebuilt instead of following button events, a release outside the
+    // window or after losing focus never shows up as one
+    m_buttons_held = SDL_GetMouseState(nullptr, nullptr);
+
+    // the keyboard state is indexed by scancode, so layouts other than
+    // qwerty still map to the right KEY_*
+    int count{0};
+    Uint8 const* state = SDL_GetKeyboardState(&count);
+
+    m_held.reset();
+
+    for(int scancode = 0; scancode < count; ++scancode) {
+        if(!state[scancode]) {
+            continue;
+        }
+
+        int const index = key_index(
+            SDL_GetKeyFromScancode(static_cast<SDL_Scancode>(scancode)));
+
+        if(index >= 0) {
+            m_held.set(static_cast<std::size_t>(index));
+        }
+    }
+}
+
+double hw::window::refresh_interval() const noexcept
+{
+    SDL_DisplayMode mode;
 
-    SDL_Event event;
-    while(SDL_PollEvent(&event)) {
-        m_event_queue.push_back(event);
+    if(m_window == nullptr || SDL_GetWindowDisplayMode(m_window, &mode) != 0 ||
+       mode.refresh_rate <= 0) {
+        return 1000.0 / 60.0;
     }
+
+    return 1000.0 / mode.refresh_rate;
 }
 
 void hw::window::set_bgcolor(const std::uint8_t t_r, const std::uint8_t t_g,
@@ -83,30 +246,54 @@ void hw::window::clear()
     SDL_RenderClear(m_renderer);
 }
 
-bool hw::window::was_key_pressed(int t_key)
+SDL_Surface* hw::window::capture()
 {
-    for(const auto& event : m_event_queue) {
-        switch(event.type) {
-        case SDL_KEYDOWN:
-            return t_key == event.key.keysym.sym;
-        default:
-            break;
-        }
+    SDL_Surface* result = SDL_CreateRGBSurfaceWithFormat(
+        0, m_width, m_height, 32, SDL_PIXELFORMAT_ARGB8888);
+
+    if(!result) {
+        return nullptr;
+    }
+
+    if(SDL_RenderReadPixels(m_renderer, nullptr, SDL_PIXELFORMAT_ARGB8888,
+                            result->pixels, result->pitch) != 0) {
+        SDL_Log("Could not read back pixels %s \n", SDL_GetError());
+        SDL_FreeSurface(result);
+        return nullptr;
     }
 
-    return false;
+    return result;
 }
 
-bool hw::window::closed()
+int hw::window::key_index(int const t_key) noexcept
 {
-    for(const auto& event : m_event_queue) {
-        switch(event.type) {
-        case SDL_QUIT:
-            return true;
-        default:
-            break;
-        }
+    if(t_key & SDLK_SCANCODE_MASK) {
+        int const scancode = t_key & ~SDLK_SCANCODE_MASK;
+        return scancode < SDL_NUM_SCANCODES ? 128 + scancode : -1;
     }
 
-    return false;
+    return t_key >= 0 && t_key < 128 ? t_key : -1;
+}
+
+bool hw::window::was_key_pressed(int t_key) const noexcept
+{
+    int const index = key_index(t_key);
+    return index >= 0 && m_pressed.test(static_cast<std::size_t>(index));
+}
+
+bool hw::window::was_key_released(int t_key) const noexcept
+{
+    int const index = key_index(t_key);
+    return index >= 0 && m_released.test(static_cast<std::size_t>(index));
+}
+
+bool hw::window::is_key_held(int t_key) const noexcept
+{
+    int const index = key_index(t_key);
+    return index >= 0 && m_held.test(static_cast<std::size_t>(index));
+}
+
+bool hw::window::closed() const noexcept
+{
+    return m_closed;
 }
@@ -0,0 +1,23 @@
+#include "graphics.hpp"
+
+// Line.png cut into a 4x2 sprite sheet. The left image plays the frames by
+// itself, the right one only changes frame when n is pressed. All of them
+// come from a single texture.
+int main()
+{
+    preload("../media/Line.png");
+    wait_all();
+
+    Image playing{"../media/Line.png", 40, 150, 256, 216};
+    playing.set_frame_grid(640, 540, 4, 8);
+    playing.animate(0.25);
+
+    Image stepped{"../media/Line.png", 344, 150, 256, 216};
+    stepped.set_frame_grid(640, 540, 4, 8);
+
+    return draw(WITH {
+        if(key(KEY_n)) {
+            stepped.set_frame(stepped.frame() + 1);
+        }
+    });
+}
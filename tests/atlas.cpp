@@ -0,0 +1,27 @@
+#include <memory>
+#include <vector>
+
+#include "graphics.hpp"
+
+// 400 images of two different files, drawn one file after the other. Images
+// that share a texture and are drawn one after another go out in a single
+// call, so the whole grid takes two. Files of at most 256x256 pixels would
+// also share one atlas page and take a single call even when mixed.
+int main()
+{
+    preload("../media/Triangle.png");
+    preload("../media/Line.png");
+    wait_all();
+
+    std::vector<std::unique_ptr<Image>> images;
+
+    for(int i = 0; i < 400; ++i) {
+        char const* path =
+            (i < 300) ? "../media/Triangle.png" : "../media/Line.png";
+
+        images.emplace_back(
+            new Image{path, (i % 20) * 32, (i / 20) * 24, 30, 22});
+    }
+
+    return draw();
+}
@@ -0,0 +1,71 @@
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graphics.hpp"
+
+// 3000 balls bouncing around the window, red while they touch another one
+// or the square that follows the mouse. Finding who touches whom takes a
+// fraction of a millisecond.
+int main()
+{
+    struct ball
+    {
+        std::unique_ptr<Circle> shape;
+        hw::vec2f pos;
+        hw::vec2f velocity;
+    };
+
+    Collisions collisions{};
+    std::vector<ball> balls;
+
+    for(int i = 0; i < 3000; ++i) {
+        float const angle = static_cast<float>(i) * 0.618f;
+        float const speed = 30.0f + static_cast<float>(i % 90);
+        hw::vec2f const pos{static_cast<float>((i * 7919) % width()),
+                            static_cast<float>((i * 104729) % height())};
+
+        balls.push_back(ball{
+            std::unique_ptr<Circle>(new Circle{hw::vec2{pos}, 3 + i % 4}),
+            pos,
+            hw::vec2f{std::cos(angle) * speed, std::sin(angle) * speed}});
+        collisions.add(*balls.back().shape);
+    }
+
+    Rectangle cursor{0, 0, 60, 60, BLUE};
+    collisions.add(cursor);
+
+    return draw(WITH {
+        float const step = static_cast<float>(elapsed_time);
+
+        for(auto& b : balls) {
+            b.pos += b.velocity * step;
+
+            if(b.pos.x < 0.0f || b.pos.x > static_cast<float>(width())) {
+                b.velocity.x = -b.velocity.x;
+            }
+            if(b.pos.y < 0.0f || b.pos.y > static_cast<float>(height())) {
+                b.velocity.y = -b.velocity.y;
+            }
+
+            b.shape->pos() = hw::vec2{b.pos};
+            b.shape->color() = WHITE;
+        }
+
+        cursor.pos() = hw::vec2{mouse_x() - 30, mouse_y() - 30};
+
+        auto const& hits = collisions.update();
+
+        for(auto const& hit : hits) {
+            if(hit.first != &cursor) {
+                static_cast<Circle*>(hit.first)->color() = RED;
+            }
+            if(hit.second != &cursor) {
+                static_cast<Circle*>(hit.second)->color() = RED;
+            }
+        }
+
+        text(10, 10, std::to_string(hits.size()) + " collisions", WHITE);
+    });
+}
@@ -0,0 +1,24 @@
+#include "graphics.hpp"
+
+// A cubic Bezier whose second control point follows the mouse, and a pie
+// chart. Only the curve that moves is flattened again, the slices keep
+// their lines from the first frame.
+int main()
+{
+    Arc red{480, 240, 100, 0.0f, 120.0f, RED};
+    Arc green{480, 240, 100, 120.0f, 200.0f, GREEN};
+    Arc blue{480, 240, 100, 200.0f, 360.0f, BLUE};
+
+    red.set_filled(true);
+    green.set_filled(true);
+    blue.set_filled(true);
+
+    Bezier curve{hw::vec2{20, 400}, hw::vec2{100, 50}, hw::vec2{200, 400},
+                 hw::vec2{320, 100}, WHITE};
+
+    return draw(WITH {
+        curve.points()[2] = hw::vec2{mouse_x(), mouse_y()};
+
+        outline_circle(mouse_x(), mouse_y(), 4, YELLOW);
+    });
+}
@@ -0,0 +1,41 @@
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "graphics.hpp"
+
+// Pages through 40 copies of Line.png, each one a different texture since
+// they have different color keys. Together they would take about 440 MB of
+// video memory, with the budget only the last few pages shown stay loaded
+// and going back further loads them again. n and p change the page.
+int main()
+{
+    set_texture_budget(64);
+
+    std::vector<std::unique_ptr<Image>> pages;
+
+    for(int i = 0; i < 40; ++i) {
+        pages.emplace_back(new Image{"../media/Line.png", 0, 0, width(),
+                                     height()});
+        pages.back()->set_color_key(
+            hw::color{static_cast<std::uint8_t>(i), 0, 0});
+        pages.back()->hide();
+    }
+
+    int current = 0;
+    pages[0]->show();
+
+    return draw(WITH {
+        int const previous = current;
+
+        if(key(KEY_n)) {
+            current = (current + 1) % 40;
+        }
+        if(key(KEY_p)) {
+            current = (current + 39) % 40;
+        }
+
+        pages[previous]->hide();
+        pages[current]->show();
+    });
+}
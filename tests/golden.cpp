@@ -0,0 +1,957 @@
+///
+/// @file golden.cpp
+/// Golden image tests. Every scene is rendered offscreen with
+/// @ref dummy_api::draw_to_file and compared pixel by pixel against
+/// a reference image stored in tests/golden/<scene>.png.
+///
+/// Usage:
+/// @code
+/// golden <scene> <reference dir> <output dir> [tolerance] [max pixels]
+/// golden --list
+/// @endcode
+/// `tolerance` is the biggest difference allowed on any channel of a pixel
+/// (0 by default, meaning an exact match) and `max pixels` is how many
+/// pixels are allowed to be over that tolerance (also 0 by default).
+///
+/// When a scene fails, the rendered image and a diff image (differing pixels
+/// in red over a faded copy of the reference) are written to the output
+/// directory. A scene without a reference fails, which is why CMake only
+/// enables the tests of scenes whose reference is committed. Set the
+/// HW_GOLDEN_UPDATE environment variable(when configuring too) to write the
+/// rendered images as the references, for new scenes or after an
+/// intentional change in output, and commit them.
+///
+/// The scenes mirror the first frame of the other programs in this directory
+/// plus some edge cases that the rasterizers have to survive. Programs that
+/// move on their own get a few fixed steps of 1/60 s instead: sprite_batch
+/// is covered by `sprites`, image_zoom by `minified` and gallery by
+/// `texture_budget`. low_latency follows the mouse and pipelined sums two
+/// million std::sin calls per frame, whose last bits differ between C
+/// libraries, so neither has a scene.
+///
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SDL2/SDL_image.h"
+
+#include "graphics.hpp"
+
+#ifndef HW_MEDIA_DIR
+#define HW_MEDIA_DIR "../media/"
+#endif
+#ifndef HW_PACK_FILE
+#define HW_PACK_FILE "media.hwpack"
+#endif
+
+namespace {
+    bool basic_example(std::string const& t_out)
+    {
+        point(20, 30, hw::color{23, 147, 60});
+        line(50, 60, 300, 400, hw::color{50, 60, 230});
+        outline_triangle(360, 20, 360, 220, 520, 20, hw::color{245, 45, 30});
+        rectangle(140, 300, 200, 100);
+        outline_rectangle(380, 100, 200, 100);
+
+        return draw_to_file(t_out);
+    }
+
+    bool points(std::string const& t_out)
+    {
+        for(int i = 0; i < 20; ++i) {
+            point(i + 200, 300, GREEN);
+        }
+
+        return draw_to_file(t_out, WITH {
+            for(int i = 0; i < 20; ++i) {
+                point(i + 200, 400, RED);
+            }
+        });
+    }
+
+    bool lines(std::string const& t_out)
+    {
+        line(50, 60, 300, 400);
+        line(width() / 2 - 100, height() / 2 - 100, width() / 2 + 100,
+             height() / 2 - 100);
+
+        return draw_to_file(t_out, WITH {
+            line(width() / 2 - 100, height() / 2 + 100, width() / 2 + 100,
+                 height() / 2 + 100);
+        });
+    }
+
+    bool rectangles(std::string const& t_out)
+    {
+        rectangle(hw::vec2{20, 20}, 200, 50);
+        rectangle(hw::vec2{20, 100}, 200, 50, hw::color{20, 255, 30});
+        rectangle(20, 180, 200, 50);
+        rectangle(20, 260, 200, 50, hw::color{180, 10, 10, 34});
+
+        Rectangle a{hw::vec2{20, 340}, 200, 50};
+        Rectangle b{hw::vec2{20, 420}, 200, 50, hw::color{90, 90, 20}};
+        Rectangle c{320, 20, 200, 50};
+        Rectangle d{320, 100, 200, 50, hw::color{23, 150, 160}};
+
+        outline_rectangle(hw::vec2{320, 180}, 200, 50);
+        outline_rectangle(320, 260, 200, 50, hw::color{180, 10, 10, 34});
+
+        OutlineRectangle e{hw::vec2{320, 340}, 200, 50};
+        OutlineRectangle f{320, 420, 200, 50, hw::color{23, 150, 160}};
+
+        return draw_to_file(t_out);
+    }
+
+    bool triangles(std::string const& t_out)
+    {
+        triangle(hw::vec2{50, 20}, hw::vec2{20, 80}, hw::vec2{70, 80});
+        triangle(hw::vec2{50, 120}, hw::vec2{20, 180}, hw::vec2{70, 180},
+                 hw::color{234, 192, 45});
+        triangle(50, 220, 20, 280, 70, 280);
+        triangle(50, 320, 20, 380, 70, 380, hw::color{35, 67, 89});
+
+        Triangle a{hw::vec2{220, 20}, hw::vec2{190, 80}, hw::vec2{230, 80}};
+        Triangle b{hw::vec2{220, 120}, hw::vec2{190, 180}, hw::vec2{230, 180},
+                   hw::color{90, 90, 20}};
+        Triangle c{220, 220, 190, 280, 230, 280};
+
+        outline_triangle(hw::vec2{350, 20}, hw::vec2{320, 80},
+                         hw::vec2{370, 80});
+        OutlineTriangle d{520, 320, 490, 380, 530, 380,
+                          hw::color{23, 150, 160}};
+
+        return draw_to_file(t_out, WITH {
+            triangle(width() / 2, height() / 2 - 100, width() / 2 - 100,
+                     height() / 2 + 100, width() / 2 + 100,
+                     height() / 2 + 100, RED);
+        });
+    }
+
+    bool big_triangles(std::string const& t_out)
+    {
+        set_width(1280);
+        set_height(720);
+
+        triangle(100, 20, 40, 220, 1000, 700, LIME);
+        triangle(1000, 700, 900, 600, 100, 20, CYAN);
+        triangle(20, 20, 900, 10, 800, 700, AMBER);
+
+        return draw_to_file(t_out);
+    }
+
+    bool circles(std::string const& t_out)
+    {
+        auto const w = get_global_width();
+        auto const h = get_global_height();
+        auto const radius = w / 10;
+
+        circle(w / 4, h / 3, radius, hw::color{120, 36, 90});
+        circle(2 * w / 4, h / 3, radius, hw::color{20, 136, 84});
+
+        Circle a{w / 4, 2 * h / 3, radius, hw::color{45, 89, 102}};
+
+        outline_circle(3 * w / 4, h / 3, radius, hw::color{232, 20, 60});
+
+        OutlineCircle b{2 * w / 4, 2 * h / 3, radius, hw::color{23, 96, 77}};
+        OutlineCircle c{3 * w / 4, 2 * h / 3, 1};
+
+        return draw_to_file(t_out);
+    }
+
+    bool big_circle(std::string const& t_out)
+    {
+        return draw_to_file(
+            t_out, WITH { circle(width() / 2, height() / 2, 300, AMBER); });
+    }
+
+    bool hidden(std::string const& t_out)
+    {
+        Rectangle r{300, 300, 100, 100, PURPLE};
+        Circle c{100, 100, 50, PINK};
+
+        r.hide();
+        c.hide();
+        c.show();
+
+        return draw_to_file(t_out);
+    }
+
+    bool background(std::string const& t_out)
+    {
+        set_background(GREEN);
+        rectangle(100, 100, 50, 50, get_background());
+
+        return draw_to_file(t_out);
+    }
+
+    bool images(std::string const& t_out)
+    {
+        set_background(WHITE);
+
+        OutlineRectangle rect{width() / 2, height() / 2, 100, 100, GREEN};
+        Image img{};
+
+        img.set_color_key(BLACK);
+        img.set_path(HW_MEDIA_DIR "Triangle.png");
+        img.follow(rect);
+
+        Image centered{HW_MEDIA_DIR "Line.png"};
+        Image placed{HW_MEDIA_DIR "Triangle.png", 10, 10, 200, 120};
+
+        return draw_to_file(t_out);
+    }
+
+    ///
+    /// @brief Same as @ref images but the files come from a pack made by
+    ///        hw_pack, so it has to match the same reference.
+    ///
+    bool packed_images(std::string const& t_out)
+    {
+        if(!hw::mount_asset_pack(HW_PACK_FILE)) {
+            return false;
+        }
+
+        return images(t_out) && hw::get_texture_stats().pack_loads > 0 &&
+               hw::get_texture_stats().decodes == 0;
+    }
+
+    bool sprites(std::string const& t_out)
+    {
+        SpriteBatch batch{HW_MEDIA_DIR "Triangle.png"};
+
+        // as is, tinted, turned and both, all in the same call
+        batch.add(hw::vec2{20, 20}, hw::vec2{240, 135});
+        batch.add(hw::vec2{340, 20}, hw::vec2{240, 135},
+                  hw::color{255, 80, 80});
+        batch.add(hw::vec2{20, 260}, hw::vec2{240, 135}, WHITE, 30.0f);
+        batch.add(hw::vec2{340, 260}, hw::vec2{240, 135},
+                  hw::color{80, 80, 255, 160}, -90.0f);
+
+        return draw_to_file(t_out);
+    }
+
+    ///
+    /// @brief Images drawn at a half and a quarter of their size. The first
+    ///        frame uploads the full image and starts making the smaller
+    ///        ones, the second waits for them and draws from them.
+    ///
+    bool minified(std::string const& t_out)
+    {
+        Image half{HW_MEDIA_DIR "Triangle.png", 10, 10, 600, 340};
+        Image quarter{HW_MEDIA_DIR "Triangle.png", 320, 360, 300, 160};
+
+        return draw_to_file(t_out, [](double) {}, 2) &&
+               hw::get_texture_stats().textures_resident > 1;
+    }
+
+    ///
+    /// @brief A sprite sheet of 8 frames after 7 frames of 1/60 s. The
+    ///        durations are half a step away from a frame change, so
+    ///        rounding can't move any of them to another frame.
+    ///
+    bool animation(std::string const& t_out)
+    {
+        double const step = 1.0 / 60.0;
+
+        Image slow{HW_MEDIA_DIR "Line.png", 10, 10, 300, 200};
+        slow.set_frame_grid(640, 540, 4, 8);
+        slow.animate(step * 2.5, false);
+
+        // several frames go by in every step
+        Image fast{HW_MEDIA_DIR "Line.png", 330, 10, 300, 200};
+        fast.set_frame_grid(640, 540, 4, 8);
+        fast.animate(step * 0.3);
+
+        // would be past the end, stays on the last frame
+        Image once{HW_MEDIA_DIR "Line.png", 10, 260, 300, 200};
+        once.set_frame_grid(640, 540, 4, 8);
+        once.animate(step * 0.5, false);
+
+        // no columns means no frames, the whole file is drawn
+        Image whole{HW_MEDIA_DIR "Line.png", 330, 260, 300, 200};
+        whole.set_frame_grid(640, 540, 0, 8);
+        whole.animate(step);
+
+        return draw_to_file(t_out, [](double) {}, 7) && slow.frame() == 2 &&
+               !slow.finished() && fast.frame() == 23 % 8 &&
+               once.frame() == 7 && once.finished() &&
+               whole.frame_count() == 0;
+    }
+
+    ///
+    /// @brief Pages of about 11MB each shown one at a time with a budget
+    ///        that only fits one. Going back to the first page has to
+    ///        decode it again after it was taken off the GPU.
+    ///
+    bool texture_budget(std::string const& t_out)
+    {
+        set_texture_budget(16);
+
+        // different color keys so every page is its own texture, drawn at
+        // full size so no smaller versions are made
+        Image first{HW_MEDIA_DIR "Line.png", -960, -300, 2560, 1080};
+        Image second{HW_MEDIA_DIR "Line.png", -960, -300, 2560, 1080};
+        Image third{HW_MEDIA_DIR "Line.png", -960, -300, 2560, 1080};
+        Image* const pages[] = {&first, &second, &third};
+
+        second.set_color_key(hw::color{1, 0, 0});
+        third.set_color_key(hw::color{2, 0, 0});
+
+        int const shown[] = {0, 1, 2, 0, 0, 0};
+        int frame = 0;
+
+        bool const drawn = draw_to_file(
+            t_out,
+            WITH {
+                for(int i = 0; i < 3; ++i) {
+                    if(i == shown[frame]) {
+                        pages[i]->show();
+                    }
+                    else {
+                        pages[i]->hide();
+                    }
+                }
+                ++frame;
+            },
+            6);
+
+        hw::texture_stats const stats = hw::get_texture_stats();
+
+        return drawn && stats.evictions > 0 && stats.decodes > 3 &&
+               stats.bytes_resident <= stats.budget;
+    }
+
+    bool atlas(std::string const& t_out)
+    {
+        std::vector<std::unique_ptr<Image>> images;
+
+        for(int i = 0; i < 400; ++i) {
+            char const* path = (i < 300) ? HW_MEDIA_DIR "Triangle.png"
+                                         : HW_MEDIA_DIR "Line.png";
+
+            images.emplace_back(
+                new Image{path, (i % 20) * 32, (i / 20) * 24, 30, 22});
+        }
+
+        return draw_to_file(t_out);
+    }
+
+    ///
+    /// @brief 64 images of one file, which has to be loaded only once.
+    ///
+    bool image_cache(std::string const& t_out)
+    {
+        std::vector<std::unique_ptr<Image>> images;
+
+        for(int i = 0; i < 64; ++i) {
+            images.emplace_back(new Image{HW_MEDIA_DIR "Triangle.png",
+                                          (i % 8) * 80, (i / 8) * 60, 60,
+                                          50});
+        }
+
+        return draw_to_file(t_out) && hw::get_texture_stats().misses == 1 &&
+               hw::get_texture_stats().hits == 63;
+    }
+
+    bool mandelbrot(std::string const& t_out)
+    {
+        Canvas canvas{0, 0, width(), height()};
+
+        double const scale = 3.0 / width();
+        double const left = -0.5 - canvas.width() / 2 * scale;
+        double const top = -canvas.height() / 2 * scale;
+
+        canvas.parallel_fill([&](int const x, int const y) {
+            double const cx = left + x * scale;
+            double const cy = top + y * scale;
+            double zx = 0.0;
+            double zy = 0.0;
+            int i = 0;
+
+            for(; i < 256 && zx * zx + zy * zy < 4.0; ++i) {
+                double const t = zx * zx - zy * zy + cx;
+                zy = 2.0 * zx * zy + cy;
+                zx = t;
+            }
+
+            if(i == 256) {
+                return hw::color{0, 0, 0};
+            }
+
+            return hw::color{static_cast<std::uint8_t>(i * 9),
+                             static_cast<std::uint8_t>(i * 4),
+                             static_cast<std::uint8_t>(128 + i * 2)};
+        });
+
+        return draw_to_file(t_out);
+    }
+
+    bool overlay(std::string const& t_out)
+    {
+        hw::color const glass{0, 128, 255, 128};
+
+        return draw_to_file(t_out, WITH {
+            set_blend_mode(hw::blend_mode::alpha);
+
+            for(int y = 0; y < height(); y += 40) {
+                rectangle(0, y, width(), 20, GREY);
+            }
+
+            circle(80, 240, 70, glass);
+
+            set_blend_mode(hw::blend_mode::premultiplied);
+            circle(240, 240, 70, glass.premultiplied());
+
+            set_blend_mode(hw::blend_mode::add);
+            circle(400, 240, 70, glass);
+
+            set_blend_mode(hw::blend_mode::none);
+            circle(560, 240, 70, glass);
+        });
+    }
+
+    bool degenerate(std::string const& t_out)
+    {
+        // all vertices in the same spot
+        triangle(100, 100, 100, 100, 100, 100, RED);
+        // collinear vertices, horizontal, vertical and diagonal
+        triangle(10, 50, 200, 50, 100, 50, GREEN);
+        triangle(50, 10, 50, 200, 50, 100, BLUE);
+        triangle(300, 300, 400, 400, 350, 350, YELLOW);
+        outline_triangle(500, 20, 500, 20, 600, 20, CYAN);
+
+        circle(200, 200, 0, ORANGE);
+        circle(210, 200, 1, ORANGE);
+        outline_circle(230, 200, 0, TEAL);
+        outline_circle(240, 200, 1, TEAL);
+
+        rectangle(400, 100, 0, 0, PINK);
+        rectangle(400, 120, 0, 30, PINK);
+        rectangle(450, 200, -40, -40, LIME);
+        outline_rectangle(500, 200, 0, 0, PURPLE);
+        outline_rectangle(550, 250, -30, 20, PURPLE);
+
+        line(600, 400, 600, 400, WHITE);
+        point(-1, -1, WHITE);
+
+        return draw_to_file(t_out);
+    }
+
+    bool huge(std::string const& t_out)
+    {
+        circle(width() / 2, height() / 2, 5000, hw::color{30, 30, 60});
+        outline_circle(width() / 2, height() / 2, 4000, WHITE);
+        triangle(-20000, -20000, 20000, -100, 300, 30000, INDIGO);
+        outline_triangle(-30000, 400, 30000, 420, 320, -30000, AMBER);
+        rectangle(-10000, 300, 20000, 50, BROWN);
+        outline_rectangle(-10, -10, width() + 20, height() + 20, RED);
+        line(-100000, -100000, 100000, 100000, GREEN);
+
+        return draw_to_file(t_out);
+    }
+
+    bool offscreen(std::string const& t_out)
+    {
+        auto const w = width();
+        auto const h = height();
+
+        // entirely outside of the window
+        triangle(-300, -300, -100, -250, -200, -50, RED);
+        circle(w + 200, h / 2, 100, RED);
+        rectangle(w / 2, h + 10, 100, 100, RED);
+        outline_circle(-200, -200, 50, RED);
+
+        // partially clipped by every edge of the window
+        circle(0, h / 2, 60, CYAN);
+        circle(w, h / 2, 60, CYAN);
+        outline_circle(w / 2, 0, 60, YELLOW);
+        outline_circle(w / 2, h, 60, YELLOW);
+        triangle(-50, 20, 80, 60, -20, 160, LIME);
+        triangle(w + 50, h - 20, w - 80, h - 60, w + 20, h - 160, LIME);
+        rectangle(-40, -40, 100, 100, PURPLE);
+        rectangle(w - 60, h - 60, 100, 100, PURPLE);
+        outline_rectangle(w - 60, -40, 100, 100, PINK);
+        outline_triangle(-40, h - 40, 60, h + 40, 60, h - 60, PINK);
+
+        return draw_to_file(t_out);
+    }
+
+    bool translucent(std::string const& t_out)
+    {
+        set_background(hw::color{40, 40, 40});
+
+        rectangle(50, 50, 300, 200, hw::color{255, 0, 0, 128});
+        rectangle(200, 150, 300, 200, hw::color{0, 255, 0, 128});
+        circle(300, 250, 120, hw::color{0, 0, 255, 64});
+        triangle(100, 400, 400, 60, 600, 450, hw::color{255, 255, 0, 32});
+        outline_circle(300, 250, 130, hw::color{255, 255, 255, 100});
+        line(0, 0, width(), height(), hw::color{255, 255, 255, 0});
+
+        return draw_to_file(t_out);
+    }
+
+    bool polygons(std::string const& t_out)
+    {
+        // concave, so it can not be drawn as a fan from any corner
+        Polygon arrow{{{100, 100},
+                       {300, 100},
+                       {300, 50},
+                       {400, 150},
+                       {300, 250},
+                       {300, 200},
+                       {100, 200}},
+                      GREEN};
+        OutlinePolygon border{arrow.points(), WHITE};
+
+        return draw_to_file(t_out, WITH {
+            polygon({{450, 300}, {600, 300}, {500, 350}, {600, 400},
+                     {450, 400}},
+                    hw::color{255, 0, 0, 128});
+            // crosses itself, must still draw something
+            polygon({{50, 300}, {250, 450}, {250, 300}, {50, 450}}, BLUE);
+        });
+    }
+
+    bool curves(std::string const& t_out)
+    {
+        Bezier wave{hw::vec2{20, 100}, hw::vec2{200, -50}, hw::vec2{300, 250},
+                    hw::vec2{600, 100}, GREEN};
+        Arc slice{320, 320, 100, -90.0f, 45.0f, AMBER};
+
+        slice.set_filled(true);
+
+        return draw_to_file(t_out, WITH {
+            bezier(hw::vec2{20, 200}, hw::vec2{320, 400}, hw::vec2{620, 200},
+                   WHITE);
+            filled_bezier(hw::vec2{20, 470}, hw::vec2{120, 370},
+                          hw::vec2{220, 470}, BLUE);
+            arc(320, 320, 120, 45.0f, 270.0f, RED);
+            // a full circle, and one too small to need more than a few lines
+            filled_arc(560, 400, 40, 0.0f, 360.0f, PURPLE);
+            arc(560, 400, 2, 0.0f, 360.0f, WHITE);
+        });
+    }
+
+    bool text_scene(std::string const& t_out)
+    {
+        Text title{20, 20, "Golden\nscene", AMBER};
+        Text hidden{20, 300, "not drawn", RED};
+
+        title.set_scale(4);
+        hidden.hide();
+
+        return draw_to_file(t_out, WITH {
+            text(20, 120, "The quick brown fox jumps over the lazy dog.",
+                 WHITE);
+            text(20, 140, "0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~",
+                 GREEN);
+            // not in the font, drawn as '?'
+            text(20, 160, "\t\x80", BLUE);
+
+            push_transform(hw::affine2::translation(hw::vec2f{400, 300}) *
+                           hw::affine2::rotation(30.0f));
+            text(0, 0, "rotated", PURPLE);
+            pop_transform();
+        });
+    }
+
+    bool particles(std::string const& t_out)
+    {
+        ParticleSystem sparks{400};
+        sparks.set_gravity(hw::vec2f{0.0f, 200.0f});
+        sparks.set_particle_size(3);
+
+        for(int i = 0; i < 400; ++i) {
+            sparks.emit(hw::vec2f{320.0f, 240.0f},
+                        hw::vec2f{static_cast<float>(i % 40 - 20) * 10.0f,
+                                  static_cast<float>(i / 40) * -30.0f},
+                        i % 2 == 0 ? AMBER : RED,
+                        0.2f + static_cast<float>(i % 8) * 0.1f);
+        }
+
+        {
+            // removes itself from the shapes when it goes away
+            Rectangle gone{0, 0, 640, 480, BLUE};
+        }
+
+        // half a second, some particles died
+        return draw_to_file(t_out, [](double) {}, 30);
+    }
+
+    bool tilemap(std::string const& t_out)
+    {
+        // 3 by 2 chunks, the last ones narrower
+        TileMap map{40, 20, 16, 16};
+        Group camera{hw::affine2::translation(hw::vec2f{-40.0f, 100.0f})};
+
+        map.set_palette({GREEN, BLUE, hw::color{255, 255, 255, 128}});
+
+        for(int row = 0; row < map.rows(); ++row) {
+            for(int column = 0; column < map.columns(); ++column) {
+                map.set_tile(column, row, (column + row) % 4 == 0 ? -1
+                                                                  : row % 3);
+            }
+        }
+
+        camera.add(map);
+
+        return draw_to_file(
+            t_out,
+            [&map](double) {
+                // changed after the first frame, only its chunk is redrawn
+                map.set_tile(20, 10, 1);
+            },
+            2);
+    }
+
+    bool collisions(std::string const& t_out)
+    {
+        // side by side, they only touch
+        Rectangle left{40, 40, 80, 80};
+        Rectangle right{120, 40, 80, 80};
+        // the circle reaches into the rectangle, the point is inside the
+        // triangle and the line crosses the outline
+        Circle ball{260, 80, 30};
+        OutlineRectangle box{280, 60, 80, 80};
+        Triangle ramp{40, 400, 240, 400, 40, 200};
+        Point dot{80, 350};
+        Line wire{300, 200, 600, 450};
+        OutlineCircle ring{450, 330, 40};
+        // near the ramp but not on it
+        Circle far{240, 250, 20};
+
+        Collisions collisions{};
+        Shape* shapes[] = {&left, &right, &ball, &box,  &ramp,
+                           &dot,  &wire,  &ring, &far};
+
+        collisions.add(left);
+        collisions.add(right);
+        collisions.add(ball);
+        collisions.add(box);
+        collisions.add(ramp);
+        collisions.add(dot);
+        collisions.add(wire);
+        collisions.add(ring);
+        collisions.add(far);
+
+        std::vector<Shape*> hit{};
+
+        for(auto const& p : collisions.update()) {
+            hit.push_back(p.first);
+            hit.push_back(p.second);
+        }
+
+        // green shapes collide with nothing
+        hw::color* colors[] = {&left.color(), &right.color(), &ball.color(),
+                               &box.color(),  &ramp.color(),  &dot.color(),
+                               &wire.color(), &ring.color(),  &far.color()};
+
+        for(std::size_t i = 0; i < 9; ++i) {
+            bool const collides =
+                std::find(hit.begin(), hit.end(), shapes[i]) != hit.end();
+            *colors[i] = collides ? RED : GREEN;
+        }
+
+        return draw_to_file(t_out);
+    }
+
+    bool gradients(std::string const& t_out)
+    {
+        // wider than the gradient, the ends stay one color
+        Rectangle band{0, 0, 640, 120};
+        band.fill() = hw::fill_style::linear(
+            hw::vec2f{160.0f, 0.0f}, RED, hw::vec2f{480.0f, 0.0f}, BLUE);
+
+        Circle glow{160, 300, 100};
+        glow.fill() = hw::fill_style::radial(
+            hw::vec2f{160.0f, 300.0f}, 100.0f, WHITE,
+            hw::color{255, 200, 0, 0});
+
+        Triangle checker{300, 160, 460, 460, 300, 460};
+        checker.fill() = hw::fill_style::function([](hw::vec2f const& t_pos) {
+            int const square = static_cast<int>(t_pos.x) / 40 +
+                               static_cast<int>(t_pos.y) / 40;
+
+            return square % 2 == 0 ? GREEN : PURPLE;
+        });
+
+        // the gradient turns with the polygon
+        Group turned{hw::affine2::translation(hw::vec2f{560.0f, 300.0f}) *
+                     hw::affine2::rotation(30.0f)};
+        Polygon star{std::vector<hw::vec2>{
+            hw::vec2{0, -60}, hw::vec2{15, -15}, hw::vec2{60, 0},
+            hw::vec2{15, 15}, hw::vec2{0, 60}, hw::vec2{-15, 15},
+            hw::vec2{-60, 0}, hw::vec2{-15, -15}}};
+        star.fill() = hw::fill_style::linear(
+            hw::vec2f{0.0f, -60.0f}, AMBER, hw::vec2f{0.0f, 60.0f}, RED);
+        turned.add(star);
+
+        Canvas canvas{480, 400, 120, 60};
+        canvas.fill(hw::fill_style::radial(hw::vec2f{60.0f, 30.0f}, 60.0f,
+                                           WHITE, BLUE));
+
+        return draw_to_file(t_out);
+    }
+
+    bool transformed(std::string const& t_out)
+    {
+        Group group{hw::affine2::translation(hw::vec2f{480, 120}) *
+                    hw::affine2::scale(hw::vec2f{0.5f, 0.5f})};
+        Rectangle kept{-100, -100, 200, 200, AMBER};
+        Image picture{HW_MEDIA_DIR "Triangle.png", 0, 0, 160, 120};
+
+        group.add(kept);
+        group.add(picture);
+
+        return draw_to_file(t_out, WITH {
+            push_transform(hw::affine2::translation(hw::vec2f{160, 240}) *
+                           hw::affine2::rotation(30.0f));
+            rectangle(-80, -50, 160, 100, RED);
+            outline_rectangle(-100, -70, 200, 140, GREEN);
+            circle(0, 0, 20, BLUE);
+
+            push_transform(hw::affine2::scale(hw::vec2f{-1.0f, 1.0f}));
+            triangle(0, 0, 60, 10, 20, 40, WHITE);
+            pop_transform();
+            pop_transform();
+
+            // left pushed on purpose, must not move the kept shapes
+            push_transform(hw::affine2::rotation(45.0f));
+        });
+    }
+
+    struct scene
+    {
+        char const* name;
+        bool (*run)(std::string const&);
+        ///
+        /// Scene whose reference image is used instead, if any.
+        ///
+        char const* reference;
+    };
+
+    scene const g_scenes[] = {
+        {"basic_example", basic_example},
+        {"points", points},
+        {"lines", lines},
+        {"rectangles", rectangles},
+        {"triangles", triangles},
+        {"big_triangles", big_triangles},
+        {"circles", circles},
+        {"big_circle", big_circle},
+        {"hidden", hidden},
+        {"background", background},
+        {"images", images},
+        {"packed_images", packed_images, "images"},
+        {"sprites", sprites},
+        {"minified", minified},
+        {"animation", animation},
+        {"texture_budget", texture_budget},
+        {"atlas", atlas},
+        {"image_cache", image_cache},
+        {"mandelbrot", mandelbrot},
+        {"overlay", overlay},
+        {"degenerate", degenerate},
+        {"huge", huge},
+        {"offscreen", offscreen},
+        {"translucent", translucent},
+        {"transformed", transformed},
+        {"polygons", polygons},
+        {"curves", curves},
+        {"text", text_scene},
+        {"particles", particles},
+        {"tilemap", tilemap},
+        {"collisions", collisions},
+        {"gradients", gradients},
+    };
+
+    ///
+    /// @brief Loads a PNG and converts it to ARGB8888 so it can be compared
+    ///        one Uint32 at a time.
+    ///
+    SDL_Surface* load_argb(std::string const& t_path)
+    {
+        SDL_Surface* loaded = IMG_Load(t_path.c_str());
+
+        if(!loaded) {
+            return nullptr;
+        }
+
+        SDL_Surface* converted =
+            SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(loaded);
+
+        return converted;
+    }
+
+    inline Uint32 pixel_at(SDL_Surface const* t_surface, int const t_x,
+                           int const t_y)
+    {
+        auto const* row = static_cast<Uint8 const*>(t_surface->pixels) +
+                          t_y * t_surface->pitch;
+        return reinterpret_cast<Uint32 const*>(row)[t_x];
+    }
+
+    inline int channel_distance(Uint32 const t_a, Uint32 const t_b)
+    {
+        int result = 0;
+
+        for(int shift = 0; shift < 32; shift += 8) {
+            int const a = static_cast<int>((t_a >> shift) & 0xFF);
+            int const b = static_cast<int>((t_b >> shift) & 0xFF);
+            int const d = a > b ? a - b : b - a;
+            result = d > result ? d : result;
+        }
+
+        return result;
+    }
+
+    ///
+    /// @brief Counts the pixels that differ by more than @ref t_tolerance on
+    ///        any channel and paints them red in @ref t_diff.
+    ///
+    long compare(SDL_Surface const* t_actual, SDL_Surface const* t_expected,
+                 SDL_Surface* t_diff, int const t_tolerance)
+    {
+        long differing = 0;
+
+        for(int y = 0; y < t_expected->h; ++y) {
+            auto* diff_row = reinterpret_cast<Uint32*>(
+                static_cast<Uint8*>(t_diff->pixels) + y * t_diff->pitch);
+
+            for(int x = 0; x < t_expected->w; ++x) {
+                Uint32 const expected = pixel_at(t_expected, x, y);
+                Uint32 const actual = pixel_at(t_actual, x, y);
+
+                if(channel_distance(expected, actual) > t_tolerance) {
+                    ++differing;
+                    diff_row[x] = 0xFFFF0000;
+                }
+                else {
+                    Uint32 const r = (expected >> 16) & 0xFF;
+                    Uint32 const g = (expected >> 8) & 0xFF;
+                    Uint32 const b = expected & 0xFF;
+                    Uint32 const grey = (r + g + b) / 3 / 4 + 192;
+                    diff_row[x] = 0xFF000000 | grey << 16 | grey << 8 | grey;
+                }
+            }
+        }
+
+        return differing;
+    }
+
+    int run_scene(scene const& t_scene, std::string const& t_reference_dir,
+                  std::string const& t_output_dir, int const t_tolerance,
+                  long const t_max_pixels)
+    {
+        std::string const name{t_scene.name};
+        std::string const reference =
+            t_reference_dir + "/" +
+            (t_scene.reference ? t_scene.reference : t_scene.name) + ".png";
+        std::string const actual_path = t_output_dir + "/" + name + ".png";
+        std::string const diff_path = t_output_dir + "/" + name + ".diff.png";
+
+        if(!t_scene.run(actual_path)) {
+            std::cerr << name << ": could not render the scene\n";
+            return EXIT_FAILURE;
+        }
+
+        bool const update = std::getenv("HW_GOLDEN_UPDATE") != nullptr;
+        SDL_Surface* actual = load_argb(actual_path);
+        SDL_Surface* expected = update ? nullptr : load_argb(reference);
+
+        if(!actual) {
+            std::cerr << name << ": could not read back " << actual_path
+                      << '\n';
+            SDL_FreeSurface(expected);
+            return EXIT_FAILURE;
+        }
+
+        if(!expected && !update) {
+            // passing would let a missing reference hide any regression
+            std::cerr << name << ": no reference " << reference
+                      << ", run with HW_GOLDEN_UPDATE set to write it\n";
+            SDL_FreeSurface(actual);
+            return EXIT_FAILURE;
+        }
+
+        if(update) {
+            bool const saved = IMG_SavePNG(actual, reference.c_str()) == 0;
+            SDL_FreeSurface(actual);
+
+            std::cout << name << ": "
+                      << (saved ? "wrote reference " : "could not write ")
+                      << reference << '\n';
+            return saved ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        int result = EXIT_SUCCESS;
+
+        if(actual->w != expected->w || actual->h != expected->h) {
+            std::cerr << name << ": expected " << expected->w << "x"
+                      << expected->h << " but got " << actual->w << "x"
+                      << actual->h << '\n';
+            result = EXIT_FAILURE;
+        }
+        else {
+            SDL_Surface* diff = SDL_CreateRGBSurfaceWithFormat(
+                0, expected->w, expected->h, 32, SDL_PIXELFORMAT_ARGB8888);
+            long const differing =
+                compare(actual, expected, diff, t_tolerance);
+
+            if(differing > t_max_pixels) {
+                std::cerr << name << ": " << differing
+                          << " pixels differ by more than " << t_tolerance
+                          << ", see " << diff_path << '\n';
+                IMG_SavePNG(diff, diff_path.c_str());
+                result = EXIT_FAILURE;
+            }
+            else {
+                std::cout << name << ": ok(" << differing
+                          << " pixels within tolerance)\n";
+            }
+
+            SDL_FreeSurface(diff);
+        }
+
+        SDL_FreeSurface(expected);
+        SDL_FreeSurface(actual);
+
+        return result;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if(argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for(auto const& s : g_scenes) {
+            std::cout << s.name << '\n';
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if(argc < 4) {
+        std::cerr << "usage: " << argv[0]
+                  << " <scene> <reference dir> <output dir> [tolerance]"
+                     " [max pixels]\n";
+        return EXIT_FAILURE;
+    }
+
+    int const tolerance = argc > 4 ? std::atoi(argv[4]) : 0;
+    long const max_pixels = argc > 5 ? std::atol(argv[5]) : 0;
+
+    for(auto const& s : g_scenes) {
+        if(std::strcmp(s.name, argv[1]) == 0) {
+            return run_scene(s, argv[2], argv[3], tolerance, max_pixels);
+        }
+    }
+
+    std::cerr << "unknown scene " << argv[1] << '\n';
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,47 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "graphics.hpp"
+
+// A sky fading from blue to orange behind a mountain, a sun with a glow that
+// follows the mouse and, in the corner, a canvas filled with rings computed
+// for every pixel. Shapes blend their colors on the GPU, the canvas fills a
+// row at a time on the CPU.
+int main()
+{
+    float const h = static_cast<float>(height());
+
+    Rectangle sky{0, 0, width(), height()};
+    sky.fill() = hw::fill_style::linear(
+        hw::vec2f{0.0f, 0.0f}, hw::color{20, 40, 120}, hw::vec2f{0.0f, h},
+        hw::color{250, 150, 60});
+
+    Circle sun{0, 0, 80};
+
+    Polygon mountain{std::vector<hw::vec2>{
+        hw::vec2{0, height()}, hw::vec2{width() / 3, height() / 2},
+        hw::vec2{width() / 2, height() * 2 / 3},
+        hw::vec2{width() * 3 / 4, height() * 2 / 5},
+        hw::vec2{width(), height()}}};
+    mountain.fill() = hw::fill_style::linear(
+        hw::vec2f{0.0f, h * 0.4f}, hw::color{90, 90, 100},
+        hw::vec2f{0.0f, h}, hw::color{20, 30, 20});
+
+    Canvas rings{10, 10, 128, 128};
+    rings.fill(hw::fill_style::function([](hw::vec2f const& t_pos) {
+        float const d = hw::length(t_pos - hw::vec2f{64.0f, 64.0f});
+        auto const v = static_cast<std::uint8_t>(
+            127.5f + 127.5f * std::sin(d * 0.3f));
+
+        return hw::color{v, v, 255};
+    }));
+
+    return draw(WITH {
+        sun.pos() = hw::vec2{mouse_x(), mouse_y()};
+        // see-through at the edge, so it glows over the sky
+        sun.fill() = hw::fill_style::radial(
+            hw::vec2f{sun.pos()}, 80.0f, hw::color{255, 255, 220},
+            hw::color{255, 160, 60, 0});
+    });
+}
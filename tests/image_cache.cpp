@@ -0,0 +1,21 @@
+#include <memory>
+#include <vector>
+
+#include "graphics.hpp"
+
+// 64 images showing the same file. The file is decoded and uploaded only
+// once, the numbers are printed when the window is closed.
+int main()
+{
+    preload("../media/Triangle.png");
+    wait_all();
+
+    std::vector<std::unique_ptr<Image>> images;
+
+    for(int i = 0; i < 64; ++i) {
+        images.emplace_back(new Image{"../media/Triangle.png", (i % 8) * 80,
+                                      (i / 8) * 60, 60, 50});
+    }
+
+    return draw();
+}
@@ -0,0 +1,27 @@
+#include "graphics.hpp"
+
+// Same as image_switch but with a single image whose file is changed. Both
+// files stay loaded so switching does not decode anything. Editing either
+// file while this runs shows the new version right away.
+int main()
+{
+    preload("../media/Triangle.png");
+    preload("../media/Line.png");
+    wait_all();
+
+    set_hot_reload(true);
+
+    OutlineRectangle rect{width() / 2 - 100, height() / 2 - 100, 200, 200,
+                          CYAN};
+    Image img{"../media/Triangle.png", rect};
+
+    char const* paths[] = {"../media/Triangle.png", "../media/Line.png"};
+    int current_image = 0;
+
+    return draw(WITH {
+        if(key(KEY_n)) {
+            current_image = (current_image + 1) % 2;
+            img.set_path(paths[current_image]);
+        }
+    });
+}
@@ -0,0 +1,28 @@
+#include <cmath>
+
+#include "graphics.hpp"
+
+// An image that keeps shrinking and growing. Below half of its real size it
+// is drawn from a smaller, pre-filtered copy of the file, so it does not
+// flicker as much while being tiny.
+int main()
+{
+    preload("../media/Triangle.png");
+    wait_all();
+
+    OutlineRectangle rect{0, 0, 400, 300, CYAN};
+    Image img{"../media/Triangle.png", rect};
+
+    double time = 0.0;
+
+    return draw(WITH {
+        time += elapsed_time;
+
+        double const scale = 0.55 + 0.45 * std::cos(time);
+        int const w = static_cast<int>(400 * scale) + 4;
+        int const h = static_cast<int>(300 * scale) + 3;
+
+        rect.dim() = hw::vec2{w, h};
+        rect.pos() = hw::vec2{width() / 2 - w / 2, height() / 2 - h / 2};
+    });
+}
@@ -0,0 +1,76 @@
+#include <cstdint>
+
+#include "graphics.hpp"
+
+// The Mandelbrot set computed pixel by pixel on every core. Arrow keys move
+// around, z and x zoom in and out. The picture is only computed and sent to
+// the GPU again in frames where the view changed.
+int main()
+{
+    Canvas canvas{0, 0, width(), height()};
+
+    double center_x = -0.5;
+    double center_y = 0.0;
+    double scale = 3.0 / width();
+    bool changed = true;
+
+    return draw(WITH {
+        double const step = elapsed_time * 300.0 * scale;
+
+        if(key_held(KEY_LEFT)) {
+            center_x -= step;
+            changed = true;
+        }
+        if(key_held(KEY_RIGHT)) {
+            center_x += step;
+            changed = true;
+        }
+        if(key_held(KEY_UP)) {
+            center_y -= step;
+            changed = true;
+        }
+        if(key_held(KEY_DOWN)) {
+            center_y += step;
+            changed = true;
+        }
+        if(key_held(KEY_z)) {
+            scale *= 1.0 - elapsed_time;
+            changed = true;
+        }
+        if(key_held(KEY_x)) {
+            scale *= 1.0 + elapsed_time;
+            changed = true;
+        }
+
+        if(!changed) {
+            return;
+        }
+
+        changed = false;
+
+        double const left = center_x - canvas.width() / 2 * scale;
+        double const top = center_y - canvas.height() / 2 * scale;
+
+        canvas.parallel_fill([&](int const x, int const y) {
+            double const cx = left + x * scale;
+            double const cy = top + y * scale;
+            double zx = 0.0;
+            double zy = 0.0;
+            int i = 0;
+
+            for(; i < 256 && zx * zx + zy * zy < 4.0; ++i) {
+                double const t = zx * zx - zy * zy + cx;
+                zy = 2.0 * zx * zy + cy;
+                zx = t;
+            }
+
+            if(i == 256) {
+                return hw::color{0, 0, 0};
+            }
+
+            return hw::color{static_cast<std::uint8_t>(i * 9),
+                             static_cast<std::uint8_t>(i * 4),
+                             static_cast<std::uint8_t>(128 + i * 2)};
+        });
+    });
+}
@@ -0,0 +1,27 @@
+#include "graphics.hpp"
+
+// Translucent circles over a striped background, drawn with each blend
+// mode from left to right: alpha, premultiplied, add and none.
+int main()
+{
+    hw::color const glass{0, 128, 255, 128};
+
+    return draw(WITH {
+        set_blend_mode(hw::blend_mode::alpha);
+
+        for(int y = 0; y < height(); y += 40) {
+            rectangle(0, y, width(), 20, GREY);
+        }
+
+        circle(80, 240, 70, glass);
+
+        set_blend_mode(hw::blend_mode::premultiplied);
+        circle(240, 240, 70, glass.premultiplied());
+
+        set_blend_mode(hw::blend_mode::add);
+        circle(400, 240, 70, glass);
+
+        set_blend_mode(hw::blend_mode::none);
+        circle(560, 240, 70, glass);
+    });
+}
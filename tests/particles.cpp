@@ -0,0 +1,25 @@
+#include <string>
+
+#include "graphics.hpp"
+
+// Fireworks wherever the mouse goes: 2000 new sparks every frame, which
+// is over 100000 alive at once, all moved and drawn by one shape.
+int main()
+{
+    ParticleSystem sparks{150000};
+    sparks.set_gravity(hw::vec2f{0.0f, 150.0f});
+
+    hw::color const colors[] = {AMBER, RED, YELLOW, PINK};
+    int frame{0};
+
+    return draw(WITH {
+        ++frame;
+
+        sparks.burst(2000,
+                     hw::vec2f{static_cast<float>(mouse_x()),
+                               static_cast<float>(mouse_y())},
+                     250.0f, colors[(frame / 30) % 4], 1.2f);
+
+        text(10, 10, std::to_string(sparks.count()) + " particles", WHITE);
+    });
+}
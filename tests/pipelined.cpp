@@ -0,0 +1,31 @@
+#include <cmath>
+
+#include "graphics.hpp"
+
+// Every frame does a lot of pointless math before drawing a few hundred
+// circles. With a frame of latency that work overlaps with the rasterization
+// and presentation of the previous frame.
+int main()
+{
+    set_frame_latency(1);
+
+    double t = 0.0;
+
+    return draw(WITH {
+        t += elapsed_time;
+
+        double acc = 0.0;
+        for(int i = 0; i < 2000000; ++i) {
+            acc += std::sin(i * 0.001 + t);
+        }
+
+        int const radius = 8 + static_cast<int>(std::fabs(acc)) % 5;
+
+        for(int i = 0; i < 300; ++i) {
+            int const x = static_cast<int>(width() / 2 + std::cos(t + i) * i);
+            int const y = static_cast<int>(height() / 2 + std::sin(t + i) * i);
+
+            circle(x, y, radius, i % 2 ? CYAN : AMBER);
+        }
+    });
+}
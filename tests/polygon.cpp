@@ -0,0 +1,32 @@
+#include <cmath>
+#include <vector>
+
+#include "graphics.hpp"
+
+// A star with 200 points filled as one polygon. Its triangles are computed
+// once, only the small one following the mouse is split again every frame.
+int main()
+{
+    std::vector<hw::vec2> corners;
+
+    for(int i = 0; i < 200; ++i) {
+        double const angle = i * 3.14159265 / 100.0;
+        double const radius = i % 2 == 0 ? 200.0 : 120.0;
+
+        corners.push_back(
+            hw::vec2{320 + static_cast<int>(radius * std::cos(angle)),
+                     240 + static_cast<int>(radius * std::sin(angle))});
+    }
+
+    Polygon star{corners, AMBER};
+    OutlinePolygon outline{corners, WHITE};
+
+    return draw(WITH {
+        int const x = mouse_x();
+        int const y = mouse_y();
+
+        polygon({{x, y - 30}, {x + 10, y - 10}, {x + 30, y}, {x, y + 30},
+                 {x - 30, y}},
+                RED);
+    });
+}
@@ -7,16 +7,16 @@ struct rect
 
 void update(float const)
 {
-    if(key(KEY_UP)) {
+    if(key_held(KEY_UP)) {
         g_rect.y -= 10;
     }
-    if(key(KEY_DOWN)) {
+    if(key_held(KEY_DOWN)) {
         g_rect.y += 10;
     }
-    if(key(KEY_LEFT)) {
+    if(key_held(KEY_LEFT)) {
         g_rect.x -= 10;
     }
-    if(key(KEY_RIGHT)) {
+    if(key_held(KEY_RIGHT)) {
         g_rect.x += 10;
     }
 
@@ -0,0 +1,28 @@
+#include <cmath>
+
+#include "graphics.hpp"
+
+// 5000 spinning, tinted copies of one picture drawn with a single call.
+int main()
+{
+    SpriteBatch batch{"../media/Triangle.png"};
+    batch.reserve(5000);
+
+    double t = 0.0;
+
+    return draw(WITH {
+        t += elapsed_time;
+
+        batch.clear();
+
+        for(int i = 0; i < 5000; ++i) {
+            int const x = (i * 37) % width();
+            int const y = (i * 91) % height();
+            auto const shade = static_cast<std::uint8_t>(i % 256);
+
+            batch.add(hw::vec2{x, y}, hw::vec2{24, 16},
+                      hw::color{255, shade, 255},
+                      static_cast<float>(t * 90.0 + i));
+        }
+    });
+}
@@ -0,0 +1,28 @@
+#include <string>
+
+#include "graphics.hpp"
+
+// A title laid out once and a frame counter written every frame. Each of
+// them is drawn with a single call however long it is.
+int main()
+{
+    Text title{20, 20, "HomeWork\nbitmap text", AMBER};
+    title.set_scale(3);
+
+    int frames{0};
+
+    return draw(WITH {
+        ++frames;
+
+        text(20, 120, "frames: " + std::to_string(frames), WHITE);
+        text(mouse_x() + 8, mouse_y(),
+             std::to_string(mouse_x()) + ", " + std::to_string(mouse_y()),
+             GREEN);
+
+        if(elapsed_time > 0.0) {
+            text(20, 140,
+                 "fps: " + std::to_string(static_cast<int>(1.0 / elapsed_time)),
+                 WHITE);
+        }
+    });
+}
@@ -0,0 +1,54 @@
+#include <string>
+
+#include "graphics.hpp"
+
+// A 4096x4096 pixel map of 65536 tiles, scrolled with the arrow keys and
+// painted with the mouse. Only the few chunks on the screen are drawn, and
+// only the one that was painted is drawn into again.
+int main()
+{
+    TileMap map{256, 256, 16, 16};
+    map.set_palette({hw::color{20, 30, 20}, hw::color{40, 90, 40}, BLUE,
+                     AMBER});
+
+    for(int row = 0; row < map.rows(); ++row) {
+        for(int column = 0; column < map.columns(); ++column) {
+            map.set_tile(column, row, (column / 8 + row / 8) % 2);
+        }
+    }
+
+    Group camera{};
+    camera.add(map);
+
+    hw::vec2f scroll{0.0f, 0.0f};
+
+    return draw(WITH {
+        float const step = static_cast<float>(elapsed_time * 600.0);
+
+        if(key_held(KEY_UP)) {
+            scroll.y -= step;
+        }
+        if(key_held(KEY_DOWN)) {
+            scroll.y += step;
+        }
+        if(key_held(KEY_LEFT)) {
+            scroll.x -= step;
+        }
+        if(key_held(KEY_RIGHT)) {
+            scroll.x += step;
+        }
+
+        camera.transform() = hw::affine2::translation(-scroll);
+
+        if(mouse_held()) {
+            hw::vec2 const cell = map.cell_at(
+                hw::vec2{mouse_x(), mouse_y()} + hw::vec2{scroll});
+            map.set_tile(cell.x, cell.y, 2);
+        }
+
+        text(10, 10,
+             std::to_string(static_cast<int>(scroll.x)) + ", " +
+                 std::to_string(static_cast<int>(scroll.y)),
+             WHITE);
+    });
+}
@@ -0,0 +1,51 @@
+#include "graphics.hpp"
+
+// A small solar system. The sun and the ship are in a Group so the arrow
+// keys pan all of them with one change, and the planets spin around the
+// sun with push_transform.
+int main()
+{
+    Group camera{};
+    Circle sun{0, 0, 40, AMBER};
+    Image ship{"../media/Triangle.png", 180, -16, 32, 32};
+
+    camera.add(sun);
+    camera.add(ship);
+
+    float angle = 0.0f;
+    hw::vec2f offset{static_cast<float>(width() / 2),
+                     static_cast<float>(height() / 2)};
+
+    return draw(WITH {
+        float const step = 200.0f * static_cast<float>(elapsed_time);
+
+        if(key(KEY_LEFT)) {
+            offset.x += step;
+        }
+        if(key(KEY_RIGHT)) {
+            offset.x -= step;
+        }
+        if(key(KEY_UP)) {
+            offset.y += step;
+        }
+        if(key(KEY_DOWN)) {
+            offset.y -= step;
+        }
+
+        angle += 45.0f * static_cast<float>(elapsed_time);
+        camera.transform() = hw::affine2::translation(offset);
+
+        push_transform(camera.transform() * hw::affine2::rotation(angle));
+
+        for(int i = 0; i < 4; ++i) {
+            push_transform(hw::affine2::rotation(90.0f * i) *
+                           hw::affine2::translation(hw::vec2f{120, 0}) *
+                           hw::affine2::rotation(angle * 2.0f));
+            rectangle(-15, -15, 30, 30, RED);
+            outline_rectangle(-20, -20, 40, 40, WHITE);
+            pop_transform();
+        }
+
+        pop_transform();
+    });
+}
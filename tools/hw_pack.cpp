@@ -0,0 +1,182 @@
+///
+/// @file hw_pack.cpp
+/// Packs images into an asset pack(see asset_pack.hpp) so programs can load
+/// them without decoding anything:
+///
+///     hw_pack <output> [-k r g b] <image>...
+///
+/// Every image is stored under the path it was given as, so pass the paths
+/// the program uses. -k sets the color key of the images after it, the
+/// default is black, same as for Image.
+///
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_image.h"
+
+#include "asset_pack.hpp"
+
+namespace {
+    struct packed_image
+    {
+        std::string name;
+        hw::color color_key;
+        SDL_Surface* pixels;
+    };
+
+    std::uint64_t align(std::uint64_t const t_offset)
+    {
+        return (t_offset + hw::pack_alignment - 1) / hw::pack_alignment *
+               hw::pack_alignment;
+    }
+
+    ///
+    /// @brief Same steps the library takes when decoding an image.
+    ///
+    SDL_Surface* load(std::string const& t_path, hw::color const& t_color_key)
+    {
+        SDL_Surface* img = IMG_Load(t_path.c_str());
+
+        if(!img) {
+            return nullptr;
+        }
+
+        SDL_SetColorKey(img, SDL_TRUE,
+                        SDL_MapRGB(img->format, t_color_key.r, t_color_key.g,
+                                   t_color_key.b));
+
+        SDL_Surface* converted =
+            SDL_ConvertSurfaceFormat(img, SDL_PIXELFORMAT_ARGB8888, 0);
+
+        SDL_FreeSurface(img);
+
+        return converted;
+    }
+
+    bool write_pack(std::string const& t_path,
+                    std::vector<packed_image> const& t_images)
+    {
+        std::string names;
+        std::vector<hw::pack_entry> entries(t_images.size());
+
+        for(std::size_t i = 0; i < t_images.size(); ++i) {
+            auto const& img = t_images[i];
+            auto& e = entries[i];
+
+            std::memset(&e, 0, sizeof(e));
+            e.name_offset = static_cast<std::uint32_t>(names.size());
+            e.name_length = static_cast<std::uint32_t>(img.name.size());
+            e.width = static_cast<std::uint32_t>(img.pixels->w);
+            e.height = static_cast<std::uint32_t>(img.pixels->h);
+            e.pitch = static_cast<std::uint32_t>(img.pixels->pitch);
+            e.format = SDL_PIXELFORMAT_ARGB8888;
+            e.key_r = img.color_key.r;
+            e.key_g = img.color_key.g;
+            e.key_b = img.color_key.b;
+
+            names += img.name;
+        }
+
+        std::uint64_t offset = align(sizeof(hw::pack_header) +
+                                     entries.size() * sizeof(hw::pack_entry) +
+                                     names.size());
+
+        for(std::size_t i = 0; i < entries.size(); ++i) {
+            entries[i].data_offset = offset;
+            offset = align(offset + static_cast<std::uint64_t>(
+                                        entries[i].pitch) *
+                                        entries[i].height);
+        }
+
+        hw::pack_header header;
+        std::memcpy(header.magic, hw::pack_magic, sizeof(header.magic));
+        header.version = hw::pack_version;
+        header.count = static_cast<std::uint32_t>(entries.size());
+        header.names_size = static_cast<std::uint32_t>(names.size());
+
+        std::ofstream out{t_path, std::ios::binary};
+
+        out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        out.write(reinterpret_cast<char const*>(entries.data()),
+                  static_cast<std::streamsize>(entries.size() *
+                                               sizeof(hw::pack_entry)));
+        out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+        for(std::size_t i = 0; i < entries.size(); ++i) {
+            std::uint64_t const bytes =
+                static_cast<std::uint64_t>(entries[i].pitch) *
+                entries[i].height;
+
+            // zero padding up to where the pixels start
+            while(static_cast<std::uint64_t>(out.tellp()) <
+                  entries[i].data_offset) {
+                out.put('\0');
+            }
+
+            out.write(static_cast<char const*>(t_images[i].pixels->pixels),
+                      static_cast<std::streamsize>(bytes));
+        }
+
+        return static_cast<bool>(out);
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if(argc < 3) {
+        std::cerr << "usage: " << argv[0]
+                  << " <output> [-k r g b] <image>...\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<packed_image> images;
+    hw::color color_key{0, 0, 0};
+    bool ok = true;
+
+    for(int i = 2; i < argc; ++i) {
+        if(std::strcmp(argv[i], "-k") == 0 && i + 3 < argc) {
+            color_key = hw::color{
+                static_cast<std::uint8_t>(std::atoi(argv[i + 1])),
+                static_cast<std::uint8_t>(std::atoi(argv[i + 2])),
+                static_cast<std::uint8_t>(std::atoi(argv[i + 3]))};
+            i += 3;
+            continue;
+        }
+
+        SDL_Surface* pixels = load(argv[i], color_key);
+
+        if(!pixels) {
+            std::cerr << "Could not load " << argv[i] << ": "
+                      << SDL_GetError() << '\n';
+            ok = false;
+            break;
+        }
+
+        images.push_back(packed_image{argv[i], color_key, pixels});
+    }
+
+    if(ok) {
+        ok = write_pack(argv[1], images);
+
+        if(ok) {
+            std::cout << "Packed " << images.size() << " images into "
+                      << argv[1] << '\n';
+        }
+        else {
+            std::cerr << "Could not write " << argv[1] << '\n';
+        }
+    }
+
+    for(auto& img : images) {
+        SDL_FreeSurface(img.pixels);
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}